@@ -0,0 +1,51 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Replaces the global operator new of borealis_bench to count heap allocations.
+// Only linked into borealis_bench, the demo keeps the default allocator.
+
+#include <cstdlib>
+#include <new>
+
+#include "alloc_counter.hpp"
+
+// Per thread, so that the images decoded by the worker threads are not counted
+static thread_local size_t allocationCount = 0;
+
+size_t benchAllocationCount()
+{
+    return allocationCount;
+}
+
+void* operator new(std::size_t size)
+{
+    allocationCount++;
+
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
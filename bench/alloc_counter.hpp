@@ -0,0 +1,26 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+// Heap allocations made so far by the calling thread, counted by the global
+// operator new of borealis_bench (see alloc_counter.cpp).
+//
+// The demo sources are also built into borealis_bench, with BENCH_ALLOCATION_COUNTER
+// defined: they only include this header when it is.
+size_t benchAllocationCount();
@@ -0,0 +1,505 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Frame time benchmark of the demo, built with -DUSE_HEADLESS=ON.
+//
+// Every scenario shows one of the demo tabs and drives it with a fixed sequence
+// of button presses, one frame of the main loop at a time. The time spent in
+// each phase of the frames (see brls::FrameTimings) and the number of heap
+// allocations made by the main thread are then written to a JSON file:
+//   borealis_bench [output.json]
+//
+// Frames are only counted, not rasterized, unless BOREALIS_HEADLESS_RASTERIZE=1 is set.
+// Animations still follow the clock, so the drawn frames can differ slightly from run to run.
+
+#include <algorithm>
+#include <borealis.hpp>
+#include <borealis/platforms/headless/headless_platform.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "activity/main_activity.hpp"
+#include "alloc_counter.hpp"
+#include "tab/components_tab.hpp"
+#include "tab/recycling_list_tab.hpp"
+#include "tab/settings_tab.hpp"
+#include "tab/text_test_tab.hpp"
+#include "tab/transform_tab.hpp"
+#include "view/captioned_image.hpp"
+#include "view/pokemon_view.hpp"
+
+using namespace brls::literals;
+
+// Frames run before measuring a scenario, so that the images
+// are loaded and the transitions are over
+static const size_t WARMUP_FRAMES = 60;
+
+// Rows of the list scrolled by the recycling_list_tab scenario
+static const int RECYCLER_ROWS = 10000;
+
+// Rows scrolled by RecyclingListTab::runBenchmark(), outside of the main loop
+static const int RECYCLER_BENCHMARK_ROWS = 2000;
+
+// Lines of the h_recycler scenario, of H_RECYCLER_COLUMNS rows each
+static const int H_RECYCLER_LINES   = 1000;
+static const int H_RECYCLER_COLUMNS = 3;
+static const float H_RECYCLER_WIDTH = 200;
+
+struct FrameSample
+{
+    brls::FrameTimings timings;
+    brls::Time total;
+    size_t allocations;
+};
+
+struct Scenario
+{
+    std::string name;
+    std::vector<FrameSample> samples;
+
+    // Measures of the scenario that are not frames, written as they are
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+static brls::HeadlessInputManager* inputManager = nullptr;
+
+/**
+ * Runs frames of the main loop, recording them in the scenario if there is one.
+ * Returns false if the application quit.
+ */
+static bool runFrames(size_t frames, Scenario* scenario = nullptr)
+{
+    for (size_t i = 0; i < frames; i++)
+    {
+        size_t allocations = benchAllocationCount();
+        brls::Time start   = brls::getCPUTimeUsec();
+
+        if (!brls::Application::mainLoop())
+            return false;
+
+        brls::Time total = brls::getCPUTimeUsec() - start;
+        allocations      = benchAllocationCount() - allocations;
+
+        if (scenario)
+            scenario->samples.push_back({ brls::Application::getFrameTimings(), total, allocations });
+    }
+
+    return true;
+}
+
+/**
+ * Holds the button down for one frame, then runs the remaining frames released.
+ */
+static bool press(brls::ControllerButton button, Scenario* scenario, size_t frames = 2)
+{
+    inputManager->setButton(button, true);
+    bool running = runFrames(1, scenario);
+    inputManager->setButton(button, false);
+
+    return running && runFrames(frames - 1, scenario);
+}
+
+/**
+ * Holds the button down for the given frames, then runs one frame released.
+ */
+static bool hold(brls::ControllerButton button, size_t frames, Scenario* scenario)
+{
+    inputManager->setButton(button, true);
+    bool running = runFrames(frames, scenario);
+    inputManager->setButton(button, false);
+
+    return running && runFrames(1, scenario);
+}
+
+static bool pressRepeatedly(brls::ControllerButton button, size_t count, Scenario* scenario, size_t frames = 2)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!press(button, scenario, frames))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Shows the view in its own activity while the script runs.
+ */
+static bool runOnActivity(brls::View* view, Scenario* scenario, std::function<bool(Scenario*)> script, bool spatialNavigation = false)
+{
+    brls::Activity* activity = new brls::Activity(view);
+    activity->setSpatialNavigationEnabled(spatialNavigation);
+    brls::Application::pushActivity(activity, brls::TransitionAnimation::NONE);
+
+    bool running = runFrames(WARMUP_FRAMES) && script(scenario);
+
+    brls::Application::popActivity(brls::TransitionAnimation::NONE);
+
+    return running && runFrames(WARMUP_FRAMES);
+}
+
+static bool runComponentsTab(Scenario* scenario)
+{
+    return runOnActivity(ComponentsTab::create(), scenario, [](Scenario* scenario)
+        {
+            for (int round = 0; round < 3; round++)
+            {
+                if (!pressRepeatedly(brls::BUTTON_DOWN, 20, scenario, 4) || !pressRepeatedly(brls::BUTTON_UP, 20, scenario, 4))
+                    return false;
+            }
+            return true; });
+}
+
+static bool runSpatialNavigation(Scenario* scenario)
+{
+    // Down the selectors of the components tab, then held down to scroll to its grid
+    // of buttons (the scrolling frame uses the natural scrolling) and around it,
+    // moving between rows and columns on screen positions (see brls::FocusGraph)
+    return runOnActivity(
+        ComponentsTab::create(), scenario, [](Scenario* scenario)
+        {
+            for (int round = 0; round < 10; round++)
+            {
+                if (!pressRepeatedly(brls::BUTTON_DOWN, 4, scenario, 4) || !hold(brls::BUTTON_DOWN, 20, scenario)
+                    || !press(brls::BUTTON_RIGHT, scenario, 4) || !press(brls::BUTTON_DOWN, scenario, 4) || !press(brls::BUTTON_RIGHT, scenario, 4)
+                    || !pressRepeatedly(brls::BUTTON_LEFT, 2, scenario, 4) || !pressRepeatedly(brls::BUTTON_UP, 4, scenario, 4) || !hold(brls::BUTTON_UP, 20, scenario))
+                    return false;
+            }
+            return true; },
+        true);
+}
+
+static bool runRecyclingListTab(Scenario* scenario)
+{
+    RecyclingListTab* tab = (RecyclingListTab*)RecyclingListTab::create();
+
+    return runOnActivity(tab, scenario, [tab](Scenario* scenario)
+        {
+            // The cells only exist once the list is laid out
+            tab->setBenchmarkDataSource(RECYCLER_ROWS);
+            if (!runFrames(WARMUP_FRAMES))
+                return false;
+            brls::Application::giveFocus(tab);
+
+            // One row per press, down to the last row
+            if (!pressRepeatedly(brls::BUTTON_DOWN, RECYCLER_ROWS - 1, scenario))
+                return false;
+
+            // Then the recycler alone, without the rest of the frames: the second pass
+            // over the rows should reuse everything allocated by the first one
+            RecyclerBenchmarkResult result = tab->runBenchmark(RECYCLER_BENCHMARK_ROWS);
+            scenario->metrics.emplace_back("recycler_rows", result.rows);
+            scenario->metrics.emplace_back("recycler_first_pass_allocations", result.firstPassAllocations);
+            scenario->metrics.emplace_back("recycler_second_pass_allocations", result.secondPassAllocations);
+            scenario->metrics.emplace_back("recycler_second_pass_allocations_per_row", (double)result.secondPassAllocations / result.rows);
+
+            return runFrames(WARMUP_FRAMES); });
+}
+
+// Fixed width cells for brls::HRecyclerFrame
+class HorizontalDataSource : public brls::RecyclerDataSource
+{
+  public:
+    int numberOfRows(brls::RecyclerFrame* /*recycler*/, int /*section*/) override
+    {
+        return H_RECYCLER_LINES * H_RECYCLER_COLUMNS;
+    }
+
+    brls::RecyclerCell* cellForRow(brls::RecyclerFrame* recycler, brls::IndexPath /*index*/) override
+    {
+        brls::RecyclerCell* cell = recycler->dequeueReusableCell("Cell");
+        cell->setWidth(H_RECYCLER_WIDTH);
+        return cell;
+    }
+
+    float heightForRow(brls::RecyclerFrame* /*recycler*/, brls::IndexPath /*index*/) override
+    {
+        return H_RECYCLER_WIDTH;
+    }
+};
+
+static bool runHRecycler(Scenario* scenario)
+{
+    brls::HRecyclerFrame* recycler = (brls::HRecyclerFrame*)brls::HRecyclerFrame::create();
+    recycler->setColumns(H_RECYCLER_COLUMNS);
+    recycler->registerCell("Cell", []
+        {
+            brls::RecyclerCell* cell = brls::RecyclerCell::create();
+            cell->setFocusable(true);
+            return cell; });
+    recycler->setDataSource(new HorizontalDataSource());
+
+    return runOnActivity(recycler, scenario, [recycler](Scenario* scenario)
+        {
+            brls::Application::giveFocus(recycler);
+
+            // One line per press, down the rows of every 100th line. The frames run faster
+            // than the scrolling animation, so the scrolling jumps to the focused line
+            for (int line = 0; line < H_RECYCLER_LINES - 1; line++)
+            {
+                if (line % 100 == 0 && (!pressRepeatedly(brls::BUTTON_DOWN, H_RECYCLER_COLUMNS - 1, scenario) || !pressRepeatedly(brls::BUTTON_UP, H_RECYCLER_COLUMNS - 1, scenario)))
+                    return false;
+
+                if (!press(brls::BUTTON_RIGHT, scenario, 1))
+                    return false;
+
+                brls::RecyclerCell* cell = dynamic_cast<brls::RecyclerCell*>(brls::Application::getCurrentFocus());
+                if (!cell || cell->getIndexPath().row != (line + 1) * H_RECYCLER_COLUMNS)
+                {
+                    brls::Logger::error("bench: h_recycler did not move to line {}", line + 1);
+                    return false;
+                }
+
+                recycler->selectRowAt(cell->getIndexPath(), false);
+                if (!runFrames(1, scenario))
+                    return false;
+            }
+
+            return true; });
+}
+
+static bool runTextTestTab(Scenario* scenario)
+{
+    return runOnActivity(TextTestTab::create(), scenario, [](Scenario* scenario)
+        {
+            for (int round = 0; round < 3; round++)
+            {
+                if (!pressRepeatedly(brls::BUTTON_DOWN, 30, scenario, 4) || !pressRepeatedly(brls::BUTTON_UP, 30, scenario, 4))
+                    return false;
+            }
+            return true; });
+}
+
+static bool runTransformTab(Scenario* scenario)
+{
+    // Move every slider back and forth
+    return runOnActivity(TransformTab::create(), scenario, [](Scenario* scenario)
+        {
+            for (int slider = 0; slider < 8; slider++)
+            {
+                if (!pressRepeatedly(brls::BUTTON_RIGHT, 10, scenario, 4) || !pressRepeatedly(brls::BUTTON_LEFT, 10, scenario, 4) || !press(brls::BUTTON_DOWN, scenario, 4))
+                    return false;
+            }
+            return true; });
+}
+
+static bool runTabSwitching(Scenario* scenario)
+{
+    // The sidebar of the main activity has the focus: every press shows another tab
+    for (int round = 0; round < 5; round++)
+    {
+        if (!pressRepeatedly(brls::BUTTON_DOWN, 9, scenario, 8) || !pressRepeatedly(brls::BUTTON_UP, 9, scenario, 8))
+            return false;
+    }
+
+    return true;
+}
+
+static bool runDialog(Scenario* scenario)
+{
+    for (int round = 0; round < 20; round++)
+    {
+        brls::Dialog* dialog = new brls::Dialog("borealis_bench");
+        dialog->addButton("hints/ok"_i18n, [] {});
+        dialog->open();
+
+        if (!runFrames(30, scenario) || !press(brls::BUTTON_B, scenario, 30))
+            return false;
+    }
+
+    return true;
+}
+
+static brls::Time percentile(std::vector<brls::Time> values, double p)
+{
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+    size_t rank = (size_t)(p / 100.0 * values.size() + 0.5);
+    return values[std::min(std::max<size_t>(rank, 1), values.size()) - 1];
+}
+
+static void writeDistribution(FILE* file, const char* name, const std::vector<brls::Time>& values, bool last = false)
+{
+    brls::Time max = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+    fprintf(file, "        \"%s\": { \"p50\": %lld, \"p95\": %lld, \"p99\": %lld, \"max\": %lld }%s\n", name,
+        (long long)percentile(values, 50), (long long)percentile(values, 95), (long long)percentile(values, 99), (long long)max,
+        last ? "" : ",");
+}
+
+static bool writeReport(const std::string& path, const std::vector<Scenario>& scenarios)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"platform\": \"%s\",\n", brls::Application::getPlatform()->getName().c_str());
+    fprintf(file, "  \"rasterize\": %s,\n", brls::HeadlessPlatform::RASTERIZE ? "true" : "false");
+    fprintf(file, "  \"unit\": \"usec\",\n");
+    fprintf(file, "  \"scenarios\": [\n");
+
+    for (size_t i = 0; i < scenarios.size(); i++)
+    {
+        const Scenario& scenario = scenarios[i];
+
+        std::vector<brls::Time> platform, input, animation, uploads, layout, draw, present, total, allocations;
+        size_t allocationsTotal = 0, framesWithAllocations = 0;
+        for (const FrameSample& sample : scenario.samples)
+        {
+            platform.push_back(sample.timings.platform);
+            input.push_back(sample.timings.input);
+            animation.push_back(sample.timings.animation);
+            uploads.push_back(sample.timings.uploads);
+            layout.push_back(sample.timings.layout);
+            draw.push_back(sample.timings.draw);
+            present.push_back(sample.timings.present);
+            total.push_back(sample.total);
+            allocations.push_back(sample.allocations);
+
+            allocationsTotal += sample.allocations;
+            if (sample.allocations > 0)
+                framesWithAllocations++;
+        }
+
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s\",\n", scenario.name.c_str());
+        fprintf(file, "      \"frames\": %zu,\n", scenario.samples.size());
+        fprintf(file, "      \"phases\": {\n");
+        writeDistribution(file, "platform", platform);
+        writeDistribution(file, "input", input);
+        writeDistribution(file, "animation", animation);
+        writeDistribution(file, "uploads", uploads);
+        writeDistribution(file, "layout", layout);
+        writeDistribution(file, "draw", draw);
+        writeDistribution(file, "present", present);
+        writeDistribution(file, "frame", total, true);
+        fprintf(file, "      },\n");
+        fprintf(file, "      \"allocations\": {\n");
+        fprintf(file, "        \"total\": %zu,\n", allocationsTotal);
+        fprintf(file, "        \"frames_with_allocations\": %zu,\n", framesWithAllocations);
+        writeDistribution(file, "per_frame", allocations, true);
+        fprintf(file, "      }%s\n", scenario.metrics.empty() ? "" : ",");
+
+        if (!scenario.metrics.empty())
+        {
+            fprintf(file, "      \"metrics\": {\n");
+            for (size_t j = 0; j < scenario.metrics.size(); j++)
+            {
+                fprintf(file, "        \"%s\": %.10g%s\n", scenario.metrics[j].first.c_str(), scenario.metrics[j].second,
+                    j + 1 < scenario.metrics.size() ? "," : "");
+                brls::Logger::info("bench: {}: {} = {}", scenario.name, scenario.metrics[j].first, scenario.metrics[j].second);
+            }
+            fprintf(file, "      }\n");
+        }
+        fprintf(file, "    }%s\n", i + 1 < scenarios.size() ? "," : "");
+
+        brls::Logger::info("bench: {}: {} frames, frame p50 {} p99 {} usec, {} allocations",
+            scenario.name, scenario.samples.size(), percentile(total, 50), percentile(total, 99), allocationsTotal);
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+    fclose(file);
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string output = argc > 1 ? argv[1] : "borealis_bench.json";
+
+    // The benchmark drives the main loop itself, the environment can still override these
+    brls::HeadlessPlatform::FRAMES    = 0;
+    brls::HeadlessPlatform::RASTERIZE = false;
+
+    if (!brls::Application::init())
+    {
+        brls::Logger::error("Unable to init Borealis application");
+        return EXIT_FAILURE;
+    }
+
+    brls::Application::createWindow("borealis_bench");
+    brls::Application::getPlatform()->setThemeVariant(brls::ThemeVariant::DARK);
+    brls::Application::setGlobalQuit(false);
+
+    inputManager = (brls::HeadlessInputManager*)brls::Application::getPlatform()->getInputManager();
+
+    brls::Application::registerXMLView("CaptionedImage", CaptionedImage::create);
+    brls::Application::registerXMLView("RecyclingListTab", RecyclingListTab::create);
+    brls::Application::registerXMLView("ComponentsTab", ComponentsTab::create);
+    brls::Application::registerXMLView("TransformTab", TransformTab::create);
+    brls::Application::registerXMLView("TransformBox", TransformBox::create);
+    brls::Application::registerXMLView("PokemonView", PokemonView::create);
+    brls::Application::registerXMLView("SettingsTab", SettingsTab::create);
+    brls::Application::registerXMLView("TextTestTab", TextTestTab::create);
+
+    brls::Theme::getLightTheme().addColor("captioned_image/caption", nvgRGB(2, 176, 183));
+    brls::Theme::getDarkTheme().addColor("captioned_image/caption", nvgRGB(51, 186, 227));
+
+    brls::getStyle().addMetric("about/padding_top_bottom", 50);
+    brls::getStyle().addMetric("about/padding_sides", 75);
+    brls::getStyle().addMetric("about/description_margin", 50);
+
+    // The main activity stays at the bottom of the stack, the tabs are pushed over it
+    brls::Application::pushActivity(new MainActivity(), brls::TransitionAnimation::NONE);
+    runFrames(WARMUP_FRAMES);
+
+    const std::vector<std::pair<std::string, std::function<bool(Scenario*)>>> scripts = {
+        { "components_tab", runComponentsTab },
+        { "spatial_navigation", runSpatialNavigation },
+        { "recycling_list_tab", runRecyclingListTab },
+        { "h_recycler", runHRecycler },
+        { "text_test_tab", runTextTestTab },
+        { "transform_tab", runTransformTab },
+        { "tab_switching", runTabSwitching },
+        { "dialog", runDialog },
+    };
+
+    std::vector<Scenario> scenarios;
+    for (auto& script : scripts)
+    {
+        brls::Logger::info("bench: running {}", script.first);
+
+        scenarios.push_back(Scenario { script.first, {}, {} });
+        Scenario* scenario = &scenarios.back();
+        scenario->samples.reserve(RECYCLER_ROWS * 2);
+
+        if (!script.second(scenario))
+        {
+            brls::Logger::error("bench: the application quit during {}", script.first);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!writeReport(output, scenarios))
+    {
+        brls::Logger::error("bench: cannot write {}", output);
+        return EXIT_FAILURE;
+    }
+
+    brls::Logger::info("bench: results written to {}", output);
+
+    brls::Application::quit();
+    while (brls::Application::mainLoop())
+        ;
+
+    return EXIT_SUCCESS;
+}
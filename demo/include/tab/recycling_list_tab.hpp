@@ -112,6 +112,57 @@ class DataSource
      * 就像返回"科幻小说"、"历史书籍"这样的分类名称
      */
     std::string titleForHeader(brls::RecyclerFrame* recycler, int section) override;
+
+    /*
+     * 提前加载即将滚动进屏幕的行的缩略图
+     * 这样快速滚动时单元格不会出现空白
+     */
+    void prefetchRowsAt(brls::RecyclerFrame* recycler, const std::vector<brls::IndexPath>& indexPaths) override;
+
+    /*
+     * 取消已经不需要的提前加载
+     */
+    void cancelPrefetchingForRowsAt(brls::RecyclerFrame* recycler, const std::vector<brls::IndexPath>& indexPaths) override;
+
+  private:
+    // 正在提前加载的行（分组号, 行号）-> ImageLoader 请求编号
+    // 不同分组的行号会重复，所以要连同分组号一起作为键
+    std::map<std::pair<size_t, int>, size_t> prefetches;
+};
+
+/*
+ * BenchmarkDataSource 类 - 滚动性能测试用的数据源
+ *
+ * 有很多行，每一行只是一个换了背景颜色的单元格
+ * 单元格本身不分配内存，用来检查 RecyclerFrame 回收单元格时有没有堆分配
+ */
+class BenchmarkDataSource
+    : public brls::RecyclerDataSource
+{
+  public:
+    /*
+     * cellHandle 是 registerCell() 返回的编号，rows 是总行数
+     */
+    BenchmarkDataSource(size_t cellHandle, int rows);
+
+    int numberOfSections(brls::RecyclerFrame* recycler) override;
+    int numberOfRows(brls::RecyclerFrame* recycler, int section) override;
+    brls::RecyclerCell* cellForRow(brls::RecyclerFrame* recycler, brls::IndexPath index) override;
+
+  private:
+    size_t cellHandle;
+    int rows;
+};
+
+/*
+ * 滚动性能测试的结果
+ * 内存分配次数只在 borealis_bench 中统计，其他程序中都是 0
+ */
+struct RecyclerBenchmarkResult
+{
+    int rows = 0;
+    size_t firstPassAllocations  = 0;  // 第一遍滚动时各个容器还在增长
+    size_t secondPassAllocations = 0;  // 第二遍滚动时回收单元格的分配次数
 };
 
 /*
@@ -136,7 +187,27 @@ class RecyclingListTab : public brls::Box
      */
     static brls::View* create();
 
+    /*
+     * 换成有 rows 行的 BenchmarkDataSource
+     * borealis_bench 用它来测试滚动一个很长的列表
+     */
+    void setBenchmarkDataSource(int rows);
+
+    /*
+     * 滚动性能测试
+     * 临时换成有 rows 行的 BenchmarkDataSource，一行一行地滚动整个列表两遍，
+     * 在日志中输出每滚动一行的内存分配次数，然后换回原来的数据源
+     * 按 Y 键运行，borealis_bench 也会运行它
+     */
+    RecyclerBenchmarkResult runBenchmark(int rows = 2000);
+
   private:
+    // 测试用单元格的编号（registerCell 的返回值）
+    size_t benchmarkCell = 0;
+
+    // 测试用单元格是否已经提前创建好
+    bool benchmarkCellsReady = false;
+
     /*
      * BRLS_BIND 宏 - 绑定循环列表组件
      * 将XML中的RecyclerFrame组件绑定到C++变量
@@ -59,6 +59,15 @@ int main(int argc, char* argv[])
             // 如果用户输入了 -v 参数，就开启调试视图
             // 这会在屏幕上显示一些开发者才需要的信息
             brls::Application::enableDebuggingView(true);
+        } else if (std::strcmp(argv[i], "-p") == 0) {
+            // 如果用户输入了 -p 参数，就开启帧性能分析
+            // 调试视图会显示每一帧各个阶段的耗时（需要用 -DBRLS_PROFILER=ON 编译）
+#ifdef BRLS_PROFILER
+            brls::Profiler::setEnabled(true);
+            brls::Application::enableDebuggingView(true);
+#else
+            brls::Logger::warning("-p: the profiler is compiled out, build with -DBRLS_PROFILER=ON");
+#endif
         }
     }
 
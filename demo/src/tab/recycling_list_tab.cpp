@@ -12,6 +12,14 @@
 #include "tab/recycling_list_tab.hpp"
 #include "view/pokemon_view.hpp"
 
+// 内存分配次数只在 borealis_bench 中统计（见 bench/alloc_counter.cpp）
+#ifdef BENCH_ALLOCATION_COUNTER
+#include "alloc_counter.hpp"
+#define BENCH_ALLOCATION_COUNT() benchAllocationCount()
+#else
+#define BENCH_ALLOCATION_COUNT() ((size_t)0)
+#endif
+
 // 全局宝可梦数据数组，存储所有要显示的宝可梦
 std::vector<Pokemon> pokemons;
 
@@ -86,12 +94,43 @@ brls::RecyclerCell* DataSource::cellForRow(brls::RecyclerFrame* recycler, brls::
     // 设置单元格显示的宝可梦名字
     item->label->setText(pokemons[indexPath.row].name);
     
-    // 设置单元格显示的宝可梦缩略图
+    // 设置单元格显示的宝可梦缩略图（如果已经提前加载，会直接命中纹理缓存）
+    prefetches.erase(std::make_pair(indexPath.section, indexPath.row));
     item->image->setImageFromRes("img/pokemon/thumbnails/" + pokemons[indexPath.row].id + ".png");
     
     return item;  // 返回配置好的单元格
 }
 
+/*
+ * 提前加载即将显示的行的缩略图
+ * 图片在后台线程解码，放入纹理缓存，等单元格显示时直接使用
+ */
+void DataSource::prefetchRowsAt(brls::RecyclerFrame* recycler, const std::vector<brls::IndexPath>& indexPaths)
+{
+    for (auto& indexPath : indexPaths)
+    {
+        size_t id = brls::Image::prefetchRes("img/pokemon/thumbnails/" + pokemons[indexPath.row].id + ".png");
+        if (id > 0)
+            prefetches[std::make_pair(indexPath.section, indexPath.row)] = id;
+    }
+}
+
+/*
+ * 这些行还没显示就离开了预加载范围，取消它们的加载
+ */
+void DataSource::cancelPrefetchingForRowsAt(brls::RecyclerFrame* recycler, const std::vector<brls::IndexPath>& indexPaths)
+{
+    for (auto& indexPath : indexPaths)
+    {
+        auto it = prefetches.find(std::make_pair(indexPath.section, indexPath.row));
+        if (it == prefetches.end())
+            continue;
+
+        brls::ImageLoader::instance().cancel(it->second);
+        prefetches.erase(it);
+    }
+}
+
 /*
  * 用户点击列表项时的处理函数
  * 当用户选择某个宝可梦时，会显示宝可梦的详细页面
@@ -107,6 +146,47 @@ void DataSource::didSelectRowAt(brls::RecyclerFrame* recycler, brls::IndexPath i
     recycler->present(new PokemonView(pokemons[indexPath.row]));
 }
 
+/*
+ * 滚动性能测试的数据源
+ */
+BenchmarkDataSource::BenchmarkDataSource(size_t cellHandle, int rows)
+    : cellHandle(cellHandle)
+    , rows(rows)
+{
+}
+
+int BenchmarkDataSource::numberOfSections(brls::RecyclerFrame* recycler)
+{
+    return 1;
+}
+
+int BenchmarkDataSource::numberOfRows(brls::RecyclerFrame* recycler, int section)
+{
+    return rows;
+}
+
+brls::RecyclerCell* BenchmarkDataSource::cellForRow(brls::RecyclerFrame* recycler, brls::IndexPath indexPath)
+{
+    // 用编号取单元格，不需要查找字符串
+    brls::RecyclerCell* cell = recycler->dequeueReusableCell(cellHandle);
+
+    // 每一行换一种颜色，不分配内存
+    cell->setBackgroundColor(nvgHSL((indexPath.row % 360) / 360.0f, 0.5f, 0.4f));
+
+    return cell;
+}
+
+/*
+ * 创建测试用单元格
+ * 单元格可以获得焦点，这样也能用方向键一行一行地滚动
+ */
+static brls::RecyclerCell* createBenchmarkCell()
+{
+    brls::RecyclerCell* cell = brls::RecyclerCell::create();
+    cell->setFocusable(true);
+    return cell;
+}
+
 /*
  * RecyclingListTab 构造函数
  * 初始化循环列表标签页
@@ -139,9 +219,65 @@ RecyclingListTab::RecyclingListTab()
     // 注册单元格类型，告诉RecyclerView如何创建不同类型的单元格
     recycler->registerCell("Header", []() { return RecyclerHeader::create(); });  // 注册头部单元格
     recycler->registerCell("Cell", []() { return RecyclerCell::create(); });      // 注册普通单元格
+
+    // 测试用单元格，运行测试时才创建（见 setBenchmarkDataSource）
+    benchmarkCell = recycler->registerCell("Benchmark", createBenchmarkCell);
     
     // 设置数据源，RecyclerView会从这里获取要显示的数据
     recycler->setDataSource(new DataSource());
+
+    // 按 Y 键运行滚动性能测试
+    recycler->registerAction("Benchmark", brls::BUTTON_Y, [this](brls::View* view) {
+        this->runBenchmark();
+        return true;
+    });
+}
+
+/*
+ * 滚动性能测试
+ * 第一遍滚动时各个容器还在增长，第二遍滚动应该几乎没有内存分配
+ * borealis_bench 会把两遍的分配次数写进结果文件，demo 中只滚动列表
+ */
+RecyclerBenchmarkResult RecyclingListTab::runBenchmark(int rows)
+{
+    this->setBenchmarkDataSource(rows);
+
+    RecyclerBenchmarkResult result;
+    result.rows = rows;
+
+    for (size_t* count : { &result.firstPassAllocations, &result.secondPassAllocations })
+    {
+        recycler->selectRowAt(brls::IndexPath(0, 0), false);
+
+        size_t start = BENCH_ALLOCATION_COUNT();
+        for (int row = 0; row < rows; row++)
+            recycler->selectRowAt(brls::IndexPath(0, row), false);
+        *count = BENCH_ALLOCATION_COUNT() - start;
+    }
+
+#ifdef BENCH_ALLOCATION_COUNTER
+    brls::Logger::info("Recycler benchmark: {} rows, first pass {} allocations, second pass {} allocations ({:.3f} per row)",
+        rows, result.firstPassAllocations, result.secondPassAllocations, (float)result.secondPassAllocations / rows);
+#else
+    brls::Logger::info("Recycler benchmark: {} rows scrolled twice, allocations are only counted by borealis_bench", rows);
+#endif
+
+    // 换回宝可梦列表
+    recycler->setDataSource(new DataSource());
+
+    return result;
+}
+
+void RecyclingListTab::setBenchmarkDataSource(int rows)
+{
+    // 第一次运行时提前创建 32 个单元格，滚动时就不用再创建
+    if (!benchmarkCellsReady)
+    {
+        recycler->registerCell("Benchmark", createBenchmarkCell, 32);
+        benchmarkCellsReady = true;
+    }
+
+    recycler->setDataSource(new BenchmarkDataSource(benchmarkCell, rows));
 }
 
 /*
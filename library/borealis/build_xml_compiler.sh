@@ -0,0 +1,36 @@
+set -e
+
+# ======== Manually building brls-xml-compiler ========
+# brls-xml-compiler compiles the XML layouts of the resources into binary layouts (.bxml),
+# loaded by borealis instead of parsing the XML files at runtime (see BRLS_COMPILE_XML).
+# It is built along with the application, except when cross compiling:
+# this script builds it in the format of the host machine.
+#
+# The build compiles the layouts in its copy of the resources (build or package directory),
+# never in the source resources. A .bxml is only loaded if it is at least as recent as
+# its XML file, an XML edited since it was compiled is parsed instead.
+#
+# To bundle compiled layouts with libromfs, run it on the resources before building:
+#   ./brls-xml-compiler resources/xml
+# libromfs keeps no modification times: the .bxml files always win there,
+# run it again after editing the layouts or delete them.
+
+echo "Build brls-xml-compiler"
+
+PROJECT_PATH=$(dirname "$0")
+COMPILER_PATH="${PROJECT_PATH}/library/tools/xml_compiler"
+BUILD_DIR="build_xml_compiler"
+
+cd "${PROJECT_PATH}"
+
+# build brls-xml-compiler
+cmake -B ${BUILD_DIR} "${COMPILER_PATH}" -G Ninja
+cmake --build ${BUILD_DIR}
+
+# put brls-xml-compiler next to the project
+cp ${BUILD_DIR}/brls-xml-compiler "${PROJECT_PATH}"
+echo "Build brls-xml-compiler: ${PROJECT_PATH}/brls-xml-compiler"
+
+# remove build folder
+rm -rf ${BUILD_DIR}
+echo "Remove temp build dir: ${BUILD_DIR}"
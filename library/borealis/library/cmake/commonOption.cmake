@@ -49,6 +49,10 @@ option(CUSTOM_RESOURCES_DIR "Custom resources dir" "")
 option(USE_GLFW "using glfw for input and create window" OFF)
 option(USE_SDL2 "using sdl2 for input and create window" OFF)
 
+# Desktop only: no window nor GPU, frames are drawn in memory with a software renderer while
+# replaying an input script, to measure frame times on any machine (see HeadlessPlatform)
+option(USE_HEADLESS "using a headless platform with software rendering" OFF)
+
 # OpenGL version
 option(USE_GL3 "using OpenGL 3.2+" OFF)
 option(USE_GL2 "using OpenGL 2.1" OFF)
@@ -60,9 +64,17 @@ option(USE_GLES3 "using OpenGL ES 3.0" OFF)
 # or if you do not want others to modify the resource files, you can also enable this option
 option(USE_LIBROMFS "using libromfs to bundle resources" OFF)
 
+# Compile the XML layouts of the resources into binary layouts loaded without parsing XML at runtime.
+# When cross compiling, brls-xml-compiler has to be built beforehand, see borealis/build_xml_compiler.sh
+option(BRLS_COMPILE_XML "Compile XML layouts at build time" ON)
+
 # Disable highlight border animation (Useful for low-end devices like PSVita)
 option(SIMPLE_HIGHLIGHT "Simple highlight" OFF)
 
+# Instrument the main loop and the views with brls::Profiler, enabled at runtime with Profiler::setEnabled().
+# When disabled, the profiling macros compile to nothing.
+option(BRLS_PROFILER "Frame profiler" OFF)
+
 # Enable unity build, using -DCMAKE_UNITY_BUILD_BATCH_SIZE=8 to set the batch size
 # https://cmake.org/cmake/help/latest/prop_tgt/UNITY_BUILD.html
 option(BRLS_UNITY_BUILD "Unity build" OFF)
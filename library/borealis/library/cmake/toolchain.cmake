@@ -94,7 +94,10 @@ else()
 endif ()
 
 # graphics drivers
-if (USE_DEKO3D)
+if (USE_HEADLESS)
+    message(STATUS "USE_SOFTWARE")
+    set(BOREALIS_USE_SOFTWARE ON)
+elseif (USE_DEKO3D)
     message(STATUS "USE_DEKO3D")
     set(BOREALIS_USE_DEKO3D ON)
 elseif (USE_D3D11)
@@ -120,7 +123,12 @@ else ()
 endif ()
 
 # SDL or GLFW
-if (USE_SDL2)
+if (USE_HEADLESS)
+    message(STATUS "Headless")
+    set(USE_SDL2 OFF)
+    set(USE_GLFW OFF)
+    add_definitions(-D__HEADLESS__)
+elseif (USE_SDL2)
     message(STATUS "SDL2")
     set(USE_SDL2 ON)
     set(USE_GLFW OFF)
@@ -137,7 +145,7 @@ endif ()
 if (USE_EGL)
     message(STATUS "Using EGL")
     add_definitions(-DUSE_EGL)
-elseif (NOT USE_D3D11)
+elseif (NOT USE_D3D11 AND NOT USE_HEADLESS)
     message(STATUS "Using native GL")
 endif ()
 
@@ -146,6 +154,11 @@ if (SIMPLE_HIGHLIGHT)
     add_definitions(-DSIMPLE_HIGHLIGHT)
 endif ()
 
+if (BRLS_PROFILER)
+    message(STATUS "Enable BRLS_PROFILER")
+    add_definitions(-DBRLS_PROFILER)
+endif ()
+
 if (USE_STD_THREAD)
     message(STATUS "Enable std thread")
     add_definitions(-DBOREALIS_USE_STD_THREAD)
@@ -243,6 +256,28 @@ function(add_libromfs app res)
     set(LIBROMFS_RESOURCE_LOCATION "${res}" PARENT_SCOPE)
 endfunction()
 
+# Compiles the XML layouts of xml_dir into binary layouts (.bxml) next to them once target is built
+function(brls_compile_xml target xml_dir)
+    if (CMAKE_CROSSCOMPILING)
+        if (NOT DEFINED BRLS_PREBUILT_XML_COMPILER OR NOT EXISTS "${BRLS_PREBUILT_XML_COMPILER}")
+            if (EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/brls-xml-compiler")
+                set(BRLS_PREBUILT_XML_COMPILER "${CMAKE_CURRENT_SOURCE_DIR}/brls-xml-compiler")
+            else ()
+                message(WARNING "brls-xml-compiler has not been built, XML layouts will be parsed at runtime, please refer to borealis/build_xml_compiler.sh for more information")
+                return()
+            endif ()
+        endif ()
+        set(XML_COMPILER ${BRLS_PREBUILT_XML_COMPILER})
+    else ()
+        if (NOT TARGET brls-xml-compiler)
+            add_subdirectory(${BOREALIS_LIBRARY}/tools/xml_compiler ${CMAKE_BINARY_DIR}/brls-xml-compiler EXCLUDE_FROM_ALL)
+        endif ()
+        set(XML_COMPILER $<TARGET_FILE:brls-xml-compiler>)
+        add_dependencies(${target} brls-xml-compiler)
+    endif ()
+    add_custom_command(TARGET ${target} POST_BUILD COMMAND ${XML_COMPILER} ${xml_dir})
+endfunction()
+
 function(git_info tag short)
     # Add git info
     find_package(Git)
@@ -27,14 +27,18 @@
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
 #include <borealis/core/event.hpp>
+#include <borealis/core/focus_graph.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/image_loader.hpp>
 #include <borealis/core/input.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/scroll_engine.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/task.hpp>
 #include <borealis/core/theme.hpp>
@@ -43,6 +47,7 @@
 #include <borealis/core/timer.hpp>
 #include <borealis/core/video.hpp>
 #include <borealis/core/view.hpp>
+#include <borealis/core/xml_layout.hpp>
 
 // Views
 #include <borealis/views/applet_frame.hpp>
@@ -55,6 +60,7 @@
 #include <borealis/views/progress_spinner.hpp>
 #include <borealis/views/rectangle.hpp>
 #include <borealis/views/recycler.hpp>
+#include <borealis/views/h_recycler.hpp>
 #include <borealis/views/scrolling_frame.hpp>
 #include <borealis/views/h_scrolling_frame.hpp>
 #include <borealis/views/sidebar.hpp>
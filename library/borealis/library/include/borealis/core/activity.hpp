@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <borealis/core/focus_graph.hpp>
 #include <borealis/core/view.hpp>
+#include <memory>
 
 namespace brls
 {
@@ -159,11 +161,30 @@ class Activity
 
     View* getDefaultFocus();
 
+    /**
+     * Enables the spatial navigation: directional moves go to the closest view
+     * on screen in that direction instead of following the order of the children
+     * (see FocusGraph). Custom navigation routes still come first.
+     *
+     * Default is disabled.
+     */
+    void setSpatialNavigationEnabled(bool enabled);
+
+    bool isSpatialNavigationEnabled();
+
+    /**
+     * Returns the focus graph of the activity, or nullptr if
+     * the spatial navigation is disabled.
+     */
+    FocusGraph* getFocusGraph();
+
     void setAlpha(float alpha);
 
   private:
     View* constructorView = nullptr;
     View* contentView     = nullptr;
+
+    std::unique_ptr<FocusGraph> focusGraph;
 };
 
 } // namespace brls
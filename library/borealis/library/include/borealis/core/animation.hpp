@@ -97,6 +97,12 @@ class Animatable : public FiniteTicking
   private:
     float currentValue = 0.0f;
     tweeny::tween<float> tween;
+
+    // Rebuilding the tween allocates, it is only done once a step is added
+    // so that setting the value directly stays cheap
+    bool tweenReset = false;
+
+    tweeny::tween<float>& getTween();
 };
 
 void updateHighlightAnimation();
@@ -52,6 +52,18 @@ enum class InputType
 class DebugLayer;
 class EditTextDialog;
 
+// Time spent in each phase of a frame of the main loop, in microseconds
+struct FrameTimings
+{
+    Time platform  = 0; // platform main loop iteration, polling the events
+    Time input     = 0; // input handling
+    Time animation = 0; // highlight animation and tickings
+    Time uploads   = 0; // textures of the images decoded in the background
+    Time layout    = 0; // layout of the views that changed
+    Time draw      = 0; // drawing the views, 0 if nothing was redrawn
+    Time present   = 0; // handing the frame to the video context
+};
+
 typedef std::function<View*(void)> XMLViewCreator;
 
 class Application
@@ -213,6 +225,12 @@ class Application
     static bool getFPSStatus();
     static size_t getFPS();
 
+    /**
+     * Returns the time spent in each phase of the last iteration
+     * of the main loop.
+     */
+    static const FrameTimings& getFrameTimings();
+
     /**
      * Set the FPS limit
      * @param fps 0 to disable limit
@@ -270,6 +288,26 @@ class Application
     static int getDeactivatedFPS();
     static double getDeactivatedFrameTime();
 
+    /**
+     * If the value is set to true, frames are only drawn when something changed
+     * since the last one: a view requested it (see View::setNeedsRedraw()),
+     * a layout pass happened, an animation is running or an input event was received.
+     * The main loop then sleeps instead of drawing the same frame again.
+     *
+     * Without SIMPLE_HIGHLIGHT, the highlight of the focused view is animated
+     * as long as the application is active, use it with setAutomaticDeactivation().
+     *
+     * default is false;
+     */
+    static void setRetainedRendering(bool value);
+    static bool getRetainedRendering();
+
+    /**
+     * Marks the current frame as outdated, it will be drawn again
+     * on the next main loop iteration.
+     */
+    static void requestRedraw();
+
     static GenericEvent* getGlobalFocusChangeEvent();
     static VoidEvent* getGlobalHintsUpdateEvent();
     static Event<InputType>* getGlobalInputTypeChangeEvent();
@@ -306,6 +344,25 @@ class Application
 
     static void addToFreeQueue(View* view);
 
+    /**
+     * Do not call this function, use it internally.
+     * Queues the given layout root for the next layout pass.
+     */
+    static void requestLayout(View* root);
+
+    /**
+     * Do not call this function, use it internally.
+     * Removes the given layout root from the pending layout pass.
+     */
+    static void cancelLayout(View* root);
+
+    /**
+     * Lays out every view tree invalidated since the last layout pass.
+     * Called once per frame before drawing, call it manually
+     * if the geometry of several trees is needed immediately.
+     */
+    static void flushLayout();
+
     /**
      * Returns the current input type.
      */
@@ -374,6 +431,7 @@ class Application
     inline static std::vector<Activity*> activitiesStack;
     inline static std::vector<View*> focusStack;
     inline static std::deque<View*> deletionPool;
+    inline static std::vector<View*> layoutQueue;
 
     inline static View* currentFocus = nullptr;
     inline static std::vector<TouchState> currentTouchState;
@@ -390,6 +448,7 @@ class Application
     inline static ControllerState controllerState = {};
 
     inline static void processInput();
+    inline static bool needsRedraw();
     inline static bool internalMainLoop();
 
     inline static void updateFPS();
@@ -405,9 +464,13 @@ class Application
     inline static size_t globalFPS                      = 60;
     inline static Time limitedFrameTime                 = 0;
     inline static Time frameStartTime                   = 0;
+    inline static Time presentStartTime                 = 0;
+    inline static FrameTimings frameTimings;
     inline static bool hintsLiteMode                    = false;
 
     inline static bool deactivatedBehavior = false;
+    inline static bool retainedRendering   = false;
+    inline static bool redrawRequested     = true;
     inline static bool activeEvent         = false;
     inline static Time lastActiveTime      = 0;
     inline static int deactivatedFPS       = 5; // FPS 5
@@ -57,6 +57,15 @@ enum class Direction
     RIGHT_TO_LEFT,
 };
 
+// How the children of a box are navigated with the spatial navigation,
+// see Activity::setSpatialNavigationEnabled()
+enum class FocusGraphMode
+{
+    CHILDREN, // the children are part of the same graph as the box
+    SCOPE, // the children move together (scrolling), positions are relative to them
+    OWN, // the box navigates between its children with getNextFocus(), the graph only enters it
+};
+
 // Generic FlexBox layout
 class Box : public View
 {
@@ -77,11 +86,21 @@ class Box : public View
     void onParentFocusGained(View* focusedView) override;
     void onParentFocusLost(View* focusedView) override;
     bool applyXMLAttribute(std::string name, std::string value) override;
+    bool overridesXMLAttribute(const std::string& name) override;
 
     static View* create();
 
     virtual View* getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction);
 
+    /**
+     * Returns how the children of this box are placed in the focus graph
+     * of the spatial navigation.
+     *
+     * Boxes overriding getNextFocus() to navigate between their children
+     * should return FocusGraphMode::OWN.
+     */
+    virtual FocusGraphMode getFocusGraphMode();
+
     /**
      * Adds a view to this Box.
      * Returns the position the view was added at.
@@ -104,6 +123,19 @@ class Box : public View
      */
     virtual void clearViews(bool free = true);
 
+    /**
+     * Appends a view to the children of the Box without adding it to the
+     * layout: for children the owner positions and indexes itself (RecyclerFrame cells).
+     * Use eraseChild() to remove it.
+     */
+    void appendChild(View* view);
+
+    /**
+     * Removes a view added with appendChild() from the children of the Box,
+     * without freeing it. Returns false if the view is not a child of the Box.
+     */
+    bool eraseChild(View* view);
+
     /**
      * Sets the padding of the view, aka the internal space to give
      * between this view boundaries and its children.
@@ -181,6 +213,8 @@ class Box : public View
 
     /**
      * Returns the bounds used for culling children.
+     * They are intersected with the culling bounds of the parents
+     * before being checked against the children frames.
      */
     virtual void getCullingBounds(float* top, float* right, float* bottom, float* left);
 
@@ -241,6 +275,33 @@ class Box : public View
 
     std::unordered_map<std::string, std::pair<std::string, View*>> forwardedAttributes;
 
+    // Uniform grid of the children frames, relative to the Box, so that hitTest()
+    // only tries the children under the point. Only used for boxes with a lot of children,
+    // rebuilt when the frames of the children change.
+    struct HitTestGrid
+    {
+        size_t layoutEpoch   = 0;
+        size_t childrenEpoch = 0;
+
+        // False if the children overlap too much for the grid to be worth it
+        bool usable = false;
+
+        Rect bounds;
+        size_t columns   = 0;
+        size_t rows      = 0;
+        float cellWidth  = 0.0f;
+        float cellHeight = 0.0f;
+
+        // Children of each cell, in the order of the children: cell i holds
+        // views[cells[i]] to views[cells[i + 1]] excluded
+        std::vector<uint32_t> cells;
+        std::vector<View*> views;
+    };
+
+    std::unique_ptr<HitTestGrid> hitTestGrid;
+
+    void updateHitTestGrid();
+
   protected:
     /**
      * Inflates the Box with the given XML string.
@@ -286,6 +347,17 @@ class Box : public View
      */
     void inflateFromXMLFile(const std::string& path);
 
+    /**
+     * Inflates the Box with the given element of a compiled layout.
+     *
+     * The root element MUST be a brls::Box, corresponding to the inflated Box itself. Its
+     * attributes will be applied to the Box.
+     *
+     * Each child element will be treated as a view and added
+     * as a child of the Box.
+     */
+    void inflateFromXMLLayout(XMLLayout* layout, size_t element = 0);
+
     /**
      * Handles a child XML element.
      *
@@ -16,287 +16,147 @@
 
 #pragma once
 
-#include <stdexcept>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "borealis/core/singleton.hpp"
 
 namespace brls
 {
 
-template <typename K, typename T>
-struct Node
+struct TextureCacheStats
 {
-    K key;
-    T value;
+    /// Number of getCache() calls that returned a texture
+    size_t hits = 0;
 
-    /// Cache entries marked as dirty will be refreshed when fetching the cache next time
-    bool dirty = false;
+    /// Number of getCache() calls that did not find a texture
+    size_t misses = 0;
 
-    /// Reference count, 1 for each cache hit
-    size_t count = 1;
+    /// Number of textures deleted to stay within the budget
+    size_t evictions = 0;
 
-    Node(K k, T v)
-        : key(k)
-        , value(v)
-    {
-    }
+    /// Size of all the cached textures, in bytes
+    size_t residentBytes = 0;
+
+    /// Size of the cached textures that are still referenced, in bytes
+    size_t pinnedBytes = 0;
+
+    /// Number of cached textures
+    size_t entries = 0;
 };
 
 /**
- * LRU cache
- * If the reference count is not 0, the cache will never expire.
- * Cache items with a reference count of 0 are cached according to LRU rules
+ * Texture cache, bounded by the memory used by the textures rather than their count.
+ *
+ * Textures are reference counted: each getCache() hit and each addCache() takes a reference,
+ * released with removeCache(). A texture with references left is pinned and never deleted.
+ * Unreferenced textures are kept in LRU order and deleted, oldest first,
+ * when the cache goes over its budget.
+ *
+ * Every operation is O(1), except markAllDirty() and clean().
  */
-template <typename K, typename T>
-class LRUCache
+class TextureCache : public Singleton<TextureCache>
 {
   public:
-    typedef typename std::list<Node<K, T>>::iterator CacheIter;
-#define DIRTY "_$dirty$"
-    inline static size_t DEFAULT_CAPACITY      = 400;
+    /// Default budget, in bytes
+#ifdef __PSV__
+    inline static size_t DEFAULT_BUDGET = 48 * 1024 * 1024;
+#else
+    inline static size_t DEFAULT_BUDGET = 256 * 1024 * 1024;
+#endif
     inline static bool ALWAYS_CACHE_LOCAL_FILE = true;
 
-    LRUCache(size_t c, T defaultValue)
-        : capacity(c)
-        , defaultValue(defaultValue)
-    {
-        if (c < 1)
-            throw std::logic_error("Cache capacity cannot less than 1.");
-    }
-
-    T get(K key)
-    {
-        if (!isCacheHit(key))
-        {
-            // Cache not hit
-            return defaultValue;
-        }
-
-        // Cache hit
-        cacheList.splice(cacheList.begin(), cacheList, cacheMap[key]);
-        cacheMap[key]                  = cacheList.begin();
-        valueMap[cacheMap[key]->value] = cacheList.begin();
-        cacheMap[key]->count++;
-        return cacheMap[key]->value;
-    }
-
-    void set(K key, T value)
-    {
-        if (isCacheHit(key))
-        {
-            throw std::logic_error("Can not cache the same key twice.");
-        }
-
-        // Check capacity limits
-        if (cacheList.size() >= capacity)
-        {
-            deleteCache(cacheList.size() - capacity);
-        }
-        // Add new cache
-        cacheList.push_front(Node<K, T>(key, value));
-
-        // Update the values of two maps
-        cacheMap[key]                  = cacheList.begin();
-        valueMap[cacheMap[key]->value] = cacheList.begin();
-    }
+    TextureCache();
 
     /**
-     * It is not really to remove a cache, but to reduce the counter of the corresponding cache by 1
+     * Returns the texture cached for the given key and takes a reference on it,
+     * or 0 if there is none.
      */
-    void remove(T value)
-    {
-        if (!isExisted(value))
-        {
-            return;
-        }
-        valueMap[value]->count--;
-    }
+    int getCache(const std::string& key);
 
     /**
-     * Update a cache value
+     * Add cache, with a reference held by the caller.
+     * Size is read from the texture itself.
      */
-    void update(T old_val, T new_val)
-    {
-        if (!isExisted(old_val))
-        {
-            return;
-        }
-        valueMap[old_val]->value = new_val;
-        valueMap[new_val]        = valueMap[old_val];
-        valueMap.erase(old_val);
-    }
-
-    void setCapacity(int c)
-    {
-        if (c < 1)
-            throw std::logic_error("Cache capacity cannot less than 1.");
-        // The setting standard of the DEFAULT_CAPACITY should be the upper limit of the number of all pictures.
-        c += DEFAULT_CAPACITY;
-        this->capacity = c;
-        if (cacheList.size() > capacity)
-        {
-            deleteCache(cacheList.size() - capacity);
-        }
-    }
+    void addCache(const std::string& key, size_t texture);
 
     /**
-     * A dirty cache is not able to be hit
-     * @param value
+     * Takes another reference on a cached texture.
      */
-    void markDirty(T value)
-    {
-        if (!isExisted(value))
-        {
-            return;
-        }
-
-        auto item = valueMap[value];
-        if (item->dirty)
-            return;
-
-        // modify existing Key.
-        cacheMap.erase(item->key);
-        item->key += DIRTY;
-        item->dirty = true;
-    }
-
-    void markAllDirty()
-    {
-        for (auto& i : cacheList)
-        {
-            if (i.dirty)
-                continue;
-            cacheMap.erase(i.key);
-            i.key += DIRTY;
-            i.dirty = true;
-        }
-    }
-
-    std::list<Node<K, T>>& getCacheList() { return cacheList; }
-
-    void debug()
-    {
-        printf("===== cache size: %zu =====\n", cacheList.size());
-        for (auto& i : cacheList)
-        {
-            printf("count: %zu, dirty: %d, value: %zu, key: %s\n", i.count,
-                i.dirty, i.value, i.key.c_str());
-        }
-    }
-
-  private:
-    size_t capacity = 1;
-    T defaultValue;
-    std::list<Node<K, T>> cacheList;
-    std::unordered_map<K, CacheIter> cacheMap;
-    std::unordered_map<T, CacheIter> valueMap;
+    void retainCache(size_t texture);
 
     /**
-     * Delete N caches from back to front
-     * 1. Delete only the cache with reference count 0
-     * 2. If the deletion is successful, 0 is returned; otherwise,
-     * the returned number represents the quantity that has not been deleted
+     * Subtract the matching texture cache counter by 1.
+     * Once the counter reaches zero, the texture can be evicted.
      */
-    size_t deleteCache(size_t num)
-    {
-        // todo: The current data structure will increase the complexity of each
-        //  new cache from O(1) to O(N) after the cache is full.
-        if (num <= 0)
-            return 0;
-        auto vg = brls::Application::getNVGContext();
-        for (auto i = cacheList.rbegin(); i != cacheList.rend(); i++)
-        {
-            if (i->count <= 0)
-            {
-                num--;
-                nvgDeleteImage(vg, i->value);
-                cacheMap.erase(i->key);
-                valueMap.erase(i->value);
-                cacheList.erase(std::next(i).base());
-                if (num == 0)
-                    break;
-            }
-        }
-        return num;
-    }
-
-    bool isExisted(K key) { return cacheMap.find(key) != cacheMap.end(); }
-
-    bool isExisted(T val) { return valueMap.find(val) != valueMap.end(); }
-
-    bool isCacheHit(K key)
-    {
-        if (isExisted(key))
-            return !cacheMap[key]->dirty;
-        return false;
-    }
-};
+    void removeCache(size_t texture);
 
-class TextureCache : public Singleton<TextureCache>
-{
-  public:
-    TextureCache()
-    {
-        brls::Application::getWindowSizeChangedEvent()->subscribe(
-            [this]()
-            { this->cache.markAllDirty(); });
-
-        brls::Application::getExitEvent()->subscribe([this]()
-            { this->clean(); });
-    }
+    /**
+     * A dirty cache is not able to be hit anymore,
+     * and is deleted as soon as it is not referenced.
+     */
+    void markDirty(size_t texture);
 
-    int getCache(const std::string& key) { return cache.get(key); }
+    void markAllDirty();
 
     /**
-     * Add cache
+     * update texture id
      */
-    void addCache(const std::string& key, size_t texture)
-    {
-        if (texture <= 0)
-            return;
-        cache.set(key, texture);
-    }
+    void updateCache(size_t old_tex, size_t new_tex);
 
     /**
-     * Subtract the matching texture cache counter by 1,
-     * and delete the cache if the counter returns to zero.
+     * Sets the maximum size of the cached textures, in bytes.
+     * Referenced textures are never evicted, so the cache can go over
+     * budget while they are in use.
      */
-    void removeCache(size_t texture)
-    {
-        if (texture <= 0)
-            return;
-        cache.remove(texture);
-    }
+    void setBudget(size_t bytes);
+    size_t getBudget();
 
-    void markDirty(size_t texture)
-    {
-        if (texture <= 0)
-            return;
-        cache.markDirty(texture);
-    }
+    TextureCacheStats getStats();
+    void resetStats();
 
     /**
-     * update texture id
+     * Deletes all the cached textures.
      */
-    void updateCache(size_t old_tex, size_t new_tex)
-    {
-        if (old_tex <= 0 || new_tex <= 0)
-            return;
-        cache.update(old_tex, new_tex);
-    }
+    void clean();
+
+    void debug();
 
-    void clean()
+  private:
+    struct Entry
     {
-        auto vg = brls::Application::getNVGContext();
-        for (auto& i : cache.getCacheList())
-        {
-            nvgDeleteImage(vg, i.value);
-        }
-    }
+        std::string key;
+        int texture  = 0;
+        size_t bytes = 0;
+
+        /// Reference count, 1 for each cache hit
+        size_t count = 1;
+
+        /// Cache entries marked as dirty will not be hit again
+        bool dirty = false;
+
+        /// LRU links, only set while the entry is not referenced
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
+    };
+
+    void pushFront(Entry* entry);
+    void unlink(Entry* entry);
+    void release(Entry* entry);
+    void deleteEntry(Entry* entry);
+    void trim();
+    Entry* findEntry(size_t texture);
+
+    size_t budget = DEFAULT_BUDGET;
+    TextureCacheStats stats;
 
-    void debug() { cache.debug(); }
+    std::unordered_map<std::string, Entry*> keyMap;
+    std::unordered_map<int, std::unique_ptr<Entry>> textureMap;
 
-    LRUCache<std::string, size_t> cache = LRUCache<std::string, size_t>(200, 0);
+    // Unreferenced entries, most recently used first
+    Entry* lruHead = nullptr;
+    Entry* lruTail = nullptr;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/box.hpp>
+#include <borealis/core/geometry.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace brls
+{
+
+// Directional navigation following the frames of the views rather than the
+// order of the children, see Activity::setSpatialNavigationEnabled().
+//
+// The graph holds the focusable views of a tree with their frames. It is built
+// lazily after a layout pass or a change in the tree (see View::getLayoutEpoch()),
+// and the moves found are remembered until then: pressing a direction again
+// from the same view does not search again.
+//
+// Scrolled content (FocusGraphMode::SCOPE) is positioned relative to itself so
+// that scrolling does not outdate the graph, and the scrolled box still decides
+// of the moves inside of it (see Box::getParentNavigationDecision()). Boxes
+// navigating between their children themselves (FocusGraphMode::OWN) are entered
+// as a whole, moves from a view inside of them are left to getNextFocus().
+class FocusGraph
+{
+  public:
+    /**
+     * Finds the view to focus when moving from currentView in the given direction,
+     * in the tree starting at root. next is set to nullptr if there is none.
+     *
+     * Returns false if currentView is not part of the graph, in which case
+     * the move should go through getNextFocus().
+     */
+    bool getNextFocus(View* root, View* currentView, FocusDirection direction, View** next);
+
+    /**
+     * Discards the graph, it is built again on the next move.
+     */
+    void invalidate();
+
+  private:
+    // A focusable view, or a box entered as a whole
+    struct Node
+    {
+        View* view;
+        Rect frame; // relative to the origin of the scope
+
+        // Node found in each direction, NEXT_NONE or NEXT_UNKNOWN
+        int next[4];
+    };
+
+    // Views moving together: the whole tree, or one child of a SCOPE box
+    struct Scope
+    {
+        Scope(View* origin, int parent, int parentNode)
+            : origin(origin)
+            , parent(parent)
+            , parentNode(parentNode)
+        {
+        }
+
+        View* origin;
+        int parent;
+        int parentNode; // the SCOPE box in the parent scope
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> order[4]; // nodes sorted by leading edge, for each direction
+    };
+
+    View* root         = nullptr;
+    size_t layoutEpoch = 0;
+
+    std::vector<Scope> scopes;
+    std::unordered_map<View*, std::pair<int, int>> positions; // scope and node of the focusable views
+
+    void build(View* root);
+    void collect(View* view, int scope, Point origin);
+    int addNode(int scope, View* view, Rect frame);
+    View* decide(int scope, View* newFocus, FocusDirection direction);
+    int search(int scope, Rect from, FocusDirection direction, int exclude);
+};
+
+} // namespace brls
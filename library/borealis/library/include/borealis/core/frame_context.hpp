@@ -19,6 +19,8 @@
 
 #include <nanovg.h>
 
+#include <cmath>
+
 #include <borealis/core/font.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/theme.hpp>
@@ -33,6 +35,14 @@ class FrameContext
     float pixelRatio     = 0.0;
     FontStash* fontStash = nullptr;
     Theme theme          = nullptr;
+
+    // Culling bounds of the Box being drawn, in screen coordinates: the intersection
+    // of its own culling bounds with the ones of all its parents.
+    // Children entirely outside of them are not drawn.
+    float cullingTop    = -INFINITY;
+    float cullingRight  = INFINITY;
+    float cullingBottom = INFINITY;
+    float cullingLeft   = -INFINITY;
 };
 
 } // namespace brls
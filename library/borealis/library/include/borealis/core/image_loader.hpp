@@ -0,0 +1,144 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/singleton.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/core/time.hpp>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace brls
+{
+
+typedef std::function<void(int texture)> ImageLoaderCallback;
+
+/**
+ * Decodes images on the worker threads (see brls::async) and creates their
+ * textures on the main thread, spending a limited amount of time
+ * on texture uploads every frame.
+ *
+ * Images loaded with a key are registered in the TextureCache once uploaded,
+ * with one reference for each request. Requests for a key that is already being
+ * loaded share the same decoding. Callers are expected to look the
+ * TextureCache up before starting a load.
+ *
+ * Must only be used from the main thread.
+ */
+class ImageLoader : public Singleton<ImageLoader>
+{
+  public:
+    /**
+     * Loads the image at the given path, also used as the TextureCache key.
+     *
+     * The callback is executed on the main thread with the texture,
+     * or 0 if the image could not be decoded.
+     *
+     * Returns an identifier to give to cancel().
+     */
+    size_t loadFile(const std::string& path, int imageFlags, ImageLoaderCallback callback);
+
+    /**
+     * Loads the image from memory. The data is copied until the image is decoded.
+     * The texture is registered in the TextureCache if key is not empty.
+     *
+     * Returns an identifier to give to cancel().
+     */
+    size_t loadMem(const std::string& key, const unsigned char* data, size_t size, int imageFlags, ImageLoaderCallback callback);
+
+    /**
+     * Loads the image at the given path into the TextureCache without using it,
+     * so that a later load of the same path is a cache hit.
+     * Prefetches are decoded after the other loads.
+     *
+     * Returns an identifier to give to cancel(), or 0 if the image is already cached.
+     */
+    size_t prefetchFile(const std::string& path, int imageFlags);
+
+    /**
+     * Same as prefetchFile(), from memory. The data is copied until the image is decoded.
+     */
+    size_t prefetchMem(const std::string& key, const unsigned char* data, size_t size, int imageFlags);
+
+    /**
+     * Cancels a pending load, its callback will not be executed.
+     * The image is still decoded and cached if other requests share it
+     * or if its decoding already started.
+     */
+    void cancel(size_t id);
+
+    /**
+     * Sets the maximum time spent creating textures every frame, in microseconds.
+     * At least one texture is created per frame.
+     *
+     * Default is 4000.
+     */
+    void setUploadBudget(Time budget);
+
+    /**
+     * Do not call this function, use it internally.
+     * Creates the textures of the decoded images, called once per frame by the main loop.
+     */
+    void processUploads();
+
+  private:
+    struct Job
+    {
+        std::string key;
+        int imageFlags;
+
+        // Path or encoded data, released once decoded
+        bool fromFile = false;
+        std::string source;
+
+        // Decoded RGBA pixels, written by the worker
+        unsigned char* pixels = nullptr;
+        int width             = 0;
+        int height            = 0;
+
+        // Requests waiting for this image, only touched on the main thread
+        std::vector<std::pair<size_t, ImageLoaderCallback>> callbacks;
+
+        // Set once all the requests are cancelled, the worker skips the decoding
+        std::atomic<bool> abandoned { false };
+    };
+
+    size_t enqueue(std::shared_ptr<Job> job, ImageLoaderCallback callback, TaskPriority priority = TaskPriority::NORMAL);
+    size_t prefetch(std::shared_ptr<Job> job);
+    void upload(const std::shared_ptr<Job>& job);
+
+    Time uploadBudget = 4000;
+    size_t lastId     = 0;
+
+    // Jobs being loaded, by key and image flags: the texture is created with
+    // the flags, a request with other flags cannot join the job
+    std::map<std::pair<std::string, int>, std::shared_ptr<Job>> loadingJobs;
+    std::unordered_map<size_t, std::shared_ptr<Job>> requests;
+
+    std::mutex decodedMutex;
+    std::deque<std::shared_ptr<Job>> decodedJobs;
+};
+
+} // namespace brls
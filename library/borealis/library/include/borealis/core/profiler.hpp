@@ -0,0 +1,225 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace brls
+{
+
+class View;
+
+// A zone of a profiled frame: a phase of the main loop or anything
+// measured with BRLS_PROFILE_ZONE
+struct ProfileZone
+{
+    const char* name;
+    Time start;
+    Time duration;
+    uint8_t depth;
+};
+
+// Time spent drawing a view during a profiled frame, children excluded
+struct ProfileViewCost
+{
+    const View* view; // only used to tell views apart, it may be freed since
+    const std::type_info* type;
+    Time self;
+    Time total;
+};
+
+struct ProfileFrame
+{
+    static constexpr size_t MAX_ZONES = 64;
+    static constexpr size_t MAX_VIEWS = 8;
+
+    size_t index;
+    Time start;
+    Time duration;
+
+    size_t zoneCount;
+    size_t droppedZones; // zones beyond MAX_ZONES
+    ProfileZone zones[MAX_ZONES];
+
+    // The most expensive views, sorted by decreasing self time
+    size_t viewCount;
+    ProfileViewCost views[MAX_VIEWS];
+};
+
+// Frame profiler of the main loop, built with -DBRLS_PROFILER=ON.
+//
+// The main loop and View::frame() are instrumented with the macros below, which
+// compile to nothing without BRLS_PROFILER. Once enabled at runtime, the zones of
+// the last FRAMES frames are kept in a ring buffer allocated up front, along with the
+// views that took the longest to draw. They are shown by the DebugLayer when the
+// debugging view is enabled, and can be exported as a Chrome trace (chrome://tracing
+// or https://ui.perfetto.dev).
+//
+// BRLS_PROFILE_ZONE("name") measures the rest of the scope as a zone, BRLS_PROFILE_BEGIN("name")
+// and BRLS_PROFILE_END() a part of it. Zones must be opened and closed on the main thread.
+class Profiler
+{
+  public:
+    // Number of frames kept in the ring buffer
+    static constexpr size_t FRAMES = 120;
+
+    /**
+     * Starts or stops recording frames. Starting allocates the ring buffer,
+     * stopping keeps the frames recorded so far.
+     */
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled()
+    {
+        return enabled;
+    }
+
+    static void beginFrame();
+    static void endFrame();
+
+    static void beginZone(const char* name);
+    static void endZone();
+
+    static void beginView(const View* view);
+    static void endView(const View* view);
+
+    /**
+     * Returns the number of complete frames in the ring buffer.
+     */
+    static size_t getFrameCount();
+
+    /**
+     * Returns a complete frame, 0 being the last one.
+     */
+    static const ProfileFrame& getFrame(size_t age);
+
+    /**
+     * Returns the demangled class name of a view.
+     */
+    static std::string getViewName(const ProfileViewCost& cost);
+
+    /**
+     * Writes the frames of the ring buffer as a Chrome trace (JSON object format).
+     * Returns false if the file cannot be written.
+     */
+    static bool exportChromeTrace(const std::string& path);
+
+  private:
+    inline static bool enabled     = false;
+    inline static bool inFrame     = false;
+    inline static size_t nextFrame = 0;
+
+    inline static std::vector<ProfileFrame> frames;
+
+    // Zones being measured in the current frame
+    inline static size_t openZones[16];
+    inline static size_t openZoneCount    = 0;
+    inline static size_t skippedZoneCount = 0; // opened deeper than openZones
+
+    // Views being drawn in the current frame, with the time taken by their children
+    struct OpenView
+    {
+        Time start;
+        Time children;
+    };
+    inline static OpenView openViews[64];
+    inline static size_t openViewCount    = 0;
+    inline static size_t skippedViewCount = 0; // drawn deeper than openViews
+
+    inline static std::vector<ProfileViewCost> viewCosts;
+
+    static ProfileFrame& currentFrame();
+};
+
+// Measures the time until the end of the scope
+class ProfileScope
+{
+  public:
+    ProfileScope(const char* name)
+    {
+        if (Profiler::isEnabled())
+        {
+            Profiler::beginZone(name);
+            this->active = true;
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (this->active)
+            Profiler::endZone();
+    }
+
+  private:
+    bool active = false;
+};
+
+// Attributes the time until the end of the scope to a view
+class ProfileViewScope
+{
+  public:
+    ProfileViewScope(const View* view)
+        : view(view)
+    {
+        if (Profiler::isEnabled())
+        {
+            Profiler::beginView(view);
+            this->active = true;
+        }
+    }
+
+    ~ProfileViewScope()
+    {
+        if (this->active)
+            Profiler::endView(this->view);
+    }
+
+  private:
+    const View* view;
+    bool active = false;
+};
+
+} // namespace brls
+
+#define BRLS_PROFILE_CONCAT_INNER(a, b) a##b
+#define BRLS_PROFILE_CONCAT(a, b) BRLS_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef BRLS_PROFILER
+#define BRLS_PROFILE_IF_ENABLED(call)      \
+    do                                     \
+    {                                      \
+        if (::brls::Profiler::isEnabled()) \
+            call;                          \
+    } while (0)
+#define BRLS_PROFILE_FRAME_BEGIN() BRLS_PROFILE_IF_ENABLED(::brls::Profiler::beginFrame())
+#define BRLS_PROFILE_FRAME_END() BRLS_PROFILE_IF_ENABLED(::brls::Profiler::endFrame())
+#define BRLS_PROFILE_BEGIN(name) BRLS_PROFILE_IF_ENABLED(::brls::Profiler::beginZone(name))
+#define BRLS_PROFILE_END() BRLS_PROFILE_IF_ENABLED(::brls::Profiler::endZone())
+#define BRLS_PROFILE_ZONE(name) ::brls::ProfileScope BRLS_PROFILE_CONCAT(brlsProfileScope, __LINE__)(name)
+#define BRLS_PROFILE_VIEW(view) ::brls::ProfileViewScope BRLS_PROFILE_CONCAT(brlsProfileViewScope, __LINE__)(view)
+#else
+#define BRLS_PROFILE_FRAME_BEGIN() (void)0
+#define BRLS_PROFILE_FRAME_END() (void)0
+#define BRLS_PROFILE_BEGIN(name) (void)0
+#define BRLS_PROFILE_END() (void)0
+#define BRLS_PROFILE_ZONE(name) (void)0
+#define BRLS_PROFILE_VIEW(view) (void)0
+#endif
@@ -0,0 +1,163 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+
+namespace brls
+{
+
+// Scrolling state along one axis: the offset of the content, between 0 and the
+// maximum offset, and its motion.
+//
+// The offset is either set directly, animated towards a target with an ease-out curve,
+// dragged by a finger or left to slide on its own after a fling: the velocity then decays
+// exponentially until it stops. Dragging or sliding past the range goes into overscroll,
+// with a rubber-band resistance, and a spring brings the offset back once released.
+//
+// setScrollCallback() is called every time the offset changes, from
+// the main loop when the offset moves on its own.
+class ScrollEngine : public Ticking
+{
+  public:
+    /**
+     * Returns the current offset, outside of the range while in overscroll.
+     */
+    float getOffset() const
+    {
+        return offset;
+    }
+
+    /**
+     * Returns the current velocity of the offset, in pixels per second.
+     */
+    float getVelocity() const
+    {
+        return velocity;
+    }
+
+    /**
+     * Sets the range of the offset, from 0 to maxOffset. The viewport
+     * size is the distance over which the rubber band stretches.
+     *
+     * If the offset is out of the new range and not moving, it is brought
+     * back into it right away.
+     */
+    void setRange(float maxOffset, float viewport);
+
+    float getMaxOffset() const
+    {
+        return maxOffset;
+    }
+
+    /**
+     * Enables or disables the overscroll. When disabled, drags and flings
+     * stop at the bounds.
+     * Default is enabled.
+     */
+    void setOverscrollEnabled(bool enabled);
+
+    /**
+     * Sets the callback executed every time the offset changes.
+     */
+    void setScrollCallback(TickingGenericCallback callback);
+
+    /**
+     * Stops any motion and moves to the given offset, clamped to the range.
+     */
+    void setOffset(float value);
+
+    /**
+     * Stops any motion and animates to the given offset, clamped to the range.
+     * Duration is in ms.
+     */
+    void animateTo(float value, Time duration);
+
+    /**
+     * Stops any motion and starts following a finger, see dragTo().
+     */
+    void beginDrag();
+
+    /**
+     * Moves the offset by the given distance from where the drag began.
+     * Past the range, the offset only moves by a fraction of the distance.
+     */
+    void dragTo(float distance);
+
+    /**
+     * Releases the finger, flinging with the given velocity in pixels per second,
+     * or going back into the range if in overscroll.
+     */
+    void endDrag(float velocity);
+
+    /**
+     * Slides with the given velocity in pixels per second, slowing down until it stops.
+     */
+    void fling(float velocity);
+
+    bool isDragging() const
+    {
+        return dragging;
+    }
+
+    /**
+     * Returns true if the offset is out of the range.
+     */
+    bool isOverscrolled() const;
+
+  protected:
+    bool onUpdate(Time delta) override;
+    void onStop() override;
+
+  private:
+    enum class Motion
+    {
+        NONE,
+        ANIMATION, // ease-out towards target
+        FLING, // velocity decay
+        BOUNCE, // spring back to the closest bound
+    };
+
+    float offset    = 0.0f;
+    float velocity  = 0.0f;
+    float maxOffset = 0.0f;
+    float viewport  = 0.0f;
+
+    bool overscrollEnabled = true;
+
+    Motion motion = Motion::NONE;
+
+    // Animation
+    float animationFrom = 0.0f;
+    float animationTo   = 0.0f;
+    Time animationTime  = 0;
+    Time animationEnd   = 0;
+
+    // Drag
+    bool dragging   = false;
+    float dragStart = 0.0f;
+
+    TickingGenericCallback scrollCallback = [] {};
+
+    float clamp(float value) const;
+    float rubberBand(float value) const;
+    float rubberBandInverse(float value) const;
+    void setMotion(Motion motion);
+    void moveTo(float value);
+};
+
+} // namespace brls
@@ -20,11 +20,26 @@
 
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace brls
 {
 
+/**
+ * Handle to an interned style metric name, see ThemeKey.
+ */
+class StyleKey
+{
+  public:
+    explicit StyleKey(const std::string& name);
+
+    size_t getId() const { return this->id; }
+    const std::string& getName() const;
+
+  private:
+    size_t id;
+};
+
 class StyleValues
 {
   public:
@@ -33,8 +48,13 @@ class StyleValues
     void addMetric(const std::string&, float value);
     float getMetric(const std::string& name);
 
+    void addMetric(StyleKey key, float value);
+    float getMetric(StyleKey key);
+
   private:
-    std::unordered_map<std::string, float> values;
+    std::vector<float> values;
+    std::vector<bool> defined;
+    size_t count = 0;
 };
 
 // Simple wrapper around StyleValues for the array operator
@@ -43,10 +63,14 @@ class Style
   public:
     Style(StyleValues* values);
     float operator[](const std::string& name);
+    float operator[](StyleKey key);
 
     void addMetric(const std::string& name, float value);
     float getMetric(const std::string& name);
 
+    void addMetric(StyleKey key, float value);
+    float getMetric(StyleKey key);
+
   private:
     StyleValues* values;
 };
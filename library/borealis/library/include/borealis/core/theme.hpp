@@ -21,7 +21,7 @@
 
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace brls
 {
@@ -32,6 +32,25 @@ enum class ThemeVariant
     DARK
 };
 
+/**
+ * Handle to an interned theme color name.
+ *
+ * Resolving the name is done once, when the key is created. Looking a color up
+ * with a key is then a plain array access, so keys used every frame should be
+ * created once and kept around (as static variables for instance).
+ */
+class ThemeKey
+{
+  public:
+    explicit ThemeKey(const std::string& name);
+
+    size_t getId() const { return this->id; }
+    const std::string& getName() const;
+
+  private:
+    size_t id;
+};
+
 class ThemeValues
 {
   public:
@@ -40,8 +59,13 @@ class ThemeValues
     void addColor(const std::string&, NVGcolor color);
     NVGcolor getColor(const std::string&);
 
+    void addColor(ThemeKey key, NVGcolor color);
+    NVGcolor getColor(ThemeKey key);
+
   private:
-    std::unordered_map<std::string, NVGcolor> values;
+    std::vector<NVGcolor> values;
+    std::vector<bool> defined;
+    size_t count = 0;
 };
 
 // Simple wrapper around ThemeValues for the array operator
@@ -50,10 +74,14 @@ class Theme
   public:
     Theme(ThemeValues* values);
     NVGcolor operator[](const std::string& name);
+    NVGcolor operator[](ThemeKey key);
 
     void addColor(const std::string&, NVGcolor color);
     NVGcolor getColor(const std::string& name);
 
+    void addColor(ThemeKey key, NVGcolor color);
+    NVGcolor getColor(ThemeKey key);
+
     static Theme& getLightTheme();
     static Theme& getDarkTheme();
 
@@ -19,11 +19,13 @@
 #include <unistd.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 #include <vector>
-#include <set>
 
 namespace brls
 {
@@ -31,17 +33,33 @@ namespace brls
 struct DelayOperation
 {
 #ifdef PS4
-    uint64_t startPoint;
+    uint64_t deadline;
 #else
-    std::chrono::high_resolution_clock::time_point startPoint;
+    std::chrono::high_resolution_clock::time_point deadline;
 #endif
-    long delayMilliseconds;
     size_t index;
     std::function<void()> func;
+
+    // Heap ordering: earliest deadline first, then first scheduled first
+    bool operator>(const DelayOperation& other) const
+    {
+        return deadline > other.deadline || (deadline == other.deadline && index > other.index);
+    }
 };
 
 typedef std::vector<DelayOperation>::iterator DelayOperationIterator;
 
+/**
+ * Priority of a task executed by async(). Workers always pick
+ * the task with the highest priority available in the pool.
+ */
+enum class TaskPriority
+{
+    HIGH,
+    NORMAL,
+    LOW,
+};
+
 /**
  * Enqueue a function to be executed before
  * the application is redrawn the next time.
@@ -61,6 +79,12 @@ extern void sync(const std::function<void()>& func);
  */
 extern void async(const std::function<void()>& func);
 
+/**
+ * Enqueue a function to be executed in
+ * parallel with application's main thread, with the given priority.
+ */
+extern void async(const std::function<void()>& func, TaskPriority priority);
+
 extern size_t delay(long milliseconds, const std::function<void()>& func);
 
 extern void cancelDelay(size_t iter);
@@ -85,6 +109,18 @@ class Threading
      */
     static void async(const std::function<void()>& func);
 
+    /**
+     * Enqueue a function to be executed in
+     * parallel with application's main thread, with the given priority.
+     */
+    static void async(const std::function<void()>& func, TaskPriority priority);
+
+    /**
+     * Returns the number of worker threads running async() tasks,
+     * one per core available to the application.
+     */
+    static size_t getWorkerCount();
+
     static size_t delay(long milliseconds, const std::function<void()>& func);
 
     static void cancelDelay(size_t iter);
@@ -101,30 +137,44 @@ class Threading
         return &m_sync_functions;
     }
 
-    static std::vector<std::function<void()>>* getAsyncTasks()
+  private:
+    // Tasks of one worker, one deque per priority.
+    // The worker pops from the front, idle workers steal from the back.
+    struct TaskQueue
     {
-        std::lock_guard<std::mutex> guard(m_async_mutex);
-        return &m_async_tasks;
-    }
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks[3];
+    };
 
-  private:
     inline static std::mutex m_sync_mutex;
     inline static std::vector<std::function<void()>> m_sync_functions;
 
+    inline static std::vector<TaskQueue*> m_async_queues;
+    inline static size_t m_async_next_queue = 0;
+
+    // Guards the pending count, workers sleep on the condition when it is 0
     inline static std::mutex m_async_mutex;
-    inline static std::vector<std::function<void()>> m_async_tasks;
+    inline static std::condition_variable m_async_condition;
+    inline static size_t m_async_pending = 0;
 
+    // Delayed tasks are kept in a min-heap ordered by deadline, only the expired ones
+    // are looked at every frame. Cancelling only forgets the index, cancelled
+    // operations are dropped from the heap when they expire or on compaction.
     inline static std::mutex m_delay_mutex;
     inline static std::vector<DelayOperation> m_delay_tasks;
-    inline static std::set<size_t> m_delay_cancel_set;
+    inline static std::unordered_set<size_t> m_delay_pending;
+    inline static std::vector<DelayOperation> m_delay_expired;
     inline static size_t m_delay_index = 0;
 
     inline static volatile bool task_loop_active = true;
 
     static void* task_loop(void* a);
-    static void std_task_loop();
+    static void std_task_loop(size_t worker);
 
     static void start_task_loop();
+
+    static void init_task_queues();
+    static bool pop_task(size_t worker, std::function<void()>* task);
 };
 
 } // namespace brls
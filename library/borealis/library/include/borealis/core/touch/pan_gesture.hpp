@@ -18,6 +18,7 @@
 
 #include <borealis/core/event.hpp>
 #include <borealis/core/gesture.hpp>
+#include <borealis/core/time.hpp>
 
 namespace brls
 {
@@ -41,6 +42,10 @@ struct PanGestureStatus
     Point delta; // Difference between current and previous positions by X
     bool deltaOnly = false; // If true, current state will contain delta values ONLY
 
+    // Velocity of the finger in pixels per second, measured over the last frames
+    // NOT NULL ONLY from gesture callback and when current state is STAY or END
+    Point velocity;
+
     // Acceleration info, NOT NULL ONLY from
     // gesture callback and when current state is END
     PanAcceleration acceleration;
@@ -80,14 +85,22 @@ class PanGestureRecognizer : public GestureRecognizer
     static inline float panFactor{1.0f};
   
   private:
+    struct PanSample
+    {
+        Point position;
+        Time time; // usec
+    };
+
     int lastFingerId = 0;
     PanGestureEvent panEvent;
     Point position;
     Point startPosition;
     Point delta;
     PanAxis axis;
-    std::vector<Point> posHistory;
+    std::vector<PanSample> posHistory;
     GestureState lastState;
+
+    Point getVelocity(Time now);
 };
 
 } // namespace brls
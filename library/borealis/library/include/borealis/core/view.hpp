@@ -26,6 +26,7 @@
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/core/xml_layout.hpp>
 #include <functional>
 #include <memory>
 #include <set>
@@ -48,6 +49,18 @@
             brls::fatal("Illegal value \"" + value + "\" for XML attribute \"" + name + "\""); \
     })
 
+// Same as BRLS_REGISTER_ENUM_XML_ATTRIBUTE, to be used in the function given to View::registerXMLAttributes()
+// The attribute is registered in the "attributes" table, and method is the name of the setter to call on the view
+#define BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(name, enumType, method, ...)              \
+    attributes.registerStringXMLAttribute(name, [](auto* view, std::string value) {      \
+        static const std::unordered_map<std::string, enumType> enumMap = __VA_ARGS__;    \
+        auto it = enumMap.find(value);                                                   \
+        if (it != enumMap.end())                                                         \
+            view->method(it->second);                                                    \
+        else                                                                             \
+            brls::fatal("Illegal value \"" + value + "\" for XML attribute \"" + name + "\""); \
+    })
+
 // Shortcut to register an A key action (generic click) on a view given its id, that calls any function or method
 // To be used in activities or derivates of Box (internally uses the getView() method)
 // The function or method must return a boolean (true if the action was consumed, false otherwise) and take a single brls::View*
@@ -213,6 +226,149 @@ typedef std::function<void(NVGcolor)> ColorAttributeHandler;
 typedef std::function<void(bool)> BoolAttributeHandler;
 typedef std::function<void(std::string)> FilePathAttributeHandler;
 
+/**
+ * XML attributes handlers of a view class, shared by all of its instances.
+ * See View::registerXMLAttributes().
+ */
+struct XMLAttributeTable
+{
+    std::unordered_map<std::string, std::function<void(View*)>> autoAttributes;
+    std::unordered_map<std::string, std::function<void(View*, float)>> percentageAttributes;
+    std::unordered_map<std::string, std::function<void(View*, float)>> floatAttributes;
+    std::unordered_map<std::string, std::function<void(View*, std::string)>> stringAttributes;
+    std::unordered_map<std::string, std::function<void(View*, NVGcolor)>> colorAttributes;
+    std::unordered_map<std::string, std::function<void(View*, bool)>> boolAttributes;
+    std::unordered_map<std::string, std::function<void(View*, std::string)>> filePathAttributes;
+
+    std::set<std::string> knownAttributes;
+
+    // Table of the parent class, looked up for the attributes not found in this one
+    const XMLAttributeTable* parent = nullptr;
+};
+
+/**
+ * An XML attribute value parsed for a view, along with the handler to apply it.
+ * Values resolved from the tables of a class can be applied to all the views of that class.
+ */
+struct XMLAttributeValue
+{
+    enum class Type
+    {
+        AUTO,
+        PERCENTAGE,
+        FLOAT,
+        STRING,
+        COLOR,
+        BOOL,
+        FILE_PATH,
+    };
+
+    Type type = Type::AUTO;
+
+    // Handler of the table matching the type
+    union
+    {
+        const std::function<void(View*)>* autoHandler = nullptr;
+        const std::function<void(View*, float)>* floatHandler;
+        const std::function<void(View*, std::string)>* stringHandler;
+        const std::function<void(View*, NVGcolor)>* colorHandler;
+        const std::function<void(View*, bool)>* boolHandler;
+    };
+
+    float number   = 0.0f;
+    NVGcolor color = {};
+    bool boolean   = false;
+    std::string string;
+
+    // False if the value can change from one view to the other, such as theme colors
+    bool reusable = true;
+
+    bool setNumber(Type type, const std::function<void(View*, float)>* handler, float number)
+    {
+        this->type         = type;
+        this->floatHandler = handler;
+        this->number       = number;
+        return true;
+    }
+
+    bool setString(Type type, const std::function<void(View*, std::string)>* handler, std::string string)
+    {
+        this->type          = type;
+        this->stringHandler = handler;
+        this->string        = std::move(string);
+        return true;
+    }
+
+    bool setColor(const std::function<void(View*, NVGcolor)>* handler, NVGcolor color)
+    {
+        this->type         = Type::COLOR;
+        this->colorHandler = handler;
+        this->color        = color;
+        return true;
+    }
+};
+
+/**
+ * Fills the XMLAttributeTable of the view class T. Handlers are given the view
+ * the attribute is applied to instead of capturing it.
+ *
+ * See the register*XMLAttribute() methods of View for the meaning of each type.
+ */
+template <typename T>
+class XMLAttributes
+{
+  public:
+    explicit XMLAttributes(XMLAttributeTable* table)
+        : table(table)
+    {
+    }
+
+    void registerAutoXMLAttribute(std::string name, std::function<void(T*)> handler)
+    {
+        this->table->autoAttributes[name] = [handler](View* view) { handler(static_cast<T*>(view)); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerPercentageXMLAttribute(std::string name, std::function<void(T*, float)> handler)
+    {
+        this->table->percentageAttributes[name] = [handler](View* view, float value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerFloatXMLAttribute(std::string name, std::function<void(T*, float)> handler)
+    {
+        this->table->floatAttributes[name] = [handler](View* view, float value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerStringXMLAttribute(std::string name, std::function<void(T*, std::string)> handler)
+    {
+        this->table->stringAttributes[name] = [handler](View* view, std::string value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerColorXMLAttribute(std::string name, std::function<void(T*, NVGcolor)> handler)
+    {
+        this->table->colorAttributes[name] = [handler](View* view, NVGcolor value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerBoolXMLAttribute(std::string name, std::function<void(T*, bool)> handler)
+    {
+        this->table->boolAttributes[name] = [handler](View* view, bool value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+    void registerFilePathXMLAttribute(std::string name, std::function<void(T*, std::string)> handler)
+    {
+        this->table->filePathAttributes[name] = [handler](View* view, std::string value) { handler(static_cast<T*>(view), value); };
+        this->table->knownAttributes.insert(name);
+    }
+
+  private:
+    XMLAttributeTable* table;
+};
+
 /**
  * Some YG values are NAN if not set, wrecking our
  * calculations if we use them as they are
@@ -270,8 +426,18 @@ class View
     bool detached = false;
     Point detachedOrigin;
 
+    bool layoutPending = false; // queued in the application layout pass
+
     Point translation;
 
+    inline static size_t geometryEpoch = 1;
+    size_t absoluteOriginEpoch         = 0;
+    Point absoluteOrigin; // cached result of getX() / getY()
+
+    void updateAbsoluteOrigin();
+
+    void invalidateFrameInParent();
+
     bool wireframeEnabled = false;
     bool clipsToBounds    = false;
 
@@ -288,18 +454,21 @@ class View
 
     float aspectRatio = 0;
 
-    std::unordered_map<std::string, AutoAttributeHandler> autoAttributes;
-    std::unordered_map<std::string, FloatAttributeHandler> percentageAttributes;
-    std::unordered_map<std::string, FloatAttributeHandler> floatAttributes;
-    std::unordered_map<std::string, StringAttributeHandler> stringAttributes;
-    std::unordered_map<std::string, ColorAttributeHandler> colorAttributes;
-    std::unordered_map<std::string, BoolAttributeHandler> boolAttributes;
-    std::unordered_map<std::string, FilePathAttributeHandler> filePathAttributes;
+    // Attributes of the most derived class that registered some, shared by all its instances
+    const XMLAttributeTable* classAttributes = nullptr;
 
-    std::set<std::string> knownAttributes;
+    // Attributes registered on this instance only, allocated on first use
+    std::unique_ptr<XMLAttributeTable> instanceAttributes;
+
+    XMLAttributeTable* getInstanceXMLAttributes();
+
+    template <typename Handler>
+    const Handler* findXMLAttribute(std::unordered_map<std::string, Handler> XMLAttributeTable::*attributes, const std::string& name);
 
     void registerCommonAttributes();
-    void printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value);
+    bool resolveXMLAttribute(const std::string& name, const std::string& value, XMLAttributeValue* resolved);
+    void applyXMLAttributeValue(const XMLAttributeValue& value);
+    void printXMLAttributeErrorMessage(const std::string& tag, std::string name, std::string value);
 
     unsigned maximumAllowedXMLElements = UINT_MAX;
 
@@ -333,6 +502,14 @@ class View
     int ptrLockCounter = 0;
 
   protected:
+    // Incremented by each layout pass and when a view is added to
+    // or removed from a box, see getLayoutEpoch()
+    inline static size_t layoutEpoch = 1;
+
+    // Incremented when a child is added or removed, or when the frame of
+    // one of them changes outside of a layout pass
+    size_t childrenEpoch = 0;
+
     Animatable collapseState = 1.0f;
 
     bool focused = false;
@@ -393,9 +570,32 @@ class View
     void shakeHighlight(FocusDirection direction);
 
     Rect getFrame();
+
+    /**
+     * Returns the absolute position of the view on screen.
+     *
+     * The absolute position is computed once and cached until the next
+     * layout pass or position change anywhere in the application
+     * (see invalidateGeometry()). Parents are cached the same way, so
+     * resolving every view of a tree costs one lookup per view.
+     */
     float getX();
     float getY();
 
+    /**
+     * Discards the cached absolute positions of every view.
+     * Called before each onLayout(), after each layout pass and when
+     * a translation, a detached position or a parent changes.
+     */
+    static void invalidateGeometry();
+
+    /**
+     * Returns a counter incremented by each layout pass and each time
+     * a view is added to or removed from a box. Frames and views collected
+     * from the tree are outdated once it changes.
+     */
+    static size_t getLayoutEpoch();
+
     Rect getLocalFrame();
     float getLocalX();
     float getLocalY();
@@ -404,14 +604,45 @@ class View
     float getHeight(bool includeCollapse = true);
 
     /**
-    * Triggers a layout of the whole view tree. Must be called
+    * Marks the view tree as needing a layout pass. Must be called
     * after a yoga node property is changed.
     *
+    * The layout itself is deferred: every invalidated tree is laid out
+    * once, right before the next frame is drawn. Use layoutIfNeeded()
+    * when the new geometry is needed immediately.
+    *
     * Only methods that change yoga nodes properties should
     * call this method.
     */
     virtual void invalidate();
 
+    /**
+     * Notifies the application that the view looks different and that
+     * the screen must be drawn again (see Application::setRetainedRendering()).
+     *
+     * Setters changing how a view looks call it, custom views must call it
+     * too when their drawing changes outside of layout, animations and input.
+     */
+    void setNeedsRedraw();
+
+    /**
+     * Runs the pending layout pass of the tree this view belongs to, if any,
+     * so that the geometry getters return up to date values right away.
+     */
+    void layoutIfNeeded();
+
+    /**
+     * Returns the root of the yoga tree this view belongs to: the first
+     * ancestor (or the view itself) that is detached or has no parent.
+     */
+    View* getLayoutRoot();
+
+    /**
+     * Do not call this function, use it internally.
+     * Lays out the tree if this view is the root of a pending layout pass.
+     */
+    void performPendingLayout();
+
     /**
      * Called when a layout pass ends on that view.
      */
@@ -776,6 +1007,7 @@ class View
     inline void setLineColor(NVGcolor color)
     {
         this->lineColor = color;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -787,6 +1019,7 @@ class View
     inline void setLineTop(float thickness)
     {
         this->lineTop = thickness;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -798,6 +1031,7 @@ class View
     inline void setLineRight(float thickness)
     {
         this->lineRight = thickness;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -809,6 +1043,7 @@ class View
     inline void setLineBottom(float thickness)
     {
         this->lineBottom = thickness;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -820,6 +1055,7 @@ class View
     inline void setLineLeft(float thickness)
     {
         this->lineLeft = thickness;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -837,6 +1073,7 @@ class View
     inline void setBorderColor(NVGcolor color)
     {
         this->borderColor = color;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -845,6 +1082,7 @@ class View
     inline void setBorderThickness(float thickness)
     {
         this->borderThickness = thickness;
+        this->setNeedsRedraw();
     }
 
     inline float getBorderThickness()
@@ -859,6 +1097,7 @@ class View
     inline void setCornerRadius(float radius)
     {
         this->cornerRadius = radius;
+        this->setNeedsRedraw();
     }
 
     inline float getCornerRadius()
@@ -873,6 +1112,7 @@ class View
     inline void setShadowType(ShadowType type)
     {
         this->shadowType = type;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -881,6 +1121,7 @@ class View
     inline void setShadowVisibility(bool visible)
     {
         this->showShadow = visible;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -890,6 +1131,7 @@ class View
     inline void setHideHighlightBackground(bool hide)
     {
         this->hideHighlightBackground = hide;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -898,6 +1140,7 @@ class View
     inline void setHideHighlightBorder(bool hide)
     {
         this->hideHighlightBorder = hide;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -906,11 +1149,13 @@ class View
     inline void setHideHighlight(bool hide)
     {
         this->hideHighlight = hide;
+        this->setNeedsRedraw();
     }
 
     inline void setHideClickAnimation(bool hide)
     {
         this->hideClickAnimation = hide;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -920,6 +1165,7 @@ class View
     inline void setHighlightPadding(float padding)
     {
         this->highlightPadding = padding;
+        this->setNeedsRedraw();
     }
 
     /**
@@ -928,6 +1174,7 @@ class View
     inline void setHighlightCornerRadius(float radius)
     {
         this->highlightCornerRadius = radius;
+        this->setNeedsRedraw();
     }
 
     // -----------------------------------------------------------
@@ -986,6 +1233,35 @@ class View
      */
     static View* createFromXMLResource(std::string name);
 
+    /**
+     * Creates a view from the given element of a compiled layout.
+     *
+     * The method handleXMLElement() is executed for each child element.
+     *
+     * The layout must outlive the view, as views can keep elements of
+     * it to create their content later on (see XMLLayout::getXMLElement()).
+     */
+    static View* createFromXMLLayout(XMLLayout* layout, size_t element = 0);
+
+    /**
+     * Returns the compiled layout of the given XML file content, compiled the first time only.
+     * Returns nullptr and sets error if the XML is invalid.
+     */
+    static std::shared_ptr<XMLLayout> getXMLLayout(std::string_view xml, std::string* error);
+
+    /**
+     * Returns the compiled layout of the given XML file, loaded the first time only.
+     * The compiled layout next to the file is used if there is one (see XMLLayout::getCompiledPath()).
+     * Returns nullptr and sets error if the file cannot be loaded.
+     */
+    static std::shared_ptr<XMLLayout> getXMLLayoutFile(const std::string& path, std::string* error);
+
+    /**
+     * Same as getXMLLayoutFile(), with a path relative to the resources folder,
+     * or to the romfs when using libromfs.
+     */
+    static std::shared_ptr<XMLLayout> getXMLLayoutResource(const std::string& path, std::string* error);
+
     /**
      * Handles a child XML element.
      *
@@ -1005,6 +1281,14 @@ class View
      */
     virtual void applyXMLAttributes(tinyxml2::XMLElement* element);
 
+    /**
+     * Applies the attributes of the given element of a compiled layout to the view.
+     *
+     * The values are parsed for the first view of a class only and reused for the next ones,
+     * except for the attributes returned by overridesXMLAttribute().
+     */
+    void applyXMLAttributes(XMLLayout* layout, size_t element);
+
     /**
      * Applies the given attribute to the view.
      *
@@ -1013,6 +1297,45 @@ class View
      */
     virtual bool applyXMLAttribute(std::string name, std::string value);
 
+    /**
+     * Returns true if the given attribute is handled differently by this view
+     * than by the other views of its class: registered on the instance only or
+     * intercepted by an applyXMLAttribute() override.
+     *
+     * Such attributes always go through applyXMLAttribute() when the view is created from a layout,
+     * the others can be applied with the values parsed for another view of the same class.
+     */
+    virtual bool overridesXMLAttribute(const std::string& name);
+
+    /**
+     * Registers the XML attributes of the class T, shared by all of its instances.
+     * To be called in the constructor of T.
+     *
+     * The given function fills the table of T through an XMLAttributes<T>, it is only called
+     * the first time an instance of T is created. The attributes of the parent classes
+     * are still available, the ones registered by T take precedence.
+     *
+     * Prefer this over the register*XMLAttribute() methods below, which store
+     * handlers in every instance of the view.
+     */
+    template <typename T, typename Builder>
+    void registerXMLAttributes(Builder builder)
+    {
+        // One table per call site, so one per class
+        static const XMLAttributeTable table = [this, &builder]()
+        {
+            XMLAttributeTable table;
+            table.parent = this->classAttributes;
+
+            XMLAttributes<T> attributes(&table);
+            builder(attributes);
+
+            return table;
+        }();
+
+        this->classAttributes = &table;
+    }
+
     /**
      * Register a new XML attribute with the given name and handler
      * method. You can have multiple attributes registered with the same
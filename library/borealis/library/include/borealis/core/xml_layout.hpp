@@ -0,0 +1,169 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tinyxml2
+{
+class XMLDocument;
+class XMLElement;
+}
+
+namespace brls
+{
+
+struct XMLLayoutCache;
+
+/**
+ * An XML layout compiled into a flat table of elements, so that
+ * views can be instantiated from it without going through an XML parser.
+ *
+ * Elements are stored in document order: the children of an element
+ * follow it, and its "end" is the index of the first element after its subtree.
+ * Names and values are interned in a table of strings, referenced by index.
+ *
+ * Layouts are compiled from XML at runtime or ahead of time by the brls-xml-compiler
+ * tool (see build_xml_compiler.sh), which writes them in a binary form next to the XML files
+ * with the .bxml extension. View::createFromXMLFile() and View::createFromXMLResource()
+ * load the compiled layout instead of the XML file when there is one.
+ */
+class XMLLayout
+{
+  public:
+    struct Attribute
+    {
+        uint32_t name;
+        uint32_t value;
+    };
+
+    struct Element
+    {
+        uint32_t name;
+        uint32_t firstAttribute;
+        uint32_t attributeCount;
+        uint32_t end;
+    };
+
+    /**
+     * Compiles the given element and its children.
+     */
+    static std::shared_ptr<XMLLayout> compile(const tinyxml2::XMLElement* root);
+
+    /**
+     * Parses and compiles the given XML file content.
+     * Returns nullptr and sets error if the XML is invalid.
+     */
+    static std::shared_ptr<XMLLayout> parse(std::string_view xml, std::string* error);
+
+    /**
+     * Loads the layout at the given path: the compiled layout if the path
+     * ends with .bxml, the XML file otherwise.
+     * Returns nullptr and sets error if the file cannot be loaded.
+     */
+    static std::shared_ptr<XMLLayout> load(const std::string& path, std::string* error);
+
+    /**
+     * Decodes a layout in the binary form, returns nullptr if the data is invalid.
+     */
+    static std::shared_ptr<XMLLayout> decode(std::string_view data);
+
+    /**
+     * Encodes the layout in the binary form.
+     */
+    std::string encode() const;
+
+    /**
+     * Returns the path of the compiled layout of the given XML file, or an empty
+     * string if the path does not have the .xml extension.
+     */
+    static std::string getCompiledPath(const std::string& path);
+
+    size_t getElementsCount() const
+    {
+        return elements.size();
+    }
+
+    const Element& getElement(size_t index) const
+    {
+        return elements[index];
+    }
+
+    const Attribute& getAttribute(size_t index) const
+    {
+        return attributes[index];
+    }
+
+    const std::string& getString(uint32_t index) const
+    {
+        return strings[index];
+    }
+
+    /**
+     * Returns the value of the given attribute of an element, or nullptr if it does not have it.
+     */
+    const std::string* findAttribute(size_t element, const std::string& name) const;
+
+    /**
+     * Returns the given element as a tinyxml2 element, for the views handling
+     * their children with View::handleXMLElement(). The document is built once, the first
+     * time an element is asked, and kept as long as the layout.
+     *
+     * View::createFromXMLElement() recognizes these elements and instantiates them from the layout.
+     */
+    tinyxml2::XMLElement* getXMLElement(size_t index);
+
+    /**
+     * Returns the layout and the index of an element returned by getXMLElement(), or nullptr
+     * if the element does not come from a layout.
+     */
+    static XMLLayout* fromXMLElement(const tinyxml2::XMLElement* element, size_t* index);
+
+    /**
+     * Returns the data resolved by the views created from the layout, allocated on first use
+     * and kept as long as the layout (see View::createFromXMLLayout()).
+     */
+    XMLLayoutCache* getCache();
+
+  private:
+    std::vector<std::string> strings;
+    std::vector<Element> elements;
+    std::vector<Attribute> attributes;
+
+    // View creators and attribute values resolved by the views created from the layout
+    std::shared_ptr<XMLLayoutCache> cache;
+
+    struct XMLElementSource
+    {
+        XMLLayout* layout;
+        size_t index;
+    };
+
+    std::shared_ptr<tinyxml2::XMLDocument> document;
+    std::vector<tinyxml2::XMLElement*> documentElements;
+    std::vector<XMLElementSource> documentSources;
+
+    uint32_t intern(const char* string, std::unordered_map<std::string, uint32_t>& indices);
+    void compileElement(const tinyxml2::XMLElement* element, std::unordered_map<std::string, uint32_t>& indices);
+};
+
+} // namespace brls
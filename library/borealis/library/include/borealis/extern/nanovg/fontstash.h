@@ -70,6 +70,7 @@ struct FONSquad
 {
 	float x0,y0,s0,t0;
 	float x1,y1,s1,t1;
+	short page, shelf;	// Location of the glyph in the atlas.
 };
 typedef struct FONSquad FONSquad;
 
@@ -114,6 +115,22 @@ void fonsDeleteInternal(FONScontext* s);
 void fonsSetErrorCallback(FONScontext* s, void (*callback)(void* uptr, int error, int val), void* uptr);
 // Returns current atlas size.
 void fonsGetAtlasSize(FONScontext* s, int* width, int* height);
+
+// Adds a page to the atlas, when it is full. Each page is a texture of its own.
+// Returns the index of the new page, or -1 if there are already FONS_MAX_PAGES pages.
+int fonsAddPage(FONScontext* s, int width, int height);
+int fonsGetPageCount(FONScontext* s);
+
+// Starts a new frame. When the atlas is full, glyphs not drawn since the beginning
+// of the frame are evicted, a shelf at a time, starting from the least recently used.
+void fonsNextFrame(FONScontext* s);
+
+// Marks a shelf as drawn in the current frame, for quads kept across frames.
+void fonsTouchShelf(FONScontext* s, int page, int shelf);
+
+// Returns a counter incremented every time glyphs are removed from the atlas.
+int fonsGetAtlasGeneration(FONScontext* s);
+
 // Expands the atlas size.
 int fonsExpandAtlas(FONScontext* s, int width, int height);
 // Resets the whole stash.
@@ -153,6 +170,8 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, struct FONSquad* qu
 // Pull texture changes
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height);
 int fonsValidateTexture(FONScontext* s, int* dirty);
+const unsigned char* fonsGetPageData(FONScontext* stash, int page, int* width, int* height);
+int fonsValidatePage(FONScontext* s, int page, int* dirty);
 
 // Draws the stash texture for debugging
 void fonsDrawDebug(FONScontext* s, float x, float y);
@@ -317,8 +336,11 @@ typedef struct FONSttFontImpl FONSttFontImpl;
 #ifndef FONS_INIT_GLYPHS
 #	define FONS_INIT_GLYPHS 256
 #endif
-#ifndef FONS_INIT_ATLAS_NODES
-#	define FONS_INIT_ATLAS_NODES 256
+#ifndef FONS_INIT_ATLAS_SHELVES
+#	define FONS_INIT_ATLAS_SHELVES 32
+#endif
+#ifndef FONS_MAX_PAGES
+#	define FONS_MAX_PAGES 4
 #endif
 #ifndef FONS_VERTEX_COUNT
 #	define FONS_VERTEX_COUNT 1024
@@ -359,6 +381,7 @@ struct FONSglyph
 	short size, blur, dilate;
 	short x0,y0,x1,y1;
 	short xadv,xoff,yoff;
+	short page, shelf;
 };
 typedef struct FONSglyph FONSglyph;
 
@@ -397,28 +420,35 @@ struct FONSstate
 };
 typedef struct FONSstate FONSstate;
 
-struct FONSatlasNode {
-	short x, y, width;
+struct FONSshelf {
+	short y, height;
+	short x;		// Start of the free space of the shelf.
+	int lastUsed;	// Last frame the shelf was drawn from.
 };
-typedef struct FONSatlasNode FONSatlasNode;
+typedef struct FONSshelf FONSshelf;
 
+// Page of the atlas
 struct FONSatlas
 {
 	int width, height;
-	FONSatlasNode* nodes;
-	int nnodes;
-	int cnodes;
+	float itw,ith;
+	unsigned char* texData;
+	int dirtyRect[4];
+	FONSshelf* shelves;
+	int nshelves;
+	int cshelves;
+	int bottom;		// Start of the space left for new shelves.
 };
 typedef struct FONSatlas FONSatlas;
 
 struct FONScontext
 {
 	FONSparams params;
-	float itw,ith;
-	unsigned char* texData;
-	int dirtyRect[4];
 	FONSfont** fonts;
-	FONSatlas* atlas;
+	FONSatlas* pages[FONS_MAX_PAGES];
+	int npages;
+	int frame;
+	int generation;
 	int cfonts;
 	int nfonts;
 	float verts[FONS_VERTEX_COUNT*2];
@@ -681,16 +711,34 @@ static unsigned int fons__decutf8(unsigned int* state, unsigned int* codep, unsi
 	return *state;
 }
 
-// Atlas based on Skyline Bin Packer by Jukka Jylänki
+// Atlas made of pages of shelves: glyphs of similar heights are packed in rows,
+// which are emptied when the pages are full to make room for new glyphs.
 
 static void fons__deleteAtlas(FONSatlas* atlas)
 {
 	if (atlas == NULL) return;
-	if (atlas->nodes != NULL) free(atlas->nodes);
+	if (atlas->shelves != NULL) free(atlas->shelves);
+	if (atlas->texData != NULL) free(atlas->texData);
 	free(atlas);
 }
 
-static FONSatlas* fons__allocAtlas(int w, int h, int nnodes)
+static void fons__atlasResetDirty(FONSatlas* atlas)
+{
+	atlas->dirtyRect[0] = atlas->width;
+	atlas->dirtyRect[1] = atlas->height;
+	atlas->dirtyRect[2] = 0;
+	atlas->dirtyRect[3] = 0;
+}
+
+static void fons__atlasAddDirty(FONSatlas* atlas, int x0, int y0, int x1, int y1)
+{
+	atlas->dirtyRect[0] = fons__mini(atlas->dirtyRect[0], x0);
+	atlas->dirtyRect[1] = fons__mini(atlas->dirtyRect[1], y0);
+	atlas->dirtyRect[2] = fons__maxi(atlas->dirtyRect[2], x1);
+	atlas->dirtyRect[3] = fons__maxi(atlas->dirtyRect[3], y1);
+}
+
+static FONSatlas* fons__allocAtlas(int w, int h, int nshelves)
 {
 	FONSatlas* atlas = NULL;
 
@@ -701,19 +749,21 @@ static FONSatlas* fons__allocAtlas(int w, int h, int nnodes)
 
 	atlas->width = w;
 	atlas->height = h;
+	atlas->itw = 1.0f/w;
+	atlas->ith = 1.0f/h;
 
-	// Allocate space for skyline nodes
-	atlas->nodes = (FONSatlasNode*)malloc(sizeof(FONSatlasNode) * nnodes);
-	if (atlas->nodes == NULL) goto error;
-	memset(atlas->nodes, 0, sizeof(FONSatlasNode) * nnodes);
-	atlas->nnodes = 0;
-	atlas->cnodes = nnodes;
-
-	// Init root node.
-	atlas->nodes[0].x = 0;
-	atlas->nodes[0].y = 0;
-	atlas->nodes[0].width = (short)w;
-	atlas->nnodes++;
+	// Create texture for the cache.
+	atlas->texData = (unsigned char*)malloc(w * h);
+	if (atlas->texData == NULL) goto error;
+	memset(atlas->texData, 0, w * h);
+	fons__atlasResetDirty(atlas);
+
+	// Allocate space for shelves
+	atlas->shelves = (FONSshelf*)malloc(sizeof(FONSshelf) * nshelves);
+	if (atlas->shelves == NULL) goto error;
+	atlas->nshelves = 0;
+	atlas->cshelves = nshelves;
+	atlas->bottom = 0;
 
 	return atlas;
 
@@ -722,166 +772,176 @@ error:
 	return NULL;
 }
 
-static int fons__atlasInsertNode(FONSatlas* atlas, int idx, int x, int y, int w)
-{
-	int i;
-	// Insert node
-	if (atlas->nnodes+1 > atlas->cnodes) {
-		atlas->cnodes = atlas->cnodes == 0 ? 8 : atlas->cnodes * 2;
-		atlas->nodes = (FONSatlasNode*)realloc(atlas->nodes, sizeof(FONSatlasNode) * atlas->cnodes);
-		if (atlas->nodes == NULL)
-			return 0;
-	}
-	for (i = atlas->nnodes; i > idx; i--)
-		atlas->nodes[i] = atlas->nodes[i-1];
-	atlas->nodes[idx].x = (short)x;
-	atlas->nodes[idx].y = (short)y;
-	atlas->nodes[idx].width = (short)w;
-	atlas->nnodes++;
-
-	return 1;
-}
-
-static void fons__atlasRemoveNode(FONSatlas* atlas, int idx)
-{
-	int i;
-	if (atlas->nnodes == 0) return;
-	for (i = idx; i < atlas->nnodes-1; i++)
-		atlas->nodes[i] = atlas->nodes[i+1];
-	atlas->nnodes--;
-}
-
 static void fons__atlasExpand(FONSatlas* atlas, int w, int h)
 {
-	// Insert node for empty space
-	if (w > atlas->width)
-		fons__atlasInsertNode(atlas, atlas->nnodes, atlas->width, 0, w - atlas->width);
+	// The shelves extend to the new width
 	atlas->width = w;
 	atlas->height = h;
+	atlas->itw = 1.0f/w;
+	atlas->ith = 1.0f/h;
 }
 
 static void fons__atlasReset(FONSatlas* atlas, int w, int h)
 {
 	atlas->width = w;
 	atlas->height = h;
-	atlas->nnodes = 0;
-
-	// Init root node.
-	atlas->nodes[0].x = 0;
-	atlas->nodes[0].y = 0;
-	atlas->nodes[0].width = (short)w;
-	atlas->nnodes++;
+	atlas->itw = 1.0f/w;
+	atlas->ith = 1.0f/h;
+	atlas->nshelves = 0;
+	atlas->bottom = 0;
 }
 
-static int fons__atlasAddSkylineLevel(FONSatlas* atlas, int idx, int x, int y, int w, int h)
+static int fons__atlasAddShelf(FONSatlas* atlas, int h)
 {
-	int i;
-
-	// Insert new node
-	if (fons__atlasInsertNode(atlas, idx, x, y+h, w) == 0)
-		return 0;
+	FONSshelf* shelf;
+	if (atlas->bottom + h > atlas->height)
+		return -1;
+	if (atlas->nshelves+1 > atlas->cshelves) {
+		atlas->cshelves = atlas->cshelves == 0 ? 8 : atlas->cshelves * 2;
+		atlas->shelves = (FONSshelf*)realloc(atlas->shelves, sizeof(FONSshelf) * atlas->cshelves);
+		if (atlas->shelves == NULL)
+			return -1;
+	}
+	shelf = &atlas->shelves[atlas->nshelves];
+	shelf->y = (short)atlas->bottom;
+	shelf->height = (short)h;
+	shelf->x = 0;
+	shelf->lastUsed = 0;
+	atlas->bottom += h;
+	return atlas->nshelves++;
+}
 
-	// Delete skyline segments that fall under the shadow of the new segment.
-	for (i = idx+1; i < atlas->nnodes; i++) {
-		if (atlas->nodes[i].x < atlas->nodes[i-1].x + atlas->nodes[i-1].width) {
-			int shrink = atlas->nodes[i-1].x + atlas->nodes[i-1].width - atlas->nodes[i].x;
-			atlas->nodes[i].x += (short)shrink;
-			atlas->nodes[i].width -= (short)shrink;
-			if (atlas->nodes[i].width <= 0) {
-				fons__atlasRemoveNode(atlas, i);
-				i--;
-			} else {
-				break;
+static int fons__atlasAddRect(FONScontext* stash, int rw, int rh, int* rpage, int* rshelf, int* rx, int* ry)
+{
+	// Shelves are a bit taller than their first glyph, to fit glyphs of the same size
+	int sh = (rh + 7) & ~7;
+	int besti = -1, bestj = -1, besth = 0;
+	int i, j;
+	FONSshelf* shelf;
+
+	// Shelf wasting the least height.
+	for (i = 0; i < stash->npages; i++) {
+		FONSatlas* atlas = stash->pages[i];
+		for (j = 0; j < atlas->nshelves; j++) {
+			shelf = &atlas->shelves[j];
+			if (shelf->height < rh || shelf->height > sh + 4 || shelf->x + rw > atlas->width)
+				continue;
+			if (besti == -1 || shelf->height < besth) {
+				besti = i;
+				bestj = j;
+				besth = shelf->height;
 			}
-		} else {
-			break;
 		}
 	}
 
-	// Merge same height skyline segments that are next to each other.
-	for (i = 0; i < atlas->nnodes-1; i++) {
-		if (atlas->nodes[i].y == atlas->nodes[i+1].y) {
-			atlas->nodes[i].width += atlas->nodes[i+1].width;
-			fons__atlasRemoveNode(atlas, i+1);
-			i--;
+	// Or a new shelf.
+	for (i = 0; besti == -1 && i < stash->npages; i++) {
+		FONSatlas* atlas = stash->pages[i];
+		if (rw > atlas->width)
+			continue;
+		j = fons__atlasAddShelf(atlas, sh);
+		if (j == -1)
+			j = fons__atlasAddShelf(atlas, rh);
+		if (j != -1) {
+			besti = i;
+			bestj = j;
 		}
 	}
 
-	return 1;
-}
+	if (besti == -1)
+		return 0;
 
-static int fons__atlasRectFits(FONSatlas* atlas, int i, int w, int h)
-{
-	// Checks if there is enough space at the location of skyline span 'i',
-	// and return the max height of all skyline spans under that at that location,
-	// (think tetris block being dropped at that position). Or -1 if no space found.
-	int x = atlas->nodes[i].x;
-	int y = atlas->nodes[i].y;
-	int spaceLeft;
-	if (x + w > atlas->width)
-		return -1;
-	spaceLeft = w;
-	while (spaceLeft > 0) {
-		if (i == atlas->nnodes) return -1;
-		y = fons__maxi(y, atlas->nodes[i].y);
-		if (y + h > atlas->height) return -1;
-		spaceLeft -= atlas->nodes[i].width;
-		++i;
-	}
-	return y;
+	shelf = &stash->pages[besti]->shelves[bestj];
+	*rpage = besti;
+	*rshelf = bestj;
+	*rx = shelf->x;
+	*ry = shelf->y;
+	shelf->x += (short)rw;
+
+	return 1;
 }
 
-static int fons__atlasAddRect(FONSatlas* atlas, int rw, int rh, int* rx, int* ry)
+static int fons__atlasEvictShelf(FONScontext* stash, int rw, int rh, int* rpage, int* rshelf, int* rx, int* ry)
 {
-	int besth = atlas->height, bestw = atlas->width, besti = -1;
-	int bestx = -1, besty = -1, i;
+	int sh = (rh + 7) & ~7;
+	int besti = -1, bestj = -1, bestFits = 0;
+	int i, j;
+	FONSshelf* best = NULL;
+	FONSatlas* atlas;
 
-	// Bottom left fit heuristic.
-	for (i = 0; i < atlas->nnodes; i++) {
-		int y = fons__atlasRectFits(atlas, i, rw, rh);
-		if (y != -1) {
-			if (y + rh < besth || (y + rh == besth && atlas->nodes[i].width < bestw)) {
+	// Least recently used shelf large enough, that was not drawn from in this frame:
+	// the texture is only updated at the end of the frame. Between shelves as old, the
+	// ones of the height of the glyph come first, the others are kept for larger glyphs.
+	for (i = 0; i < stash->npages; i++) {
+		atlas = stash->pages[i];
+		if (rw > atlas->width)
+			continue;
+		for (j = 0; j < atlas->nshelves; j++) {
+			FONSshelf* shelf = &atlas->shelves[j];
+			int fits = shelf->height <= sh + 4;
+			if (shelf->height < rh || shelf->lastUsed >= stash->frame)
+				continue;
+			if (best == NULL || shelf->lastUsed < best->lastUsed
+				|| (shelf->lastUsed == best->lastUsed && fits > bestFits)
+				|| (shelf->lastUsed == best->lastUsed && fits == bestFits && shelf->height < best->height)) {
 				besti = i;
-				bestw = atlas->nodes[i].width;
-				besth = y + rh;
-				bestx = atlas->nodes[i].x;
-				besty = y;
+				bestj = j;
+				bestFits = fits;
+				best = shelf;
 			}
 		}
 	}
 
-	if (besti == -1)
+	if (best == NULL)
 		return 0;
 
-	// Perform the actual packing.
-	if (fons__atlasAddSkylineLevel(atlas, besti, bestx, besty, rw, rh) == 0)
-		return 0;
+	// Its glyphs are rasterized again when drawn.
+	for (i = 0; i < stash->nfonts; i++) {
+		FONSfont* font = stash->fonts[i];
+		for (j = 0; j < font->nglyphs; j++) {
+			FONSglyph* glyph = &font->glyphs[j];
+			if (glyph->page == besti && glyph->shelf == bestj) {
+				// Keep the size of the glyph, it is still measured without bitmap
+				glyph->x1 = (short)(glyph->x1 - glyph->x0 - 1);
+				glyph->y1 = (short)(glyph->y1 - glyph->y0 - 1);
+				glyph->x0 = glyph->y0 = -1;
+				glyph->page = glyph->shelf = -1;
+			}
+		}
+	}
+
+	atlas = stash->pages[besti];
+	memset(&atlas->texData[best->y * atlas->width], 0, best->height * atlas->width);
+	fons__atlasAddDirty(atlas, 0, best->y, atlas->width, best->y + best->height);
+	stash->generation++;
 
-	*rx = bestx;
-	*ry = besty;
+	*rpage = besti;
+	*rshelf = bestj;
+	*rx = 0;
+	*ry = best->y;
+	best->x = (short)rw;
 
 	return 1;
 }
 
 static void fons__addWhiteRect(FONScontext* stash, int w, int h)
 {
-	int x, y, gx, gy;
+	int x, y, gx, gy, gpage, gshelf;
 	unsigned char* dst;
-	if (fons__atlasAddRect(stash->atlas, w, h, &gx, &gy) == 0)
+	FONSatlas* atlas;
+	if (fons__atlasAddRect(stash, w, h, &gpage, &gshelf, &gx, &gy) == 0)
 		return;
 
 	// Rasterize
-	dst = &stash->texData[gx + gy * stash->params.width];
+	atlas = stash->pages[gpage];
+	dst = &atlas->texData[gx + gy * atlas->width];
 	for (y = 0; y < h; y++) {
 		for (x = 0; x < w; x++)
 			dst[x] = 0xff;
-		dst += stash->params.width;
+		dst += atlas->width;
 	}
 
-	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], gx);
-	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], gy);
-	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], gx+w);
-	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], gy+h);
+	fons__atlasAddDirty(atlas, gx, gy, gx+w, gy+h);
 }
 
 FONScontext* fonsCreateInternal(FONSparams* params)
@@ -907,8 +967,9 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 			goto error;
 	}
 
-	stash->atlas = fons__allocAtlas(stash->params.width, stash->params.height, FONS_INIT_ATLAS_NODES);
-	if (stash->atlas == NULL) goto error;
+	stash->pages[0] = fons__allocAtlas(stash->params.width, stash->params.height, FONS_INIT_ATLAS_SHELVES);
+	if (stash->pages[0] == NULL) goto error;
+	stash->npages = 1;
 
 	// Allocate space for fonts.
 	stash->fonts = (FONSfont**)malloc(sizeof(FONSfont*) * FONS_INIT_FONTS);
@@ -917,18 +978,6 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 	stash->cfonts = FONS_INIT_FONTS;
 	stash->nfonts = 0;
 
-	// Create texture for the cache.
-	stash->itw = 1.0f/stash->params.width;
-	stash->ith = 1.0f/stash->params.height;
-	stash->texData = (unsigned char*)malloc(stash->params.width * stash->params.height);
-	if (stash->texData == NULL) goto error;
-	memset(stash->texData, 0, stash->params.width * stash->params.height);
-
-	stash->dirtyRect[0] = stash->params.width;
-	stash->dirtyRect[1] = stash->params.height;
-	stash->dirtyRect[2] = 0;
-	stash->dirtyRect[3] = 0;
-
 	// Add white rect at 0,0 for debug drawing.
 	fons__addWhiteRect(stash, 2,2);
 
@@ -1463,7 +1512,7 @@ static void fons__dilate(FONScontext* stash, unsigned char* dst, int w, int h, i
 static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned int codepoint,
 								 short isize, short iblur, short idilate, int bitmapOption)
 {
-	int i, g, advance, lsb, x0, y0, x1, y1, gw, gh, gx, gy, x, y;
+	int i, g, advance, lsb, x0, y0, x1, y1, gw, gh, gx, gy, gpage, gshelf, x, y;
 	float scale;
 	FONSglyph* glyph = NULL;
 	unsigned int h;
@@ -1472,6 +1521,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	unsigned char* bdst;
 	unsigned char* dst;
 	FONSfont* renderFont = font;
+	FONSatlas* atlas = NULL;
 
 	if (isize < 2) return NULL;
 	if (iblur > 20) iblur = 20;
@@ -1491,7 +1541,12 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 			&& font->glyphs[i].dilate == idilate
 		) {
 			glyph = &font->glyphs[i];
-			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL || (glyph->x0 >= 0 && glyph->y0 >= 0)) {
+			if (glyph->x0 >= 0 && glyph->y0 >= 0) {
+				if (bitmapOption == FONS_GLYPH_BITMAP_REQUIRED)
+					stash->pages[glyph->page]->shelves[glyph->shelf].lastUsed = stash->frame;
+				return glyph;
+			}
+			if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
 			  return glyph;
 			}
 			// At this point, glyph exists but the bitmap data is not yet created.
@@ -1524,17 +1579,24 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	// Determines the spot to draw glyph in the atlas.
 	if (bitmapOption == FONS_GLYPH_BITMAP_REQUIRED) {
 		// Find free spot for the rect in the atlas
-		added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
+		added = fons__atlasAddRect(stash, gw, gh, &gpage, &gshelf, &gx, &gy);
 		if (added == 0 && stash->handleError != NULL) {
-			// Atlas is full, let the user to resize the atlas (or not), and try again.
+			// Atlas is full, let the user to add a page (or not), and try again.
 			stash->handleError(stash->errorUptr, FONS_ATLAS_FULL, 0);
-			added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
+			added = fons__atlasAddRect(stash, gw, gh, &gpage, &gshelf, &gx, &gy);
 		}
+		// Still full, make room by evicting glyphs.
+		if (added == 0)
+			added = fons__atlasEvictShelf(stash, gw, gh, &gpage, &gshelf, &gx, &gy);
 		if (added == 0) return NULL;
+		atlas = stash->pages[gpage];
+		atlas->shelves[gshelf].lastUsed = stash->frame;
 	} else {
 		// Negative coordinate indicates there is no bitmap data created.
 		gx = -1;
 		gy = -1;
+		gpage = -1;
+		gshelf = -1;
 	}
 
 	// Init glyph.
@@ -1558,54 +1620,53 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	glyph->xadv = (short)(scale * advance * 10.0f);
 	glyph->xoff = (short)(x0 - pad);
 	glyph->yoff = (short)(y0 - pad);
+	glyph->page = (short)gpage;
+	glyph->shelf = (short)gshelf;
 
 	if (bitmapOption == FONS_GLYPH_BITMAP_OPTIONAL) {
 		return glyph;
 	}
 
 	// Rasterize
-	dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
-	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
+	dst = &atlas->texData[(glyph->x0+pad) + (glyph->y0+pad) * atlas->width];
+	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, atlas->width, scale, scale, g);
 
 	// Make sure there is one pixel empty border.
-	dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+	dst = &atlas->texData[glyph->x0 + glyph->y0 * atlas->width];
 	for (y = 0; y < gh; y++) {
-		dst[y*stash->params.width] = 0;
-		dst[gw-1 + y*stash->params.width] = 0;
+		dst[y*atlas->width] = 0;
+		dst[gw-1 + y*atlas->width] = 0;
 	}
 	for (x = 0; x < gw; x++) {
 		dst[x] = 0;
-		dst[x + (gh-1)*stash->params.width] = 0;
+		dst[x + (gh-1)*atlas->width] = 0;
 	}
 
 	// Debug code to color the glyph background
-/*	unsigned char* fdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+/*	unsigned char* fdst = &atlas->texData[glyph->x0 + glyph->y0 * atlas->width];
 	for (y = 0; y < gh; y++) {
 		for (x = 0; x < gw; x++) {
-			int a = (int)fdst[x+y*stash->params.width] + 20;
+			int a = (int)fdst[x+y*atlas->width] + 20;
 			if (a > 255) a = 255;
-			fdst[x+y*stash->params.width] = a;
+			fdst[x+y*atlas->width] = a;
 		}
 	}*/
 
 	// Dilate
 	if (idilate > 0) {
 		stash->nscratch = 0;
-		bdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
-		fons__dilate(stash, bdst, gw, gh, stash->params.width, idilate);
+		bdst = &atlas->texData[glyph->x0 + glyph->y0 * atlas->width];
+		fons__dilate(stash, bdst, gw, gh, atlas->width, idilate);
 	}
 
 	// Blur
 	if (iblur > 0) {
 		stash->nscratch = 0;
-		bdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
-		fons__blur(stash, bdst, gw, gh, stash->params.width, iblur);
+		bdst = &atlas->texData[glyph->x0 + glyph->y0 * atlas->width];
+		fons__blur(stash, bdst, gw, gh, atlas->width, iblur);
 	}
 
-	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
-	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
-	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
-	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], glyph->y1);
+	fons__atlasAddDirty(atlas, glyph->x0, glyph->y0, glyph->x1, glyph->y1);
 
 	return glyph;
 }
@@ -1615,6 +1676,7 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 						   float scale, float spacing, float* x, float* y, FONSquad* q)
 {
 	float rx,ry,xoff,yoff,x0,y0,x1,y1;
+	float itw = 0, ith = 0;
 
 	if (prevGlyphIndex != -1) {
 		float adv = fons__tt_getGlyphKernAdvance(&font->font, prevGlyphIndex, glyph->index) * scale;
@@ -1631,6 +1693,14 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 	x1 = (float)(glyph->x1-1);
 	y1 = (float)(glyph->y1-1);
 
+	// Glyphs without bitmap have no texture coordinates.
+	if (glyph->page >= 0) {
+		itw = stash->pages[glyph->page]->itw;
+		ith = stash->pages[glyph->page]->ith;
+	}
+	q->page = glyph->page;
+	q->shelf = glyph->shelf;
+
 	if (stash->params.flags & FONS_ZERO_TOPLEFT) {
 		rx = floorf(*x + xoff);
 		ry = floorf(*y + yoff);
@@ -1640,10 +1710,10 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 		q->x1 = rx + x1 - x0;
 		q->y1 = ry + y1 - y0;
 
-		q->s0 = x0 * stash->itw;
-		q->t0 = y0 * stash->ith;
-		q->s1 = x1 * stash->itw;
-		q->t1 = y1 * stash->ith;
+		q->s0 = x0 * itw;
+		q->t0 = y0 * ith;
+		q->s1 = x1 * itw;
+		q->t1 = y1 * ith;
 	} else {
 		rx = floorf(*x + xoff);
 		ry = floorf(*y - yoff);
@@ -1653,10 +1723,10 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 		q->x1 = rx + x1 - x0;
 		q->y1 = ry - y1 + y0;
 
-		q->s0 = x0 * stash->itw;
-		q->t0 = y0 * stash->ith;
-		q->s1 = x1 * stash->itw;
-		q->t1 = y1 * stash->ith;
+		q->s0 = x0 * itw;
+		q->t0 = y0 * ith;
+		q->s1 = x1 * itw;
+		q->t1 = y1 * ith;
 	}
 
 	*x += (int)(glyph->xadv / 10.0f + 0.5f);
@@ -1664,15 +1734,13 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 
 static void fons__flush(FONScontext* stash)
 {
-	// Flush texture
-	if (stash->dirtyRect[0] < stash->dirtyRect[2] && stash->dirtyRect[1] < stash->dirtyRect[3]) {
+	// Flush texture, the render callbacks only know about the first page
+	FONSatlas* atlas = stash->pages[0];
+	if (atlas->dirtyRect[0] < atlas->dirtyRect[2] && atlas->dirtyRect[1] < atlas->dirtyRect[3]) {
 		if (stash->params.renderUpdate != NULL)
-			stash->params.renderUpdate(stash->params.userPtr, stash->dirtyRect, stash->texData);
+			stash->params.renderUpdate(stash->params.userPtr, atlas->dirtyRect, atlas->texData);
 		// Reset dirty rect
-		stash->dirtyRect[0] = stash->params.width;
-		stash->dirtyRect[1] = stash->params.height;
-		stash->dirtyRect[2] = 0;
-		stash->dirtyRect[3] = 0;
+		fons__atlasResetDirty(atlas);
 	}
 
 	// Flush triangles
@@ -1889,19 +1957,20 @@ void fonsDrawDebug(FONScontext* stash, float x, float y)
 	fons__vertex(stash, x+w, y+h, 1, 1, 0xffffffff);
 
 	// Drawbug draw atlas
-	for (i = 0; i < stash->atlas->nnodes; i++) {
-		FONSatlasNode* n = &stash->atlas->nodes[i];
+	for (i = 0; i < stash->pages[0]->nshelves; i++) {
+		FONSshelf* n = &stash->pages[0]->shelves[i];
+		int ny = n->y + n->height;
 
 		if (stash->nverts+6 > FONS_VERTEX_COUNT)
 			fons__flush(stash);
 
-		fons__vertex(stash, x+n->x+0, y+n->y+0, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+1, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+0, y+ny+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+n->x, y+ny+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+n->x, y+ny+0, u, v, 0xc00000ff);
 
-		fons__vertex(stash, x+n->x+0, y+n->y+0, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+0, y+n->y+1, u, v, 0xc00000ff);
-		fons__vertex(stash, x+n->x+n->width, y+n->y+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+0, y+ny+0, u, v, 0xc00000ff);
+		fons__vertex(stash, x+0, y+ny+1, u, v, 0xc00000ff);
+		fons__vertex(stash, x+n->x, y+ny+1, u, v, 0xc00000ff);
 	}
 
 	fons__flush(stash);
@@ -2031,25 +2100,34 @@ void fonsLineBounds(FONScontext* stash, float y, float* miny, float* maxy)
 
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height)
 {
+	return fonsGetPageData(stash, 0, width, height);
+}
+
+int fonsValidateTexture(FONScontext* stash, int* dirty)
+{
+	return fonsValidatePage(stash, 0, dirty);
+}
+
+const unsigned char* fonsGetPageData(FONScontext* stash, int page, int* width, int* height)
+{
+	FONSatlas* atlas = stash->pages[page];
 	if (width != NULL)
-		*width = stash->params.width;
+		*width = atlas->width;
 	if (height != NULL)
-		*height = stash->params.height;
-	return stash->texData;
+		*height = atlas->height;
+	return atlas->texData;
 }
 
-int fonsValidateTexture(FONScontext* stash, int* dirty)
+int fonsValidatePage(FONScontext* stash, int page, int* dirty)
 {
-	if (stash->dirtyRect[0] < stash->dirtyRect[2] && stash->dirtyRect[1] < stash->dirtyRect[3]) {
-		dirty[0] = stash->dirtyRect[0];
-		dirty[1] = stash->dirtyRect[1];
-		dirty[2] = stash->dirtyRect[2];
-		dirty[3] = stash->dirtyRect[3];
+	FONSatlas* atlas = stash->pages[page];
+	if (atlas->dirtyRect[0] < atlas->dirtyRect[2] && atlas->dirtyRect[1] < atlas->dirtyRect[3]) {
+		dirty[0] = atlas->dirtyRect[0];
+		dirty[1] = atlas->dirtyRect[1];
+		dirty[2] = atlas->dirtyRect[2];
+		dirty[3] = atlas->dirtyRect[3];
 		// Reset dirty rect
-		stash->dirtyRect[0] = stash->params.width;
-		stash->dirtyRect[1] = stash->params.height;
-		stash->dirtyRect[2] = 0;
-		stash->dirtyRect[3] = 0;
+		fons__atlasResetDirty(atlas);
 		return 1;
 	}
 	return 0;
@@ -2066,9 +2144,9 @@ void fonsDeleteInternal(FONScontext* stash)
 	for (i = 0; i < stash->nfonts; ++i)
 		fons__freeFont(stash->fonts[i]);
 
-	if (stash->atlas) fons__deleteAtlas(stash->atlas);
+	for (i = 0; i < stash->npages; ++i)
+		fons__deleteAtlas(stash->pages[i]);
 	if (stash->fonts) free(stash->fonts);
-	if (stash->texData) free(stash->texData);
 	if (stash->scratch) free(stash->scratch);
 	fons__tt_done(stash);
 	free(stash);
@@ -2088,16 +2166,51 @@ void fonsGetAtlasSize(FONScontext* stash, int* width, int* height)
 	*height = stash->params.height;
 }
 
+int fonsAddPage(FONScontext* stash, int width, int height)
+{
+	FONSatlas* atlas;
+	if (stash == NULL || stash->npages >= FONS_MAX_PAGES) return -1;
+
+	atlas = fons__allocAtlas(width, height, FONS_INIT_ATLAS_SHELVES);
+	if (atlas == NULL) return -1;
+
+	stash->pages[stash->npages] = atlas;
+	return stash->npages++;
+}
+
+int fonsGetPageCount(FONScontext* stash)
+{
+	return stash->npages;
+}
+
+void fonsNextFrame(FONScontext* stash)
+{
+	stash->frame++;
+}
+
+void fonsTouchShelf(FONScontext* stash, int page, int shelf)
+{
+	stash->pages[page]->shelves[shelf].lastUsed = stash->frame;
+}
+
+int fonsGetAtlasGeneration(FONScontext* stash)
+{
+	return stash->generation;
+}
+
 int fonsExpandAtlas(FONScontext* stash, int width, int height)
 {
-	int i, maxy = 0;
+	int i;
 	unsigned char* data = NULL;
+	FONSatlas* atlas;
 	if (stash == NULL) return 0;
 
-	width = fons__maxi(width, stash->params.width);
-	height = fons__maxi(height, stash->params.height);
+	// Only the first page can be expanded
+	atlas = stash->pages[0];
+	width = fons__maxi(width, atlas->width);
+	height = fons__maxi(height, atlas->height);
 
-	if (width == stash->params.width && height == stash->params.height)
+	if (width == atlas->width && height == atlas->height)
 		return 1;
 
 	// Flush pending glyphs.
@@ -2112,34 +2225,31 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 	data = (unsigned char*)malloc(width * height);
 	if (data == NULL)
 		return 0;
-	for (i = 0; i < stash->params.height; i++) {
+	for (i = 0; i < atlas->height; i++) {
 		unsigned char* dst = &data[i*width];
-		unsigned char* src = &stash->texData[i*stash->params.width];
-		memcpy(dst, src, stash->params.width);
-		if (width > stash->params.width)
-			memset(dst+stash->params.width, 0, width - stash->params.width);
+		unsigned char* src = &atlas->texData[i*atlas->width];
+		memcpy(dst, src, atlas->width);
+		if (width > atlas->width)
+			memset(dst+atlas->width, 0, width - atlas->width);
 	}
-	if (height > stash->params.height)
-		memset(&data[stash->params.height * width], 0, (height - stash->params.height) * width);
-
-	free(stash->texData);
-	stash->texData = data;
+	if (height > atlas->height)
+		memset(&data[atlas->height * width], 0, (height - atlas->height) * width);
 
-	// Increase atlas size
-	fons__atlasExpand(stash->atlas, width, height);
+	free(atlas->texData);
+	atlas->texData = data;
 
 	// Add existing data as dirty.
-	for (i = 0; i < stash->atlas->nnodes; i++)
-		maxy = fons__maxi(maxy, stash->atlas->nodes[i].y);
-	stash->dirtyRect[0] = 0;
-	stash->dirtyRect[1] = 0;
-	stash->dirtyRect[2] = stash->params.width;
-	stash->dirtyRect[3] = maxy;
+	atlas->dirtyRect[0] = 0;
+	atlas->dirtyRect[1] = 0;
+	atlas->dirtyRect[2] = atlas->width;
+	atlas->dirtyRect[3] = atlas->bottom;
+
+	// Increase atlas size, the texture coordinates of the glyphs change
+	fons__atlasExpand(atlas, width, height);
+	stash->generation++;
 
 	stash->params.width = width;
 	stash->params.height = height;
-	stash->itw = 1.0f/stash->params.width;
-	stash->ith = 1.0f/stash->params.height;
 
 	return 1;
 }
@@ -2147,6 +2257,7 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 int fonsResetAtlas(FONScontext* stash, int width, int height)
 {
 	int i, j;
+	FONSatlas* atlas;
 	if (stash == NULL) return 0;
 
 	// Flush pending glyphs.
@@ -2158,19 +2269,24 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 			return 0;
 	}
 
+	// Keep only the first page
+	for (i = 1; i < stash->npages; i++) {
+		fons__deleteAtlas(stash->pages[i]);
+		stash->pages[i] = NULL;
+	}
+	stash->npages = 1;
+
 	// Reset atlas
-	fons__atlasReset(stash->atlas, width, height);
+	atlas = stash->pages[0];
+	fons__atlasReset(atlas, width, height);
 
 	// Clear texture data.
-	stash->texData = (unsigned char*)realloc(stash->texData, width * height);
-	if (stash->texData == NULL) return 0;
-	memset(stash->texData, 0, width * height);
+	atlas->texData = (unsigned char*)realloc(atlas->texData, width * height);
+	if (atlas->texData == NULL) return 0;
+	memset(atlas->texData, 0, width * height);
 
 	// Reset dirty rect
-	stash->dirtyRect[0] = width;
-	stash->dirtyRect[1] = height;
-	stash->dirtyRect[2] = 0;
-	stash->dirtyRect[3] = 0;
+	fons__atlasResetDirty(atlas);
 
 	// Reset cached glyphs
 	for (i = 0; i < stash->nfonts; i++) {
@@ -2179,11 +2295,10 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 		for (j = 0; j < FONS_HASH_LUT_SIZE; j++)
 			font->lut[j] = -1;
 	}
+	stash->generation++;
 
 	stash->params.width = width;
 	stash->params.height = height;
-	stash->itw = 1.0f/stash->params.width;
-	stash->ith = 1.0f/stash->params.height;
 
 	// Add white rect at 0,0 for debug drawing.
 	fons__addWhiteRect(stash, 2,2);
@@ -136,6 +136,13 @@ struct NVGtextRow {
 };
 typedef struct NVGtextRow NVGtextRow;
 
+struct NVGglyphQuad {
+	float x0, y0, x1, y1;	// Bounds of the glyph, in local coordinate space.
+	float s0, t0, s1, t1;	// Texture coordinates of the glyph in the font atlas.
+	int page, shelf;		// Location of the glyph in the font atlas, -1 for glyphs without bitmap.
+};
+typedef struct NVGglyphQuad NVGglyphQuad;
+
 enum NVGimageFlags {
     NVG_IMAGE_GENERATE_MIPMAPS	= 1<<0,     // Generate mipmaps during creation of the image.
 	NVG_IMAGE_REPEATX			= 1<<1,		// Repeat image in X direction.
@@ -640,6 +647,22 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 
 void nvgFontQuality(NVGcontext* ctx, float quality);
 
+// Lays out the glyphs of the specified text like nvgText() does, without drawing them, so that they can be drawn
+// many times with nvgTextQuadsDraw(). Missing glyphs are rasterized in the font atlas.
+// Returns the number of quads (at most maxQuads), or -1 if the glyphs of the text do not fit in the font atlas at once.
+// The quads stay valid as long as nvgTextQuadsScale() and nvgTextAtlasGeneration() return the same values.
+int nvgTextQuads(NVGcontext* ctx, float x, float y, const char* string, const char* end, NVGglyphQuad* quads, int maxQuads);
+
+// Draws glyph quads computed by nvgTextQuads(), moved by x and y, with the current fill color and transform.
+void nvgTextQuadsDraw(NVGcontext* ctx, float x, float y, const NVGglyphQuad* quads, int nquads);
+
+// Returns the scale the glyphs are rasterized at with the current text style and transform.
+float nvgTextQuadsScale(NVGcontext* ctx);
+
+// Returns a counter incremented every time glyphs are removed from the font atlas.
+// Glyphs drawn during the current frame are never removed before the next one.
+int nvgTextAtlasGeneration(NVGcontext* ctx);
+
 // Work like nvgFill, but only supports drawing image with alpha channels.
 // The image is used to create a stencil buffer, which will be used for subsequent drawing operations,
 // and only the content corresponding to the non-transparent part of the stencil buffer will be displayed.
@@ -0,0 +1,905 @@
+//
+// Copyright (c) 2026 borealis contributors
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+#ifndef NANOVG_SW_H
+#define NANOVG_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Software back-end drawing into a CPU framebuffer, for machines without a GPU.
+//
+// Paths are filled with the nonzero rule, sampled at the center of the pixels: there
+// is no anti-aliasing, so the same frame always gives the same pixels. Gradients,
+// images, scissors and blend functions follow the OpenGL back-end.
+//
+// Without a framebuffer, the draw calls are only counted (see nvgswGetStats()).
+
+struct NVGswStats {
+	int fills;
+	int strokes;
+	int triangles;			// calls to draw triangles (text)
+	int vertices;
+	long long pixels;		// pixels shaded
+};
+typedef struct NVGswStats NVGswStats;
+
+// No flags are defined yet, pass 0.
+NVGcontext* nvgCreateSW(int flags);
+void nvgDeleteSW(NVGcontext* ctx);
+
+// Sets the buffer drawn into: width * height RGBA pixels with premultiplied alpha,
+// stride bytes apart. Passing NULL only counts the draw calls.
+void nvgswSetFramebuffer(NVGcontext* ctx, unsigned char* pixels, int width, int height, int stride);
+
+// Fills the whole framebuffer with the color.
+void nvgswClear(NVGcontext* ctx, NVGcolor color);
+
+// Returns the counters of the draw calls since the last nvgBeginFrame().
+void nvgswGetStats(NVGcontext* ctx, NVGswStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOVG_SW_H */
+
+#ifdef NANOVG_SW_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "nanovg.h"
+
+struct SWNVGtexture {
+	int id;
+	int type;
+	int width, height;
+	int flags;
+	unsigned char* data;
+};
+typedef struct SWNVGtexture SWNVGtexture;
+
+// Edge of a polygon going down (dir = 1) or up (dir = -1), y0 < y1
+struct SWNVGedge {
+	float x0, y0, x1, y1;
+	float dxdy;
+	int dir;
+};
+typedef struct SWNVGedge SWNVGedge;
+
+struct SWNVGcrossing {
+	float x;
+	int dir;
+};
+typedef struct SWNVGcrossing SWNVGcrossing;
+
+// Everything needed to shade a pixel of a draw call
+struct SWNVGpaint {
+	float paintMat[6];
+	float scissorMat[6];
+	float scissorExt[2];
+	float scissorScale[2];
+	float extent[2];
+	float radius;
+	float feather;
+	float innerCol[4];
+	float outerCol[4];
+	int solid;
+	int scissor;
+	SWNVGtexture* tex;
+	int texType;		// 0: premultiplied RGBA, 1: straight RGBA, 2: alpha
+	int srcRGB, dstRGB, srcAlpha, dstAlpha;
+	int sourceOver;
+	int clipX0, clipY0, clipX1, clipY1;	// in pixels, end excluded
+};
+typedef struct SWNVGpaint SWNVGpaint;
+
+struct SWNVGcontext {
+	int flags;
+	float devicePixelRatio;
+
+	unsigned char* pixels;
+	int width, height, stride;
+
+	SWNVGtexture* textures;
+	int ntextures;
+	int ctextures;
+	int textureId;
+
+	SWNVGedge* edges;
+	int nedges;
+	int cedges;
+
+	int* active;
+	int cactive;
+
+	SWNVGcrossing* crossings;
+	int ccrossings;
+
+	NVGswStats stats;
+};
+typedef struct SWNVGcontext SWNVGcontext;
+
+static float swnvg__clampf(float a, float mn, float mx) { return a < mn ? mn : (a > mx ? mx : a); }
+static int swnvg__mini(int a, int b) { return a < b ? a : b; }
+static int swnvg__maxi(int a, int b) { return a > b ? a : b; }
+
+static void swnvg__xformPoint(const float* t, float x, float y, float* dx, float* dy)
+{
+	*dx = x*t[0] + y*t[2] + t[4];
+	*dy = x*t[1] + y*t[3] + t[5];
+}
+
+static int swnvg__grow(void** array, int* capacity, int count, int size)
+{
+	void* grown;
+	int ccount;
+	if (count <= *capacity) return 1;
+	ccount = swnvg__maxi(count, *capacity * 2);
+	grown = realloc(*array, (size_t)ccount * size);
+	if (grown == NULL) return 0;
+	*array = grown;
+	*capacity = ccount;
+	return 1;
+}
+
+static SWNVGtexture* swnvg__findTexture(SWNVGcontext* sw, int id)
+{
+	int i;
+	for (i = 0; i < sw->ntextures; i++)
+		if (sw->textures[i].id == id)
+			return &sw->textures[i];
+	return NULL;
+}
+
+static int swnvg__renderCreate(void* uptr)
+{
+	NVG_NOTUSED(uptr);
+	return 1;
+}
+
+static int swnvg__renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = NULL;
+	int i, bpp = type == NVG_TEXTURE_RGBA ? 4 : 1;
+
+	for (i = 0; i < sw->ntextures; i++) {
+		if (sw->textures[i].id == 0) {
+			tex = &sw->textures[i];
+			break;
+		}
+	}
+	if (tex == NULL) {
+		if (!swnvg__grow((void**)&sw->textures, &sw->ctextures, sw->ntextures+1, sizeof(SWNVGtexture)))
+			return 0;
+		tex = &sw->textures[sw->ntextures++];
+	}
+
+	memset(tex, 0, sizeof(*tex));
+	tex->data = (unsigned char*)calloc((size_t)w * h, bpp);
+	if (tex->data == NULL) return 0;
+
+	if (data != NULL)
+		memcpy(tex->data, data, (size_t)w * h * bpp);
+
+	tex->id = ++sw->textureId;
+	tex->type = type;
+	tex->width = w;
+	tex->height = h;
+	tex->flags = imageFlags;
+
+	return tex->id;
+}
+
+static int swnvg__renderDeleteTexture(void* uptr, int image)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	if (tex == NULL) return 0;
+	free(tex->data);
+	memset(tex, 0, sizeof(*tex));
+	return 1;
+}
+
+static int swnvg__renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	int row, bpp;
+
+	if (tex == NULL) return 0;
+
+	// The data is the whole image, like with GL_UNPACK_ROW_LENGTH
+	bpp = tex->type == NVG_TEXTURE_RGBA ? 4 : 1;
+	for (row = y; row < y + h; row++) {
+		size_t offset = ((size_t)row * tex->width + x) * bpp;
+		memcpy(tex->data + offset, data + offset, (size_t)w * bpp);
+	}
+
+	return 1;
+}
+
+static int swnvg__renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	if (tex == NULL) return 0;
+	*w = tex->width;
+	*h = tex->height;
+	return 1;
+}
+
+static void swnvg__renderViewport(void* uptr, float width, float height, float devicePixelRatio)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	NVG_NOTUSED(width);
+	NVG_NOTUSED(height);
+	sw->devicePixelRatio = devicePixelRatio;
+	memset(&sw->stats, 0, sizeof(sw->stats));
+}
+
+static void swnvg__renderCancel(void* uptr)
+{
+	NVG_NOTUSED(uptr);
+}
+
+static void swnvg__renderFlush(void* uptr)
+{
+	// Everything is drawn right away
+	NVG_NOTUSED(uptr);
+}
+
+static void swnvg__premulColor(NVGcolor c, float* dst)
+{
+	dst[0] = c.r * c.a;
+	dst[1] = c.g * c.a;
+	dst[2] = c.b * c.a;
+	dst[3] = c.a;
+}
+
+static int swnvg__convertPaint(SWNVGcontext* sw, SWNVGpaint* p, NVGpaint* paint, NVGcompositeOperationState op, NVGscissor* scissor, float fringe)
+{
+	float ratio = sw->devicePixelRatio;
+
+	memset(p, 0, sizeof(*p));
+
+	swnvg__premulColor(paint->innerColor, p->innerCol);
+	swnvg__premulColor(paint->outerColor, p->outerCol);
+
+	p->clipX0 = 0;
+	p->clipY0 = 0;
+	p->clipX1 = sw->width;
+	p->clipY1 = sw->height;
+
+	if (scissor->extent[0] >= -0.5f && scissor->extent[1] >= -0.5f) {
+		float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+		int i;
+
+		nvgTransformInverse(p->scissorMat, scissor->xform);
+		p->scissor = 1;
+		p->scissorExt[0] = scissor->extent[0];
+		p->scissorExt[1] = scissor->extent[1];
+		p->scissorScale[0] = sqrtf(scissor->xform[0]*scissor->xform[0] + scissor->xform[2]*scissor->xform[2]) / fringe;
+		p->scissorScale[1] = sqrtf(scissor->xform[1]*scissor->xform[1] + scissor->xform[3]*scissor->xform[3]) / fringe;
+
+		// Nothing is drawn outside of the bounds of the transformed scissor rect
+		for (i = 0; i < 4; i++) {
+			float x, y;
+			swnvg__xformPoint(scissor->xform, (i & 1) ? scissor->extent[0] : -scissor->extent[0],
+				(i & 2) ? scissor->extent[1] : -scissor->extent[1], &x, &y);
+			minX = fminf(minX, x); minY = fminf(minY, y);
+			maxX = fmaxf(maxX, x); maxY = fmaxf(maxY, y);
+		}
+		p->clipX0 = swnvg__maxi(p->clipX0, (int)floorf(minX * ratio));
+		p->clipY0 = swnvg__maxi(p->clipY0, (int)floorf(minY * ratio));
+		p->clipX1 = swnvg__mini(p->clipX1, (int)ceilf(maxX * ratio));
+		p->clipY1 = swnvg__mini(p->clipY1, (int)ceilf(maxY * ratio));
+	}
+
+	if (p->clipX0 >= p->clipX1 || p->clipY0 >= p->clipY1)
+		return 0;
+
+	p->extent[0] = paint->extent[0];
+	p->extent[1] = paint->extent[1];
+
+	if (paint->image != 0) {
+		p->tex = swnvg__findTexture(sw, paint->image);
+		if (p->tex == NULL) return 0;
+
+		if ((p->tex->flags & NVG_IMAGE_FLIPY) != 0) {
+			float m1[6], m2[6];
+			nvgTransformTranslate(m1, 0.0f, p->extent[1] * 0.5f);
+			nvgTransformMultiply(m1, paint->xform);
+			nvgTransformScale(m2, 1.0f, -1.0f);
+			nvgTransformMultiply(m2, m1);
+			nvgTransformTranslate(m1, 0.0f, -p->extent[1] * 0.5f);
+			nvgTransformMultiply(m1, m2);
+			nvgTransformInverse(p->paintMat, m1);
+		} else {
+			nvgTransformInverse(p->paintMat, paint->xform);
+		}
+
+		if (p->tex->type == NVG_TEXTURE_RGBA)
+			p->texType = (p->tex->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
+		else
+			p->texType = 2;
+	} else {
+		p->radius = paint->radius;
+		p->feather = paint->feather;
+		p->solid = memcmp(p->innerCol, p->outerCol, sizeof(p->innerCol)) == 0;
+		nvgTransformInverse(p->paintMat, paint->xform);
+	}
+
+	p->srcRGB = op.srcRGB;
+	p->dstRGB = op.dstRGB;
+	p->srcAlpha = op.srcAlpha;
+	p->dstAlpha = op.dstAlpha;
+	p->sourceOver = op.srcRGB == NVG_ONE && op.dstRGB == NVG_ONE_MINUS_SRC_ALPHA
+		&& op.srcAlpha == NVG_ONE && op.dstAlpha == NVG_ONE_MINUS_SRC_ALPHA;
+
+	return 1;
+}
+
+static void swnvg__texel(SWNVGtexture* tex, int x, int y, float* dst)
+{
+	if ((tex->flags & NVG_IMAGE_REPEATX) != 0) {
+		x %= tex->width;
+		if (x < 0) x += tex->width;
+	} else {
+		x = swnvg__mini(swnvg__maxi(x, 0), tex->width - 1);
+	}
+	if ((tex->flags & NVG_IMAGE_REPEATY) != 0) {
+		y %= tex->height;
+		if (y < 0) y += tex->height;
+	} else {
+		y = swnvg__mini(swnvg__maxi(y, 0), tex->height - 1);
+	}
+
+	if (tex->type == NVG_TEXTURE_RGBA) {
+		const unsigned char* t = tex->data + ((size_t)y * tex->width + x) * 4;
+		dst[0] = t[0] / 255.0f;
+		dst[1] = t[1] / 255.0f;
+		dst[2] = t[2] / 255.0f;
+		dst[3] = t[3] / 255.0f;
+	} else {
+		dst[0] = dst[1] = dst[2] = dst[3] = tex->data[(size_t)y * tex->width + x] / 255.0f;
+	}
+}
+
+// Samples the texture at normalized coordinates, with the conversion of the texture type
+static void swnvg__sample(SWNVGpaint* p, float u, float v, float* dst)
+{
+	SWNVGtexture* tex = p->tex;
+	float x = u * tex->width;
+	float y = v * tex->height;
+	int i;
+
+	if ((tex->flags & NVG_IMAGE_NEAREST) != 0) {
+		swnvg__texel(tex, (int)floorf(x), (int)floorf(y), dst);
+	} else {
+		float t00[4], t10[4], t01[4], t11[4];
+		float fx, fy;
+		int x0, y0;
+
+		x -= 0.5f;
+		y -= 0.5f;
+		x0 = (int)floorf(x);
+		y0 = (int)floorf(y);
+		fx = x - x0;
+		fy = y - y0;
+
+		swnvg__texel(tex, x0, y0, t00);
+		swnvg__texel(tex, x0 + 1, y0, t10);
+		swnvg__texel(tex, x0, y0 + 1, t01);
+		swnvg__texel(tex, x0 + 1, y0 + 1, t11);
+
+		for (i = 0; i < 4; i++) {
+			float top = t00[i] + (t10[i] - t00[i]) * fx;
+			float bottom = t01[i] + (t11[i] - t01[i]) * fx;
+			dst[i] = top + (bottom - top) * fy;
+		}
+	}
+
+	if (p->texType == 1) {
+		dst[0] *= dst[3];
+		dst[1] *= dst[3];
+		dst[2] *= dst[3];
+	}
+}
+
+static float swnvg__sdroundrect(float x, float y, float ex, float ey, float rad)
+{
+	float dx = fabsf(x) - (ex - rad);
+	float dy = fabsf(y) - (ey - rad);
+	float ox = fmaxf(dx, 0.0f), oy = fmaxf(dy, 0.0f);
+	return fminf(fmaxf(dx, dy), 0.0f) + sqrtf(ox*ox + oy*oy) - rad;
+}
+
+static float swnvg__scissorMask(SWNVGpaint* p, float x, float y)
+{
+	float sx, sy;
+	swnvg__xformPoint(p->scissorMat, x, y, &sx, &sy);
+	sx = 0.5f - (fabsf(sx) - p->scissorExt[0]) * p->scissorScale[0];
+	sy = 0.5f - (fabsf(sy) - p->scissorExt[1]) * p->scissorScale[1];
+	return swnvg__clampf(sx, 0.0f, 1.0f) * swnvg__clampf(sy, 0.0f, 1.0f);
+}
+
+// Color of the paint at a point of the canvas (not the framebuffer), premultiplied
+static void swnvg__paintColor(SWNVGpaint* p, float x, float y, float* dst)
+{
+	float px, py;
+	int i;
+
+	if (p->solid) {
+		memcpy(dst, p->innerCol, sizeof(p->innerCol));
+		return;
+	}
+
+	swnvg__xformPoint(p->paintMat, x, y, &px, &py);
+
+	if (p->tex != NULL) {
+		swnvg__sample(p, px / p->extent[0], py / p->extent[1], dst);
+		for (i = 0; i < 4; i++)
+			dst[i] *= p->innerCol[i];
+	} else {
+		float d = swnvg__clampf((swnvg__sdroundrect(px, py, p->extent[0], p->extent[1], p->radius) + p->feather*0.5f) / p->feather, 0.0f, 1.0f);
+		for (i = 0; i < 4; i++)
+			dst[i] = p->innerCol[i] + (p->outerCol[i] - p->innerCol[i]) * d;
+	}
+}
+
+static float swnvg__blendFactor(int factor, const float* src, const float* dst, int channel)
+{
+	switch (factor) {
+		case NVG_ZERO: return 0.0f;
+		case NVG_ONE: return 1.0f;
+		case NVG_SRC_COLOR: return src[channel];
+		case NVG_ONE_MINUS_SRC_COLOR: return 1.0f - src[channel];
+		case NVG_DST_COLOR: return dst[channel];
+		case NVG_ONE_MINUS_DST_COLOR: return 1.0f - dst[channel];
+		case NVG_SRC_ALPHA: return src[3];
+		case NVG_ONE_MINUS_SRC_ALPHA: return 1.0f - src[3];
+		case NVG_DST_ALPHA: return dst[3];
+		case NVG_ONE_MINUS_DST_ALPHA: return 1.0f - dst[3];
+		case NVG_SRC_ALPHA_SATURATE: return channel == 3 ? 1.0f : fminf(src[3], 1.0f - dst[3]);
+	}
+	return 0.0f;
+}
+
+static unsigned char swnvg__toByte(float v)
+{
+	return (unsigned char)(swnvg__clampf(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+static void swnvg__blend(SWNVGpaint* p, unsigned char* pixel, const float* src)
+{
+	float dst[4], out[4];
+	int i;
+
+	if (p->sourceOver) {
+		float inv = 1.0f - src[3];
+		if (inv <= 0.0f) {
+			for (i = 0; i < 4; i++)
+				pixel[i] = swnvg__toByte(src[i]);
+			return;
+		}
+		for (i = 0; i < 4; i++)
+			pixel[i] = swnvg__toByte(src[i] + pixel[i] / 255.0f * inv);
+		return;
+	}
+
+	for (i = 0; i < 4; i++)
+		dst[i] = pixel[i] / 255.0f;
+
+	for (i = 0; i < 3; i++)
+		out[i] = src[i] * swnvg__blendFactor(p->srcRGB, src, dst, i) + dst[i] * swnvg__blendFactor(p->dstRGB, src, dst, i);
+	out[3] = src[3] * swnvg__blendFactor(p->srcAlpha, src, dst, 3) + dst[3] * swnvg__blendFactor(p->dstAlpha, src, dst, 3);
+
+	for (i = 0; i < 4; i++)
+		pixel[i] = swnvg__toByte(out[i]);
+}
+
+// Shades the pixels from x0 to x1 (excluded) of a row
+static void swnvg__span(SWNVGcontext* sw, SWNVGpaint* p, int y, int x0, int x1)
+{
+	unsigned char* pixel = sw->pixels + (size_t)y * sw->stride + (size_t)x0 * 4;
+	float ratio = sw->devicePixelRatio;
+	float cy = (y + 0.5f) / ratio;
+	float color[4];
+	int x, i;
+
+	sw->stats.pixels += x1 - x0;
+
+	// Opaque color and no scissor: the pixels are simply replaced
+	if (p->solid && !p->scissor && p->sourceOver && p->innerCol[3] >= 1.0f) {
+		unsigned char c[4];
+		for (i = 0; i < 4; i++)
+			c[i] = swnvg__toByte(p->innerCol[i]);
+		for (x = x0; x < x1; x++, pixel += 4)
+			memcpy(pixel, c, 4);
+		return;
+	}
+
+	for (x = x0; x < x1; x++, pixel += 4) {
+		float cx = (x + 0.5f) / ratio;
+		float coverage = p->scissor ? swnvg__scissorMask(p, cx, cy) : 1.0f;
+		if (coverage <= 0.0f)
+			continue;
+
+		swnvg__paintColor(p, cx, cy, color);
+		for (i = 0; i < 4; i++)
+			color[i] *= coverage;
+
+		swnvg__blend(p, pixel, color);
+	}
+}
+
+static void swnvg__addEdge(SWNVGcontext* sw, float x0, float y0, float x1, float y1)
+{
+	float ratio = sw->devicePixelRatio;
+	SWNVGedge* e;
+
+	if (y0 == y1) return;
+	if (!swnvg__grow((void**)&sw->edges, &sw->cedges, sw->nedges+1, sizeof(SWNVGedge))) return;
+
+	e = &sw->edges[sw->nedges++];
+	if (y0 < y1) {
+		e->x0 = x0 * ratio; e->y0 = y0 * ratio;
+		e->x1 = x1 * ratio; e->y1 = y1 * ratio;
+		e->dir = 1;
+	} else {
+		e->x0 = x1 * ratio; e->y0 = y1 * ratio;
+		e->x1 = x0 * ratio; e->y1 = y0 * ratio;
+		e->dir = -1;
+	}
+	e->dxdy = (e->x1 - e->x0) / (e->y1 - e->y0);
+}
+
+static int swnvg__cmpEdge(const void* a, const void* b)
+{
+	float ya = ((const SWNVGedge*)a)->y0, yb = ((const SWNVGedge*)b)->y0;
+	return ya < yb ? -1 : (ya > yb ? 1 : 0);
+}
+
+// Fills the area of nonzero winding of the edges, one row of pixels at a time
+static void swnvg__rasterize(SWNVGcontext* sw, SWNVGpaint* p)
+{
+	float minY = 1e30f, maxY = -1e30f;
+	int i, y, y0, y1, next = 0, nactive = 0;
+
+	if (sw->nedges == 0) return;
+
+	for (i = 0; i < sw->nedges; i++) {
+		minY = fminf(minY, sw->edges[i].y0);
+		maxY = fmaxf(maxY, sw->edges[i].y1);
+	}
+
+	// Rows whose center is inside of the edges
+	y0 = swnvg__maxi(p->clipY0, (int)ceilf(minY - 0.5f));
+	y1 = swnvg__mini(p->clipY1, (int)ceilf(maxY - 0.5f));
+	if (y0 >= y1) return;
+
+	if (!swnvg__grow((void**)&sw->active, &sw->cactive, sw->nedges, sizeof(int))) return;
+	if (!swnvg__grow((void**)&sw->crossings, &sw->ccrossings, sw->nedges, sizeof(SWNVGcrossing))) return;
+
+	qsort(sw->edges, sw->nedges, sizeof(SWNVGedge), swnvg__cmpEdge);
+
+	for (y = y0; y < y1; y++) {
+		float cy = y + 0.5f;
+		int ncrossings = 0, winding = 0, k;
+		float start = 0.0f;
+
+		while (next < sw->nedges && sw->edges[next].y0 <= cy)
+			sw->active[nactive++] = next++;
+
+		// Drop the edges above the row, keep the crossings sorted along it
+		for (i = 0; i < nactive; i++) {
+			SWNVGedge* e = &sw->edges[sw->active[i]];
+			float x;
+
+			if (e->y1 <= cy) {
+				sw->active[i--] = sw->active[--nactive];
+				continue;
+			}
+
+			x = e->x0 + (cy - e->y0) * e->dxdy;
+			for (k = ncrossings; k > 0 && sw->crossings[k-1].x > x; k--)
+				sw->crossings[k] = sw->crossings[k-1];
+			sw->crossings[k].x = x;
+			sw->crossings[k].dir = e->dir;
+			ncrossings++;
+		}
+
+		for (i = 0; i < ncrossings; i++) {
+			int previous = winding;
+			winding += sw->crossings[i].dir;
+
+			if (previous == 0 && winding != 0) {
+				start = sw->crossings[i].x;
+			} else if (previous != 0 && winding == 0) {
+				int x0 = swnvg__maxi(p->clipX0, (int)ceilf(start - 0.5f));
+				int x1 = swnvg__mini(p->clipX1, (int)ceilf(sw->crossings[i].x - 0.5f));
+				if (x0 < x1)
+					swnvg__span(sw, p, y, x0, x1);
+			}
+		}
+	}
+}
+
+static void swnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+							  const float* bounds, const NVGpath* paths, int npaths)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGpaint p;
+	int i, j;
+
+	NVG_NOTUSED(bounds);
+
+	sw->stats.fills++;
+	for (i = 0; i < npaths; i++)
+		sw->stats.vertices += paths[i].nfill;
+
+	// Stencil masks are not supported, the paths only went to the stencil buffer
+	if (sw->pixels == NULL || scissor->stencilFlag != NVG_STENCIL_DEFAULT)
+		return;
+	if (!swnvg__convertPaint(sw, &p, paint, compositeOperation, scissor, fringe))
+		return;
+
+	sw->nedges = 0;
+	for (i = 0; i < npaths; i++) {
+		const NVGvertex* verts = paths[i].fill;
+		int n = paths[i].nfill;
+		for (j = 0; j < n; j++) {
+			const NVGvertex* a = &verts[j];
+			const NVGvertex* b = &verts[(j + 1) % n];
+			swnvg__addEdge(sw, a->x, a->y, b->x, b->y);
+		}
+	}
+
+	swnvg__rasterize(sw, &p);
+}
+
+static void swnvg__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+								float strokeWidth, const NVGpath* paths, int npaths)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGpaint p;
+	int i, j;
+
+	NVG_NOTUSED(strokeWidth);
+
+	sw->stats.strokes++;
+	for (i = 0; i < npaths; i++)
+		sw->stats.vertices += paths[i].nstroke;
+
+	if (sw->pixels == NULL)
+		return;
+	if (!swnvg__convertPaint(sw, &p, paint, compositeOperation, scissor, fringe))
+		return;
+
+	// The triangles of the strips, all turned the same way: their union has a nonzero
+	// winding, so the overlaps of the stroke are drawn once
+	sw->nedges = 0;
+	for (i = 0; i < npaths; i++) {
+		const NVGvertex* verts = paths[i].stroke;
+		for (j = 0; j + 2 < paths[i].nstroke; j++) {
+			const NVGvertex* a = &verts[j];
+			const NVGvertex* b = &verts[j+1];
+			const NVGvertex* c = &verts[j+2];
+			float area = (b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x);
+
+			if (area == 0.0f)
+				continue;
+			if (area < 0.0f) {
+				const NVGvertex* t = b;
+				b = c;
+				c = t;
+			}
+
+			swnvg__addEdge(sw, a->x, a->y, b->x, b->y);
+			swnvg__addEdge(sw, b->x, b->y, c->x, c->y);
+			swnvg__addEdge(sw, c->x, c->y, a->x, a->y);
+		}
+	}
+
+	swnvg__rasterize(sw, &p);
+}
+
+// Shared edges go to one of the two triangles only
+static int swnvg__edgeOwns(float w, float dx, float dy)
+{
+	return w > 0.0f || (w == 0.0f && (dy > 0.0f || (dy == 0.0f && dx < 0.0f)));
+}
+
+static void swnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+								   const NVGvertex* verts, int nverts, float fringe)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	float ratio = sw->devicePixelRatio;
+	SWNVGpaint p;
+	int t, i;
+
+	sw->stats.triangles++;
+	sw->stats.vertices += nverts;
+
+	if (sw->pixels == NULL)
+		return;
+	if (!swnvg__convertPaint(sw, &p, paint, compositeOperation, scissor, fringe))
+		return;
+
+	for (t = 0; t + 2 < nverts; t += 3) {
+		const NVGvertex* v0 = &verts[t];
+		const NVGvertex* v1 = &verts[t+1];
+		const NVGvertex* v2 = &verts[t+2];
+		float x0, y0, x1, y1, x2, y2, area;
+		int minX, minY, maxX, maxY, x, y;
+
+		area = (v1->x - v0->x) * (v2->y - v0->y) - (v1->y - v0->y) * (v2->x - v0->x);
+		if (area == 0.0f)
+			continue;
+		if (area < 0.0f) {
+			const NVGvertex* tmp = v1;
+			v1 = v2;
+			v2 = tmp;
+			area = -area;
+		}
+
+		x0 = v0->x * ratio; y0 = v0->y * ratio;
+		x1 = v1->x * ratio; y1 = v1->y * ratio;
+		x2 = v2->x * ratio; y2 = v2->y * ratio;
+		area *= ratio * ratio;
+
+		minX = swnvg__maxi(p.clipX0, (int)floorf(fminf(x0, fminf(x1, x2))));
+		minY = swnvg__maxi(p.clipY0, (int)floorf(fminf(y0, fminf(y1, y2))));
+		maxX = swnvg__mini(p.clipX1, (int)ceilf(fmaxf(x0, fmaxf(x1, x2))));
+		maxY = swnvg__mini(p.clipY1, (int)ceilf(fmaxf(y0, fmaxf(y1, y2))));
+
+		for (y = minY; y < maxY; y++) {
+			float cy = y + 0.5f;
+			unsigned char* pixel = sw->pixels + (size_t)y * sw->stride + (size_t)minX * 4;
+
+			for (x = minX; x < maxX; x++, pixel += 4) {
+				float cx = x + 0.5f;
+				float w0 = (x2 - x1) * (cy - y1) - (y2 - y1) * (cx - x1);
+				float w1 = (x0 - x2) * (cy - y2) - (y0 - y2) * (cx - x2);
+				float w2 = (x1 - x0) * (cy - y0) - (y1 - y0) * (cx - x0);
+				float color[4], coverage;
+
+				if (!swnvg__edgeOwns(w0, x2 - x1, y2 - y1) || !swnvg__edgeOwns(w1, x0 - x2, y0 - y2) || !swnvg__edgeOwns(w2, x1 - x0, y1 - y0))
+					continue;
+
+				coverage = p.scissor ? swnvg__scissorMask(&p, cx / ratio, cy / ratio) : 1.0f;
+				if (coverage <= 0.0f)
+					continue;
+
+				if (p.tex != NULL) {
+					float u = (w0 * v0->u + w1 * v1->u + w2 * v2->u) / area;
+					float v = (w0 * v0->v + w1 * v1->v + w2 * v2->v) / area;
+					swnvg__sample(&p, u, v, color);
+				} else {
+					color[0] = color[1] = color[2] = color[3] = 1.0f;
+				}
+
+				for (i = 0; i < 4; i++)
+					color[i] *= p.innerCol[i] * coverage;
+
+				swnvg__blend(&p, pixel, color);
+				sw->stats.pixels++;
+			}
+		}
+	}
+}
+
+static void swnvg__renderDelete(void* uptr)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	int i;
+
+	if (sw == NULL) return;
+
+	for (i = 0; i < sw->ntextures; i++)
+		free(sw->textures[i].data);
+
+	free(sw->textures);
+	free(sw->edges);
+	free(sw->active);
+	free(sw->crossings);
+	free(sw);
+}
+
+NVGcontext* nvgCreateSW(int flags)
+{
+	NVGparams params;
+	NVGcontext* ctx = NULL;
+	SWNVGcontext* sw = (SWNVGcontext*)malloc(sizeof(SWNVGcontext));
+	if (sw == NULL) goto error;
+	memset(sw, 0, sizeof(SWNVGcontext));
+
+	memset(&params, 0, sizeof(params));
+	params.renderCreate = swnvg__renderCreate;
+	params.renderCreateTexture = swnvg__renderCreateTexture;
+	params.renderDeleteTexture = swnvg__renderDeleteTexture;
+	params.renderUpdateTexture = swnvg__renderUpdateTexture;
+	params.renderGetTextureSize = swnvg__renderGetTextureSize;
+	params.renderViewport = swnvg__renderViewport;
+	params.renderCancel = swnvg__renderCancel;
+	params.renderFlush = swnvg__renderFlush;
+	params.renderFill = swnvg__renderFill;
+	params.renderStroke = swnvg__renderStroke;
+	params.renderTriangles = swnvg__renderTriangles;
+	params.renderDelete = swnvg__renderDelete;
+	params.userPtr = sw;
+	params.edgeAntiAlias = 0;
+
+	sw->flags = flags;
+	sw->devicePixelRatio = 1.0f;
+
+	ctx = nvgCreateInternal(&params);
+	if (ctx == NULL) goto error;
+
+	return ctx;
+
+error:
+	// 'sw' is freed by nvgDeleteInternal.
+	if (ctx != NULL) nvgDeleteInternal(ctx);
+	return NULL;
+}
+
+void nvgDeleteSW(NVGcontext* ctx)
+{
+	nvgDeleteInternal(ctx);
+}
+
+void nvgswSetFramebuffer(NVGcontext* ctx, unsigned char* pixels, int width, int height, int stride)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	sw->pixels = pixels;
+	sw->width = pixels != NULL ? width : 0;
+	sw->height = pixels != NULL ? height : 0;
+	sw->stride = stride;
+}
+
+void nvgswClear(NVGcontext* ctx, NVGcolor color)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	float premul[4];
+	unsigned char c[4];
+	int x, y, i;
+
+	if (sw->pixels == NULL) return;
+
+	swnvg__premulColor(color, premul);
+	for (i = 0; i < 4; i++)
+		c[i] = swnvg__toByte(premul[i]);
+
+	for (y = 0; y < sw->height; y++) {
+		unsigned char* pixel = sw->pixels + (size_t)y * sw->stride;
+		for (x = 0; x < sw->width; x++, pixel += 4)
+			memcpy(pixel, c, 4);
+	}
+}
+
+void nvgswGetStats(NVGcontext* ctx, NVGswStats* stats)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	*stats = sw->stats;
+}
+
+#endif /* NANOVG_SW_IMPLEMENTATION */
@@ -0,0 +1,107 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/input.hpp>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Headless input manager: one controller and one finger, replaying a script.
+//
+// Each line of the script is an event and the frame it happens at,
+// frames are counted from 0 and empty lines or lines starting with # are ignored:
+//   120 press A                   press a button, released on the next frame
+//   120 down LB / 180 up LB       hold a button
+//   200 touch 640 360             put the finger down, or move it (content coordinates)
+//   210 release                   lift the finger
+//   240 drag 640 600 640 100 30   slide the finger over 30 frames, then lift it
+//   600 quit                      stop the application
+// Buttons are named after ControllerButton: A, B, X, Y, LB, RB, LT, RT, LSB, RSB,
+// UP, RIGHT, DOWN, LEFT, BACK, GUIDE, START.
+class HeadlessInputManager : public InputManager
+{
+  public:
+    HeadlessInputManager(const std::string& script);
+
+    /**
+     * Applies the events of the script happening up to the given frame.
+     */
+    void setFrame(size_t frame);
+
+    /**
+     * Returns true once the script reached its quit event.
+     */
+    bool isQuitRequested();
+
+    /**
+     * Presses or releases a button, for programs driving
+     * the application themselves rather than through a script.
+     */
+    void setButton(ControllerButton button, bool pressed);
+
+    /**
+     * Puts the finger down at the given position, or lifts it.
+     */
+    void setTouch(bool touching, Point position = Point());
+
+    short getControllersConnectedCount() override;
+
+    void updateUnifiedControllerState(ControllerState* state) override;
+
+    void updateControllerState(ControllerState* state, int controller) override;
+
+    bool getKeyboardKeyState(BrlsKeyboardScancode state) override;
+
+    void updateTouchStates(std::vector<RawTouchState>* states) override;
+
+    void updateMouseStates(RawMouseState* state) override;
+
+    void sendRumble(unsigned short controller, unsigned short lowFreqMotor, unsigned short highFreqMotor) override;
+
+  private:
+    enum class ScriptAction
+    {
+        BUTTON_DOWN,
+        BUTTON_UP,
+        TOUCH,
+        RELEASE,
+        QUIT,
+    };
+
+    struct ScriptEvent
+    {
+        size_t frame;
+        ScriptAction action;
+        ControllerButton button = BUTTON_A; // BUTTON_DOWN and BUTTON_UP
+        Point position          = Point(); // TOUCH
+    };
+
+    std::vector<ScriptEvent> events;
+    size_t nextEvent = 0;
+
+    bool buttons[_BUTTON_MAX] = {};
+    bool touching             = false;
+    Point touch;
+    bool quit = false;
+
+    void load(const std::string& script);
+};
+
+} // namespace brls
@@ -0,0 +1,95 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/audio.hpp>
+#include <borealis/platforms/desktop/desktop_platform.hpp>
+#include <borealis/platforms/headless/headless_input.hpp>
+#include <borealis/platforms/headless/headless_video.hpp>
+
+namespace brls
+{
+
+// Platform without window or GPU, built with -DUSE_HEADLESS=ON: frames are drawn in memory
+// as fast as possible while replaying an input script, then the frame times are reported.
+//
+// Every frame is redrawn, so that the times measure the whole pipeline
+// (input, animations, layout and drawing) and stay comparable from run to run.
+//
+// The settings below can also be given through the environment:
+// BOREALIS_HEADLESS_FRAMES, BOREALIS_HEADLESS_INPUT, BOREALIS_HEADLESS_SCREENSHOTS,
+// BOREALIS_HEADLESS_SCREENSHOTS_INTERVAL, BOREALIS_HEADLESS_TIMINGS, BOREALIS_HEADLESS_RASTERIZE
+// and BOREALIS_HEADLESS_TRACE.
+class HeadlessPlatform : public DesktopPlatform
+{
+  public:
+    HeadlessPlatform();
+    ~HeadlessPlatform() override;
+
+    std::string getName() override;
+    void createWindow(std::string windowTitle, uint32_t windowWidth, uint32_t windowHeight, float windowXPos, float windowYPos) override;
+
+    bool mainLoopIteration() override;
+
+    AudioPlayer* getAudioPlayer() override;
+    VideoContext* getVideoContext() override;
+    InputManager* getInputManager() override;
+
+    // Number of frames drawn before quitting, 0 to run until the application quits
+    inline static size_t FRAMES = 600;
+
+    // Input script replayed, see HeadlessInputManager
+    inline static std::string INPUT_SCRIPT = "";
+
+    // Directory the frames are written to as PNG files, nothing is written if empty
+    inline static std::string SCREENSHOTS_DIRECTORY = "";
+
+    // One frame out of SCREENSHOTS_INTERVAL is written
+    inline static size_t SCREENSHOTS_INTERVAL = 60;
+
+    // CSV file the time and draw calls of every frame are written to, nothing is written if empty
+    inline static std::string TIMINGS_FILE = "";
+
+    // Draw the frames in memory, or only record the draw calls
+    inline static bool RASTERIZE = true;
+
+    // Chrome trace the last frames of the Profiler are written to when quitting, nothing is written if empty.
+    // Setting it enables the profiler, which has to be built with -DBRLS_PROFILER=ON
+    inline static std::string TRACE_FILE = "";
+
+  protected:
+    NullAudioPlayer* audioPlayer       = nullptr;
+    HeadlessVideoContext* videoContext = nullptr;
+    HeadlessInputManager* inputManager = nullptr;
+
+  private:
+    struct FrameTiming
+    {
+        size_t frame;
+        Time duration;
+        NVGswStats stats;
+    };
+
+    size_t frame    = 0;
+    Time frameStart = 0;
+    std::vector<FrameTiming> timings;
+
+    void recordFrame();
+    void report();
+};
+
+} // namespace brls
@@ -0,0 +1,73 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg_sw.h>
+
+#include <borealis/core/time.hpp>
+#include <borealis/core/video.hpp>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Headless Video Context: nanovg draws into a framebuffer in memory with the
+// software back-end, or only records the draw calls if rasterize is false
+class HeadlessVideoContext : public VideoContext
+{
+  public:
+    HeadlessVideoContext(uint32_t windowWidth, uint32_t windowHeight, bool rasterize);
+    ~HeadlessVideoContext() override;
+
+    NVGcontext* getNVGContext() override;
+
+    void clear(NVGcolor color) override;
+    void beginFrame() override;
+    void endFrame() override;
+    void setSwapInterval(int interval) override;
+    void resetState() override;
+
+    double getScaleFactor() override;
+
+    /**
+     * Returns the time at which the last frame was done drawing.
+     */
+    Time getFrameEndTime();
+
+    /**
+     * Returns the counters of the draw calls of the last frame.
+     */
+    NVGswStats getFrameStats();
+
+    /**
+     * Writes the last frame to a PNG file. Returns false if nothing
+     * is rasterized or the file cannot be written.
+     */
+    bool writeFrame(const std::string& path);
+
+  private:
+    NVGcontext* nvgContext = nullptr;
+
+    std::vector<unsigned char> framebuffer;
+    uint32_t width, height;
+
+    Time frameEndTime = 0;
+    NVGswStats frameStats {};
+};
+
+} // namespace brls
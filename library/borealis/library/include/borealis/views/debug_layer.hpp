@@ -21,10 +21,16 @@
 namespace brls
 {
 
+// Shows the logs over the application, and the frames of the Profiler when it is enabled
 class DebugLayer : public Box
 {
   public:
     DebugLayer();
+
+    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+
+  private:
+    void drawProfiler(NVGcontext* vg, float x, float y, float width);
 };
 
 } // namespace brls
@@ -0,0 +1,35 @@
+/*
+    Copyright 2020-2021 natinusala
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/views/recycler.hpp>
+
+namespace brls
+{
+
+// A RecyclerFrame that lays its lines out from left to right and scrolls horizontally.
+// Row "heights" are the widths of the cells, and columns are stacked from top to bottom.
+class HRecyclerFrame : public RecyclerFrame
+{
+  public:
+    HRecyclerFrame();
+
+    static View* create();
+};
+
+} // namespace brls
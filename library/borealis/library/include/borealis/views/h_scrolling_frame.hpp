@@ -22,53 +22,21 @@
 namespace brls
 {
 
-// A vertical-only frame that can scroll if its content overflows.
+// A horizontal-only frame that can scroll if its content overflows.
 // This frame can only contain one child view.
 // The content view is detached from the rest of the tree
-// so that its height can grow as much as possible.
-class HScrollingFrame : public Box
+// so that its width can grow as much as possible.
+class HScrollingFrame : public BaseScrollingFrame
 {
   public:
     HScrollingFrame();
-    ~HScrollingFrame();
-
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
-    void onFocusGained() override;
-    void onChildFocusGained(View* directChild, View* focusedView) override;
-    void onChildFocusLost(View* directChild, View* focusedView) override;
-    void willAppear(bool resetState) override;
-    void addView(View* view) override;
-    void removeView(View* view, bool free = true) override;
-    void onLayout() override;
-    void setPadding(float top, float right, float bottom, float left) override;
-    void setPaddingTop(float top) override;
-    void setPaddingRight(float right) override;
-    void setPaddingBottom(float bottom) override;
-    void setPaddingLeft(float left) override;
-    View* getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction) override;
-    View* getNextFocus(FocusDirection direction, View* currentView) override;
-    View* getDefaultFocus() override;
-    enum Sound getFocusSound() override;
-    Rect getVisibleFrame();
-
-    /**
-     * Sets the content view of this scrolling box. There can only be one
-     * content view per scrolling box at a time.
-     */
-    void setContentView(View* view);
-
-    /**
-     * Sets the scrolling behavior of this scrolling frame.
-     * Default is NATURAL.
-     */
-    void setScrollingBehavior(ScrollingBehavior behavior);
 
     /**
      * The point at which the origin of the content view is offset from the origin of the scroll view.
      */
     float getContentOffsetX() const
     {
-        return contentOffsetX;
+        return getContentOffset();
     }
 
     /**
@@ -76,47 +44,9 @@ class HScrollingFrame : public Box
      */
     void setContentOffsetX(float value, bool animated);
 
-    void setScrollingIndicatorVisible(bool visible)
-    {
-        showScrollingIndicator = visible;
-    }
-
-    static View* create();
-
-  private:
-    View* contentView             = nullptr;
-    Rectangle* scrollingIndicator = nullptr;
-
-    bool updateScrollingOnNextFrame = false;
-    bool childFocused               = false;
-    bool showScrollingIndicator     = true;
-
-    float middleX = 0; // y + height/2
-    float rightX = 0; // y + height
-
-    Animatable contentOffsetX = 0.0f;
-
-    void prebakeScrolling();
-    bool updateScrolling(bool animated);
-    void startScrolling(bool animated, float newScroll);
-    void animateScrolling(float newScroll, float time);
-    void scrollAnimationTick();
-
-    float getScrollingAreaLeftBoundary();
-    float getScrollingAreaWidth();
-
     float getContentWidth();
 
-    ScrollingBehavior behavior = ScrollingBehavior::NATURAL;
-    bool naturalScrollingCanScroll = false;
-    void naturalScrollingBehaviour();
-    void naturalScrollingButtonProcessing(FocusDirection focusDirection, bool* repeat);
-    View* findLeftMostFocusableView();
-
-    void setupScrollingIndicator();
-    void updateScrollingIndicatior();
-
-    Event<InputType>::Subscription inputTypeSubscription;
+    static View* create();
 };
 
 } // namespace brls
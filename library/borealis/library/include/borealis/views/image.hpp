@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <borealis/core/animation.hpp>
 #include <borealis/core/view.hpp>
 
 namespace brls
@@ -81,6 +82,20 @@ class Image : public View
      */
     void setInterpolation(ImageInterpolation interpolation);
 
+    /**
+     * If set to true, images set with setImageFromFile() and setImageFromRes()
+     * are decoded on a worker thread instead of blocking the frame.
+     * Nothing is drawn until the image is ready, then it fades in.
+     * Images already in the TextureCache are still set immediately.
+     *
+     * If you are using the asyncLoading XML attribute, you have to set it before the
+     * actual image attribute.
+     *
+     * Default is false.
+     */
+    void setAsyncLoading(bool async);
+    bool getAsyncLoading();
+
     /**
      * Sets the image from the given resource name.
      *
@@ -97,6 +112,20 @@ class Image : public View
      */
     void setImageFromFile(const std::string& path);
 
+    /**
+     * Starts decoding the given resource in the background, so that
+     * setImageFromRes() with the same name later hits the TextureCache.
+     * Meant for recycler data sources prefetching the rows about to be displayed.
+     *
+     * Returns an identifier to give to ImageLoader::cancel(), or 0 if the image is already cached.
+     */
+    static size_t prefetchRes(const std::string& name);
+
+    /**
+     * Same as prefetchRes(), for setImageFromFile().
+     */
+    static size_t prefetchFile(const std::string& path);
+
     /**
      * Sets the image from memory.
      *
@@ -107,6 +136,10 @@ class Image : public View
 
     virtual void innerSetImage(int texture);
 
+    /**
+     * Sets the image from data fetched by the given function, on any thread.
+     * The image is decoded on a worker thread.
+     */
     void setImageAsync(std::function<void(std::function<void(const std::string&, size_t length)>)> cb);
 
     void clear();
@@ -154,6 +187,13 @@ class Image : public View
     int getImageFlags();
     size_t checkCache(const std::string& path);
 
+    bool asyncLoading  = false;
+    size_t pendingLoad = 0; // ImageLoader request, if any
+    Animatable textureAlpha = 1.0f;
+
+    void loadAsync(const std::string& key, const unsigned char* data, size_t size);
+    void cancelAsyncLoad();
+
     float originalImageWidth  = 0;
     float originalImageHeight = 0;
 
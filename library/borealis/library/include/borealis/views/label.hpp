@@ -20,6 +20,7 @@
 #include <borealis/core/animation.hpp>
 #include <borealis/core/timer.hpp>
 #include <borealis/core/view.hpp>
+#include <vector>
 #ifdef OPENCC
 #define Opencc_BUILT_AS_STATIC
 #include <opencc.h>
@@ -144,6 +145,18 @@ class Label : public View
      */
     void setIsWrapping(bool isWrapping);
 
+    /**
+     * Internal, used by the measure function: bounds of the full text
+     * on a single line, measured once until the text or its style changes.
+     */
+    const float* getTextBounds();
+
+    /**
+     * Internal, used by the measure function: height of the full text
+     * wrapped at the given width, cached for the last width.
+     */
+    float getWrappedTextHeight(float width);
+
     /**
      * Simplified Chinese to Traditional Chinese
      */
@@ -190,6 +203,47 @@ class Label : public View
 
     enum NVGalign getNVGHorizontalAlign();
     enum NVGalign getNVGVerticalAlign();
+
+    // Text laid out by the glyph cache
+    enum class TextRun
+    {
+        NONE,
+        FULL,
+        TRUNCATED,
+        WRAPPED,
+    };
+
+    // Shaped text, kept from frame to frame until the text or its style changes,
+    // so that measuring, truncating and drawing a label does not go through
+    // fontstash again every time
+    struct TextCache
+    {
+        bool measured       = false;
+        float bounds[4]     = {}; // full text on a single line
+        bool wrapped        = false;
+        float wrappedWidth  = 0;
+        float wrappedHeight = 0;
+
+        // Glyph positions of the full text, to truncate it
+        std::vector<NVGglyphPosition> glyphs;
+        float truncatedWidth = -1;
+
+        // Glyph quads of the last drawn text, valid while the key below
+        // and the font atlas generation are the same
+        std::vector<NVGglyphQuad> quads;
+        int quadCount  = 0;
+        TextRun run    = TextRun::NONE;
+        int align      = 0;
+        float runWidth = 0;
+        float scale    = 0;
+        int generation = 0;
+    };
+
+    TextCache textCache;
+
+    void invalidateTextCache();
+    void setupTextStyle(NVGcontext* vg, int align);
+    bool layoutTextQuads(NVGcontext* vg, TextRun run, int align, float width);
 };
 
 } // namespace brls
@@ -24,6 +24,7 @@
 #include <borealis/views/scrolling_frame.hpp>
 #include <functional>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace brls
@@ -88,10 +89,17 @@ class RecyclerCell : public Box
 
     void onFocusGained() override;
     void onFocusLost() override;
+    View* getNextFocus(FocusDirection direction, View* currentView) override;
 
   private:
+    friend class RecyclerFrame;
+
     IndexPath indexPath;
     Event<InputType>::Subscription subscription;
+
+    // Set by the recycler frame: pool of the cell, and its index while in the content box
+    size_t reuseHandle   = 0;
+    size_t recyclerIndex = 0;
 };
 
 class RecyclerHeader
@@ -134,13 +142,15 @@ class RecyclerDataSource
     virtual RecyclerCell* cellForHeader(RecyclerFrame* recycler, int section);
 
     /*
-     * Asks the data source for the height to use for a row in a specified location.
+     * Asks the data source for the height to use for a row in a specified location,
+     * its width in horizontal recycler frames.
      * Return -1 to use autoscaling.
      */
     virtual float heightForRow(RecyclerFrame* recycler, IndexPath index) { return -1; }
 
     /*
-     * Asks the data source for the height to use for the header of a particular section.
+     * Asks the data source for the height to use for the header of a particular section,
+     * its width in horizontal recycler frames.
      * Return -1 to use autoscaling.
      */
     virtual float heightForHeader(RecyclerFrame* recycler, int section);
@@ -155,6 +165,19 @@ class RecyclerDataSource
      */
     virtual void didSelectRowAt(RecyclerFrame* recycler, IndexPath index) { }
 
+    /*
+     * Tells the data source to start loading the content of rows that are about
+     * to be displayed, for instance with brls::async() or Image::prefetchRes().
+     * Rows are given in the order they will appear.
+     */
+    virtual void prefetchRowsAt(RecyclerFrame* recycler, const std::vector<IndexPath>& indexPaths) { }
+
+    /*
+     * Tells the data source that rows given to prefetchRowsAt() went out of
+     * the lookahead before being displayed.
+     */
+    virtual void cancelPrefetchingForRowsAt(RecyclerFrame* recycler, const std::vector<IndexPath>& indexPaths) { }
+
     virtual ~RecyclerDataSource() = default;
 };
 
@@ -168,14 +191,19 @@ class RecyclerContentBox : public Box
     RecyclerFrame* recycler;
 };
 
-// Custom Box for propper recycling navigation
-class RecyclerFrame : public ScrollingFrame
+// Custom Box for propper recycling navigation.
+//
+// Rows are laid out in lines along the scrolling axis, and the rows of a line
+// next to each other across it: RecyclerFrame scrolls vertically through lines
+// of columns, HRecyclerFrame horizontally through lines of rows.
+class RecyclerFrame : public BaseScrollingFrame
 {
   public:
     RecyclerFrame();
     ~RecyclerFrame();
 
     View* getNextCellFocus(FocusDirection direction, View* currentView);
+    FocusGraphMode getFocusGraphMode() override;
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     void onLayout() override;
     void setPadding(float padding) override;
@@ -205,22 +233,97 @@ class RecyclerFrame : public ScrollingFrame
 
     /*
      * Registers a class for use in creating new recycler cells.
+     * warmUp cells are allocated right away, so that scrolling does not have to.
+     *
+     * Returns a handle that can be given to dequeueReusableCell() instead of the identifier.
      */
-    void registerCell(std::string identifier, std::function<RecyclerCell*(void)> allocation);
+    size_t registerCell(std::string identifier, std::function<RecyclerCell*(void)> allocation, size_t warmUp = 0);
 
     /*
      * Returns a reusable recycler-frame cell object for the specified reuse identifier
      */
-    RecyclerCell* dequeueReusableCell(std::string identifier);
+    RecyclerCell* dequeueReusableCell(const std::string& identifier);
+
+    /*
+     * Same as above, with the handle returned by registerCell().
+     */
+    RecyclerCell* dequeueReusableCell(size_t handle);
 
     /*
      * Selects a row in the recycler frame identified by index path.
      */
     void selectRowAt(IndexPath indexPath, bool animated);
 
+    /*
+     * Inserts rows at the given index paths, keeping the scroll position and the focus.
+     * The data source must already contain the new rows, and the index paths
+     * refer to the rows after the insertion.
+     *
+     * Only rows can be updated this way: use reloadData() if the sections change.
+     */
+    void insertRows(std::vector<IndexPath> indexPaths);
+
+    /*
+     * Deletes the rows at the given index paths, keeping the scroll position and the focus.
+     * The data source must not contain the rows anymore, and the index paths
+     * refer to the rows before the deletion.
+     */
+    void deleteRows(std::vector<IndexPath> indexPaths);
+
+    /*
+     * Asks the data source again for the cells and heights of the given rows.
+     */
+    void reloadRows(std::vector<IndexPath> indexPaths);
+
+    /*
+     * Moves a row, keeping its cell. The data source must already reflect the move.
+     */
+    void moveRow(IndexPath from, IndexPath to);
+
+    /*
+     * Lays the rows out in a grid of the given number of columns, 1 being a list.
+     * Section headers always take a full line. Cells are as wide as a column.
+     *
+     * In horizontal recycler frames, columns are taken across the scrolling axis:
+     * they are the rows of the grid, and cells are as high as one of them.
+     */
+    void setColumns(size_t columns);
+
+    /*
+     * Lays the rows out in as many columns of at least the given width (height in
+     * horizontal recycler frames) as fit in the recycler frame.
+     * 0 to use the number of columns set by setColumns().
+     */
+    void setMinColumnWidth(float width);
+
+    /*
+     * Returns the number of columns in use.
+     */
+    size_t getColumns();
+
+    /*
+     * Spacing between the columns of a grid.
+     */
+    void setColumnSpacing(float spacing);
+
+    /*
+     * Spacing after each line of rows, along the scrolling axis.
+     */
+    void setRowSpacing(float spacing);
+
+    /*
+     * Number of lines past the visible ones, in the scrolling direction, given to
+     * the data source for prefetching. The lookahead grows with the scrolling speed.
+     * 0 disables prefetching.
+     *
+     * Default is 2.
+     */
+    void setPrefetchLines(size_t lines);
+
     /*
      * Used for initial recycler's frame calculation if rows autoscaling selected.
      * To provide more accurate height implement DataSource->cellHeightForRow().
+     * Widths are estimated with it in horizontal recycler frames.
      */
     float estimatedRowHeight = 44;
 
@@ -234,8 +337,23 @@ class RecyclerFrame : public ScrollingFrame
         this->defaultCellFocus = indexPath;
     }
 
+    /**
+     * Same as ScrollingFrame, the offset is along the scrolling axis (see getAxis()).
+     */
+    float getContentOffsetY() const
+    {
+        return getContentOffset();
+    }
+
+    void setContentOffsetY(float value, bool animated);
+
+    float getContentHeight();
+
     static View* create();
 
+  protected:
+    RecyclerFrame(Axis axis);
+
   private:
     RecyclerDataSource* dataSource = nullptr;
     bool deleteDataSource          = false;
@@ -250,20 +368,119 @@ class RecyclerFrame : public ScrollingFrame
     float paddingBottom = 0;
     float paddingLeft   = 0;
 
+    size_t columns       = 1;
+    float minColumnWidth = 0;
+    float columnSpacing  = 0;
+    float rowSpacing     = 0;
+
     Box* contentBox;
-    Rect renderedFrame;
-    std::vector<Size> cacheFramesData;
-    std::vector<IndexPath> cacheIndexPathData;
-    std::map<std::string, std::vector<RecyclerCell*>*> queueMap;
-    std::map<std::string, std::function<RecyclerCell*(void)>> allocationMap;
 
-    bool checkWidth();
+    // Lines that have cells, along the scrolling axis, without padding
+    float renderedStart = 0;
+    float renderedEnd   = 0;
+
+    // Size of the content the rows were laid out for, across the scrolling axis
+    float lastCrossSize = 0;
+
+    // Size of each row along the scrolling axis
+    std::vector<float> cacheRowSizeData;
+    std::vector<IndexPath> cacheIndexPathData;
+    std::vector<size_t> cacheSectionStartData;
+
+    // Rows are laid out in lines of up to getColumns() rows.
+    // cacheLineStartData holds the first row of each line, then the number of rows.
+    std::vector<size_t> cacheLineStartData;
+    std::vector<size_t> cacheLineData;
+    std::vector<float> cacheLineHeightData;
+
+    // Cells in the content box, ordered by index from visibleMin to visibleMax.
+    // A vector rather than a deque: it stops allocating once it reached its capacity.
+    std::vector<RecyclerCell*> visibleCells;
+
+    // Fenwick tree over cacheLineHeightData, 1-based
+    std::vector<double> lineOffsetTree;
+
+    // Rows given to the data source for prefetching, from prefetchMin to prefetchMax excluded
+    size_t prefetchLines    = 2;
+    size_t prefetchMin      = 0;
+    size_t prefetchMax      = 0;
+    float lastVisibleOffset = 0;
+    bool scrollingDown      = true;
+    std::vector<IndexPath> prefetchedRows;
+    std::vector<IndexPath> cancelledRows;
+
+    // State of the rows update in progress
+    RecyclerCell* updateAnchor = nullptr;
+    std::vector<std::pair<size_t, RecyclerCell*>> staleCells;
+    struct CellPool
+    {
+        std::string identifier;
+        std::function<RecyclerCell*(void)> allocation;
+        std::vector<RecyclerCell*> cells;
+    };
+
+    std::vector<CellPool> cellPools;
+    std::unordered_map<std::string, size_t> cellPoolHandles;
+
+    bool checkCrossSize();
+
+    // The lines are computed along the scrolling axis: sizes and offsets are taken along it,
+    // "cross" ones across it. Padding of the recycler frame before and after the lines
+    // and on each side of them.
+    bool isVertical();
+    float getMainSize(View* view);
+    float getCrossSize(View* view);
+    float getPaddingStart();
+    float getPaddingEnd();
+    float getCrossPaddingStart();
+    float getCrossPaddingEnd();
+    float getVisibleStart();
+    float getVisibleEnd();
+    float getCellOffset(RecyclerCell* cell);
+    float getCellCrossOffset(RecyclerCell* cell);
+    void setCellOffsets(RecyclerCell* cell, float offset, float crossOffset);
+    void updateContentSize();
 
     void cacheCellFrames();
+    void cacheLines();
+    float queryRowHeight(IndexPath indexPath);
+    float getLineHeight(size_t index, float rowHeight);
+    size_t getLineCount();
     void cellsRecyclingLoop();
+    void updatePrefetching(float visibleStart);
+    void cancelPrefetching();
     void queueReusableCell(RecyclerCell* cell);
+    RecyclerCell* allocateCell(size_t handle);
+
+    /*
+     * Offset of the top of the given line, without padding. O(log n).
+     */
+    float getLineOffset(size_t line);
+
+    /*
+     * Line containing the given offset, without padding. O(log n).
+     */
+    size_t getLineAt(float offset);
+
+    void buildLineOffsets();
+    void updateLineHeight(size_t line, float delta);
+
+    size_t getRowIndex(IndexPath indexPath);
+    size_t getSectionEnd(size_t section);
+
+    void beginUpdates();
+    void endUpdates();
+    void insertCachedRow(size_t index, IndexPath indexPath, float height, RecyclerCell* cell);
+    RecyclerCell* eraseCachedRow(size_t index);
+    RecyclerCell* takeCellAt(size_t index);
+
+    RecyclerCell* getCellAt(size_t index);
+    void recycleAllCells();
+    void restartCellsAt(size_t line);
 
-    void addCellAt(size_t index, size_t downSide);
+    void addLineAt(size_t line, bool downSide, std::map<size_t, RecyclerCell*>* keptCells = nullptr);
+    RecyclerCell* createCellAt(size_t index);
+    void placeCell(RecyclerCell* cell, size_t index);
     void removeCell(View* view);
 };
 
@@ -19,6 +19,7 @@
 
 #include <borealis/core/animation.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/scroll_engine.hpp>
 #include <borealis/views/rectangle.hpp>
 
 namespace brls
@@ -34,15 +35,18 @@ enum class ScrollingBehavior
     CENTERED,
 };
 
-// A vertical-only frame that can scroll if its content overflows.
+// A frame that can scroll along one axis if its content overflows.
 // This frame can only contain one child view.
 // The content view is detached from the rest of the tree
-// so that its height can grow as much as possible.
-class ScrollingFrame : public Box
+// so that it can grow as much as possible along the scrolling axis.
+//
+// The scrolling itself is handled by a ScrollEngine: touch drags follow the finger
+// with a rubber band past the edges and continue with inertia once released.
+// Use ScrollingFrame or HScrollingFrame.
+class BaseScrollingFrame : public Box
 {
   public:
-    ScrollingFrame();
-    ~ScrollingFrame();
+    ~BaseScrollingFrame();
 
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     void onFocusGained() override;
@@ -60,6 +64,7 @@ class ScrollingFrame : public Box
     View* getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction) override;
     View* getNextFocus(FocusDirection direction, View* currentView) override;
     View* getDefaultFocus() override;
+    FocusGraphMode getFocusGraphMode() override;
     enum Sound getFocusSound() override;
     Rect getVisibleFrame();
 
@@ -76,26 +81,52 @@ class ScrollingFrame : public Box
     void setScrollingBehavior(ScrollingBehavior behavior);
 
     /**
-     * The point at which the origin of the content view is offset from the origin of the scroll view.
+     * Allows touch scrolling to go past the edges of the content, with a rubber band effect.
+     * Default is true.
      */
-    float getContentOffsetY() const
+    void setOverscrollEnabled(bool enabled);
+
+    /**
+     * Returns the axis this frame scrolls along.
+     */
+    Axis getAxis() const
     {
-        return contentOffsetY;
+        return axis;
+    }
+
+    /**
+     * The point at which the origin of the content view is offset from the origin
+     * of the scroll view, along the scrolling axis.
+     */
+    float getContentOffset() const
+    {
+        return scroller.getOffset();
     }
 
     /**
      * Sets the offset from the content view’s origin that corresponds to the receiver’s origin.
      */
-    void setContentOffsetY(float value, bool animated);
+    void setContentOffset(float value, bool animated);
+
+    /**
+     * Scrolls by the smallest distance that makes the given rect, in the content view
+     * coordinates, visible. If the rect is larger than the frame, its start is shown.
+     */
+    void scrollToRect(Rect rect, bool animated);
+
+    /**
+     * Same as scrollToRect() with the frame of a view of the content.
+     */
+    void scrollToView(View* view, bool animated);
 
     void setScrollingIndicatorVisible(bool visible)
     {
         showScrollingIndicator = visible;
     }
 
-    static View* create();
-
   protected:
+    BaseScrollingFrame(Axis axis);
+
     View* contentView             = nullptr;
     Rectangle* scrollingIndicator = nullptr;
 
@@ -103,32 +134,65 @@ class ScrollingFrame : public Box
     bool childFocused               = false;
     bool showScrollingIndicator     = true;
 
-    float middleY = 0; // y + height/2
-    float bottomY = 0; // y + height
-
-    Animatable contentOffsetY = 0.0f;
+    ScrollEngine scroller;
 
-    void prebakeScrolling();
     bool updateScrolling(bool animated);
     void startScrolling(bool animated, float newScroll);
-    void animateScrolling(float newScroll, float time);
+    void updateScrollRange();
     void scrollAnimationTick();
 
-    float getScrollingAreaTopBoundary();
-    float getScrollingAreaHeight();
+    float getScrollingAreaStart();
+    float getScrollingAreaSize();
 
-    float getContentHeight();
+    float getContentSize();
+
+    // Frame of a view of the content, in the content view coordinates
+    bool getFrameInContent(View* view, Rect* frame);
 
-    ScrollingBehavior behavior = ScrollingBehavior::NATURAL;
+    ScrollingBehavior behavior     = ScrollingBehavior::NATURAL;
     bool naturalScrollingCanScroll = false;
+    bool naturalScrollingRepeat    = false;
     void naturalScrollingBehaviour();
-    void naturalScrollingButtonProcessing(FocusDirection focusDirection, bool* repeat);
-    View* findTopMostFocusableView();
+    void naturalScrollingButtonProcessing(FocusDirection focusDirection);
+    View* findFirstFocusableView();
 
     void setupScrollingIndicator();
     void updateScrollingIndicatior();
 
     Event<InputType>::Subscription inputTypeSubscription;
+
+  private:
+    Axis axis;
+
+    float getMainAxis(Point point);
+    float getMainAxis(Size size);
+};
+
+// A vertical-only frame that can scroll if its content overflows.
+// This frame can only contain one child view.
+// The content view is detached from the rest of the tree
+// so that its height can grow as much as possible.
+class ScrollingFrame : public BaseScrollingFrame
+{
+  public:
+    ScrollingFrame();
+
+    /**
+     * The point at which the origin of the content view is offset from the origin of the scroll view.
+     */
+    float getContentOffsetY() const
+    {
+        return getContentOffset();
+    }
+
+    /**
+     * Sets the offset from the content view’s origin that corresponds to the receiver’s origin.
+     */
+    void setContentOffsetY(float value, bool animated);
+
+    float getContentHeight();
+
+    static View* create();
 };
 
 } // namespace brls
@@ -43,6 +43,9 @@ void Activity::setContentView(View* view)
 
     this->contentView = view;
     this->contentView->setParentActivity(this);
+
+    if (this->focusGraph)
+        this->focusGraph->invalidate();
     // willAppear is only called when the activity is pushed onto the stack
 
     this->resizeToFitWindow();
@@ -54,6 +57,7 @@ void Activity::resizeToFitWindow()
         return;
 
     this->contentView->setDimensions(Application::contentWidth, Application::contentHeight);
+    this->contentView->layoutIfNeeded();
 }
 
 View* Activity::createContentView()
@@ -155,6 +159,24 @@ View* Activity::getDefaultFocus()
     return this->contentView->getDefaultFocus();
 }
 
+void Activity::setSpatialNavigationEnabled(bool enabled)
+{
+    if (enabled && !this->focusGraph)
+        this->focusGraph = std::make_unique<FocusGraph>();
+    else if (!enabled)
+        this->focusGraph.reset();
+}
+
+bool Activity::isSpatialNavigationEnabled()
+{
+    return this->focusGraph != nullptr;
+}
+
+FocusGraph* Activity::getFocusGraph()
+{
+    return this->focusGraph.get();
+}
+
 void Activity::setAlpha(float alpha)
 {
     if (this->contentView)
@@ -16,6 +16,7 @@
 
 #include <borealis/core/animation.hpp>
 #include <borealis/core/application.hpp>
+#include <borealis/core/profiler.hpp>
 #include <vector>
 
 namespace brls
@@ -28,7 +29,18 @@ Animatable::Animatable(float value)
 
 void Animatable::onReset()
 {
-    this->tween = tweeny::tween<float>::from(this->currentValue);
+    this->tweenReset = true;
+}
+
+tweeny::tween<float>& Animatable::getTween()
+{
+    if (this->tweenReset)
+    {
+        this->tween      = tweeny::tween<float>::from(this->currentValue);
+        this->tweenReset = false;
+    }
+
+    return this->tween;
 }
 
 void Animatable::reset(float initialValue)
@@ -44,27 +56,28 @@ void Animatable::reset()
 
 void Animatable::onRewind()
 {
-    this->currentValue = this->tween.seek(0);
+    this->currentValue = this->getTween().seek(0);
 }
 
 void Animatable::addStep(float targetValue, int32_t duration, EasingFunction easing)
 {
-    this->tween.to(targetValue).during(duration).via(easing);
+    this->getTween().to(targetValue).during(duration).via(easing);
 }
 
 float Animatable::getProgress()
 {
-    return this->tween.progress();
+    return this->getTween().progress();
 }
 
 bool Animatable::onUpdate(retro_time_t delta)
 {
-    if (this->tween.progress() >= 1.0f || this->tween.duration() <= 0)
+    tweeny::tween<float>& tween = this->getTween();
+    if (tween.progress() >= 1.0f || tween.duration() <= 0)
         return false;
     
     // int32_t for stepping works as long as the app goes faster than 0.00001396983 FPS
     // (in which case the delta for a frame wraps in an int32_t)
-    this->currentValue = this->tween.step((int32_t)delta);
+    this->currentValue = tween.step((int32_t)delta);
     return true;
 }
 
@@ -104,6 +117,8 @@ void updateHighlightAnimation()
     if (!Application::hasActiveEvent())
         return;
 
+    BRLS_PROFILE_ZONE("highlight");
+
     Time currentTime = getCPUTimeUsec() / 1000;
 
     // Update variables
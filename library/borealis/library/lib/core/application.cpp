@@ -27,6 +27,8 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/image_loader.hpp>
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/util.hpp>
@@ -37,6 +39,7 @@
 #include <borealis/views/cells/cell_radio.hpp>
 #include <borealis/views/cells/cell_selector.hpp>
 #include <borealis/views/cells/cell_slider.hpp>
+#include <borealis/views/h_recycler.hpp>
 #include <borealis/views/h_scrolling_frame.hpp>
 #include <borealis/views/header.hpp>
 #include <borealis/views/hint.hpp>
@@ -68,6 +71,9 @@
 namespace brls
 {
 
+// Looked up on every frame
+static const ThemeKey THEME_CLEAR("brls/clear");
+
 bool Application::init()
 {
     Application::inited        = false;
@@ -149,7 +155,12 @@ void Application::createWindow(std::string windowTitle)
             return;
 
         if (eventType == facebook::yoga::Event::NodeLayout)
-            view->onLayout(); });
+        {
+            // The layout pass is not over yet, absolute positions cached
+            // before it would be stale in onLayout()
+            View::invalidateGeometry();
+            view->onLayout();
+        } });
 
     // Load fonts and setup fallbacks
     Application::platform->getFontLoader()->loadFonts();
@@ -171,8 +182,17 @@ bool Application::internalMainLoop()
     Application::frameStartTime = getCPUTimeUsec();
     Application::setActiveEvent(false);
 
+    BRLS_PROFILE_FRAME_BEGIN();
+
     // Main loop callback
-    if (!Application::platform->mainLoopIteration() || Application::quitRequested)
+    BRLS_PROFILE_BEGIN("platform");
+    bool running = Application::platform->mainLoopIteration();
+    BRLS_PROFILE_END();
+
+    Time platformEndTime               = getCPUTimeUsec();
+    Application::frameTimings.platform = platformEndTime - frameStartTime;
+
+    if (!running || Application::quitRequested)
     {
         Application::getWindowShouldCloseEvent()->fire();
         Application::exit();
@@ -191,23 +211,59 @@ bool Application::internalMainLoop()
             Application::getAudioPlayer()->play(Sound::SOUND_CLICK_ERROR);
     }
 
+    Time inputEndTime               = getCPUTimeUsec();
+    Application::frameTimings.input = inputEndTime - platformEndTime;
+
     // Animations
 #ifndef SIMPLE_HIGHLIGHT
     updateHighlightAnimation();
 #endif
+    if (!Ticking::runningTickings.empty())
+        Application::requestRedraw();
     Ticking::updateTickings();
 
+    Time animationEndTime               = getCPUTimeUsec();
+    Application::frameTimings.animation = animationEndTime - inputEndTime;
+
+    // Create the textures of the images decoded in the background
+    ImageLoader::instance().processUploads();
+
+    Time uploadsEndTime               = getCPUTimeUsec();
+    Application::frameTimings.uploads = uploadsEndTime - animationEndTime;
+
+    // Layout everything that changed since last frame
+    Application::flushLayout();
+
+    Time layoutEndTime               = getCPUTimeUsec();
+    Application::frameTimings.layout = layoutEndTime - uploadsEndTime;
+
     // Render
-    Application::frame();
+    bool redraw = Application::needsRedraw();
+    if (redraw)
+    {
+        Application::redrawRequested = false;
+        Application::frame();
+
+        Application::frameTimings.draw    = presentStartTime - layoutEndTime;
+        Application::frameTimings.present = getCPUTimeUsec() - presentStartTime;
+    }
+    else
+    {
+        Application::frameTimings.draw    = 0;
+        Application::frameTimings.present = 0;
+    }
 
     // Run sync functions
     Threading::performSyncTasks();
 
     // Trigger RunLoop subscribers
+    BRLS_PROFILE_BEGIN("run loop event");
     runLoopEvent.fire();
+    BRLS_PROFILE_END();
 
     // Free views deletion pool.
     // A view deletion might inserts other views to deletionPool
+    BRLS_PROFILE_BEGIN("deletion pool");
     std::deque<View*> undeletedViews;
     for (auto view : Application::deletionPool)
     {
@@ -222,11 +278,19 @@ bool Application::internalMainLoop()
         }
     }
     Application::deletionPool = undeletedViews;
+    BRLS_PROFILE_END();
+
+    BRLS_PROFILE_FRAME_END();
+
+    // Nothing was drawn so the swap interval did not pace this iteration
+    Time frameTime = Application::limitedFrameTime;
+    if (!redraw && frameTime <= 0)
+        frameTime = 1000000 / 60;
 
-    if (Application::limitedFrameTime > 0)
+    if (frameTime > 0)
     {
         Time deltaTime = getCPUTimeUsec() - frameStartTime;
-        Time interval  = Application::limitedFrameTime - deltaTime;
+        Time interval  = frameTime - deltaTime;
         if (interval > 0)
         {
             std::this_thread::sleep_for(std::chrono::microseconds(interval));
@@ -257,6 +321,8 @@ const ControllerState& Application::getControllerState()
 
 void Application::processInput()
 {
+    BRLS_PROFILE_ZONE("input");
+
     static ControllerState oldControllerState = {};
 
     // Input
@@ -553,8 +619,13 @@ void Application::navigate(FocusDirection direction, bool repeating)
     // (in which case there is nothing to traverse)
     else if (currentFocus->hasParent())
     {
-        // Get next view to focus by traversing the views tree upwards
-        nextFocus = currentFocus->getNextFocus(direction, currentFocus);
+        // Get next view to focus from the frames if the activity uses the spatial navigation,
+        // otherwise (or if the view is not in the graph) by traversing the views tree upwards
+        Activity* activity = Application::activitiesStack.empty() ? nullptr : Application::activitiesStack.back();
+        FocusGraph* graph  = activity ? activity->getFocusGraph() : nullptr;
+
+        if (!graph || !graph->getNextFocus(activity->getContentView(), currentFocus, direction, &nextFocus))
+            nextFocus = currentFocus->getNextFocus(direction, currentFocus);
     }
 
     // No view to focus at the end of the traversal: wiggle and return
@@ -661,6 +732,10 @@ bool Application::hasActiveEvent()
 
 void Application::setActiveEvent(bool value)
 {
+    // Any event can change what is on screen
+    if (value)
+        Application::redrawRequested = true;
+
 #ifndef __SWITCH__
     Application::activeEvent = value;
     if (value)
@@ -670,6 +745,36 @@ void Application::setActiveEvent(bool value)
 #endif
 }
 
+void Application::setRetainedRendering(bool value)
+{
+    Application::retainedRendering = value;
+    Application::redrawRequested   = true;
+}
+
+bool Application::getRetainedRendering()
+{
+    return Application::retainedRendering;
+}
+
+void Application::requestRedraw()
+{
+    Application::redrawRequested = true;
+}
+
+bool Application::needsRedraw()
+{
+    if (!Application::retainedRendering || Application::redrawRequested || Application::debuggingViewEnabled)
+        return true;
+
+#ifndef SIMPLE_HIGHLIGHT
+    // The highlight is animated while the application is active
+    if (Application::currentFocus && Application::getInputType() != InputType::TOUCH && Application::hasActiveEvent())
+        return true;
+#endif
+
+    return false;
+}
+
 void Application::setDeactivatedTime(int millisecond)
 {
     Application::deactivatedTime = millisecond * 1000;
@@ -741,6 +846,8 @@ bool Application::handleAction(const ActionType type, const int button, const bo
 
 void Application::frame()
 {
+    BRLS_PROFILE_ZONE("draw");
+
     VideoContext* videoContext = Application::platform->getVideoContext();
 
     // Frame context
@@ -753,7 +860,7 @@ void Application::frame()
 
     // Begin frame and clear
     videoContext->beginFrame();
-    videoContext->clear(Application::getTheme().getColor("brls/clear"));
+    videoContext->clear(Application::getTheme().getColor(THEME_CLEAR));
     float scaleFactor = videoContext->getScaleFactor();
 
     nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, scaleFactor);
@@ -806,7 +913,10 @@ void Application::frame()
     nvgResetTransform(Application::getNVGContext()); // scale
     nvgEndFrame(Application::getNVGContext());
 
+    Application::presentStartTime = getCPUTimeUsec();
+    BRLS_PROFILE_BEGIN("present");
     Application::platform->getVideoContext()->endFrame();
+    BRLS_PROFILE_END();
 }
 
 void Application::exit()
@@ -860,6 +970,11 @@ size_t Application::getFPS()
     return Application::globalFPS;
 }
 
+const FrameTimings& Application::getFrameTimings()
+{
+    return Application::frameTimings;
+}
+
 void Application::setLimitedFPS(size_t fps)
 {
     Application::limitedFrameTime = fps == 0 ? 0 : 1000000.0f / fps;
@@ -895,6 +1010,7 @@ void Application::giveFocus(View* view)
         }
 
         Application::globalHintsUpdateEvent.fire();
+        Application::requestRedraw();
     }
 }
 
@@ -1060,6 +1176,35 @@ void Application::addToFreeQueue(View* view)
     Application::deletionPool.push_back(view);
 }
 
+void Application::requestLayout(View* root)
+{
+    Application::layoutQueue.push_back(root);
+}
+
+void Application::cancelLayout(View* root)
+{
+    auto it = std::find(layoutQueue.begin(), layoutQueue.end(), root);
+    if (it != layoutQueue.end())
+        *it = nullptr;
+}
+
+void Application::flushLayout()
+{
+    BRLS_PROFILE_ZONE("layout");
+
+    // A layout pass can invalidate other trees (a ScrollingFrame resizing
+    // its detached content view in onLayout() for instance), they are
+    // appended to the queue and handled in the same loop
+    for (size_t i = 0; i < Application::layoutQueue.size(); i++)
+    {
+        View* root = Application::layoutQueue[i];
+        if (root)
+            root->performPendingLayout();
+    }
+
+    Application::layoutQueue.clear();
+}
+
 void Application::tryDeinitFirstResponder(View* view)
 {
     if (!view)
@@ -1304,6 +1449,7 @@ void Application::registerBuiltInXMLViews()
     Application::registerXMLView("brls:ScrollingFrame", ScrollingFrame::create);
     Application::registerXMLView("brls:HScrollingFrame", HScrollingFrame::create);
     Application::registerXMLView("brls:RecyclerFrame", RecyclerFrame::create);
+    Application::registerXMLView("brls:HRecyclerFrame", HRecyclerFrame::create);
     Application::registerXMLView("brls:Image", Image::create);
     Application::registerXMLView("brls:Padding", Padding::create);
     Application::registerXMLView("brls:Button", Button::create);
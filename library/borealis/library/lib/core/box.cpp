@@ -18,6 +18,7 @@
 #include <tinyxml2.h>
 #include <yoga/YGNode.h>
 
+#include <algorithm>
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
 #include <borealis/core/util.hpp>
@@ -25,6 +26,17 @@
 #include <fstream>
 #include <functional>
 
+// Boxes with at least this many children hit test them through a grid
+#define HIT_TEST_GRID_MIN_CHILDREN 16
+
+// Margin added around the children frames in the grid, to absorb
+// rounding differences with the absolute frames
+#define HIT_TEST_GRID_MARGIN 0.5f
+
+// The grid is given up if the children are registered in more cells than this
+// many times their count on average, as they overlap too much to be told apart
+#define HIT_TEST_GRID_MAX_CELLS_PER_CHILD 8
+
 namespace brls
 {
 
@@ -48,60 +60,62 @@ Box::Box(Axis axis)
     // no need to invalidate if the box is empty and is not attached to any parent
 
     // Register XML attributes
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "axis", Axis, this->setAxis,
-        {
-            { "row", Axis::ROW },
-            { "column", Axis::COLUMN },
-        });
+    this->registerXMLAttributes<Box>([](XMLAttributes<Box>& attributes) {
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "axis", Axis, setAxis,
+            {
+                { "row", Axis::ROW },
+                { "column", Axis::COLUMN },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "direction", Direction, this->setDirection,
-        {
-            { "inherit", Direction::INHERIT },
-            { "leftToRight", Direction::LEFT_TO_RIGHT },
-            { "rightToLeft", Direction::RIGHT_TO_LEFT },
-        });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "direction", Direction, setDirection,
+            {
+                { "inherit", Direction::INHERIT },
+                { "leftToRight", Direction::LEFT_TO_RIGHT },
+                { "rightToLeft", Direction::RIGHT_TO_LEFT },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "justifyContent", JustifyContent, this->setJustifyContent,
-        {
-            { "flexStart", JustifyContent::FLEX_START },
-            { "center", JustifyContent::CENTER },
-            { "flexEnd", JustifyContent::FLEX_END },
-            { "spaceBetween", JustifyContent::SPACE_BETWEEN },
-            { "spaceAround", JustifyContent::SPACE_AROUND },
-            { "spaceEvenly", JustifyContent::SPACE_EVENLY },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "alignItems", AlignItems, this->setAlignItems,
-        {
-            { "auto", AlignItems::AUTO },
-            { "flexStart", AlignItems::FLEX_START },
-            { "center", AlignItems::CENTER },
-            { "flexEnd", AlignItems::FLEX_END },
-            { "stretch", AlignItems::STRETCH },
-            { "baseline", AlignItems::BASELINE },
-            { "spaceBetween", AlignItems::SPACE_BETWEEN },
-            { "spaceAround", AlignItems::SPACE_AROUND },
-        });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "justifyContent", JustifyContent, setJustifyContent,
+            {
+                { "flexStart", JustifyContent::FLEX_START },
+                { "center", JustifyContent::CENTER },
+                { "flexEnd", JustifyContent::FLEX_END },
+                { "spaceBetween", JustifyContent::SPACE_BETWEEN },
+                { "spaceAround", JustifyContent::SPACE_AROUND },
+                { "spaceEvenly", JustifyContent::SPACE_EVENLY },
+            });
+
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "alignItems", AlignItems, setAlignItems,
+            {
+                { "auto", AlignItems::AUTO },
+                { "flexStart", AlignItems::FLEX_START },
+                { "center", AlignItems::CENTER },
+                { "flexEnd", AlignItems::FLEX_END },
+                { "stretch", AlignItems::STRETCH },
+                { "baseline", AlignItems::BASELINE },
+                { "spaceBetween", AlignItems::SPACE_BETWEEN },
+                { "spaceAround", AlignItems::SPACE_AROUND },
+            });
 
-    // Padding
-    this->registerFloatXMLAttribute("paddingTop", [this](float value)
-        { this->setPaddingTop(value); });
+        // Padding
+        attributes.registerFloatXMLAttribute("paddingTop", [](Box* view, float value)
+            { view->setPaddingTop(value); });
 
-    this->registerFloatXMLAttribute("paddingRight", [this](float value)
-        { this->setPaddingRight(value); });
+        attributes.registerFloatXMLAttribute("paddingRight", [](Box* view, float value)
+            { view->setPaddingRight(value); });
 
-    this->registerFloatXMLAttribute("paddingBottom", [this](float value)
-        { this->setPaddingBottom(value); });
+        attributes.registerFloatXMLAttribute("paddingBottom", [](Box* view, float value)
+            { view->setPaddingBottom(value); });
 
-    this->registerFloatXMLAttribute("paddingLeft", [this](float value)
-        { this->setPaddingLeft(value); });
+        attributes.registerFloatXMLAttribute("paddingLeft", [](Box* view, float value)
+            { view->setPaddingLeft(value); });
 
-    this->registerFloatXMLAttribute("padding", [this](float value)
-        { this->setPadding(value); });
+        attributes.registerFloatXMLAttribute("padding", [](Box* view, float value)
+            { view->setPadding(value); });
+    });
 }
 
 Box::Box()
@@ -120,42 +134,48 @@ void Box::getCullingBounds(float* top, float* right, float* bottom, float* left)
 
 void Box::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
+    // Narrow the culling bounds given by our parents down to our own,
+    // nested boxes will do the same with the result
+    float parentTop    = ctx->cullingTop;
+    float parentRight  = ctx->cullingRight;
+    float parentBottom = ctx->cullingBottom;
+    float parentLeft   = ctx->cullingLeft;
+
+    float top, right, bottom, left;
+    this->getCullingBounds(&top, &right, &bottom, &left);
+
+    ctx->cullingTop    = std::max(top, parentTop);
+    ctx->cullingRight  = std::min(right, parentRight);
+    ctx->cullingBottom = std::min(bottom, parentBottom);
+    ctx->cullingLeft   = std::max(left, parentLeft);
+
     for (View* child : this->children)
     {
-        // Ensure that the child is in bounds of all parents before drawing it
-        // Only do that check for leaf views, as nested boxes will do that check themselves
-        if (!dynamic_cast<Box*>(child) && child->isCulled())
+        // Skip children that are out of bounds, nested boxes
+        // included: their whole subtree is skipped at once
+        if (child->isCulled())
         {
             float childTop    = child->getY();
             float childLeft   = child->getX();
             float childRight  = childLeft + child->getWidth();
             float childBottom = childTop + child->getHeight();
 
-            bool draw = true;
-
-            for (Box* bounds = this; bounds != nullptr; bounds = bounds->getParent())
-            {
-                float top, right, bottom, left;
-                bounds->getCullingBounds(&top, &right, &bottom, &left);
-
-                if (
-                    childBottom < top || // too high
-                    childRight < left || // too far left
-                    childLeft > right || // too far right
-                    childTop > bottom // too low
-                )
-                {
-                    draw = false;
-                    break;
-                }
-            }
-
-            if (!draw)
+            if (
+                childBottom < ctx->cullingTop || // too high
+                childRight < ctx->cullingLeft || // too far left
+                childLeft > ctx->cullingRight || // too far right
+                childTop > ctx->cullingBottom // too low
+            )
                 continue;
         }
 
         child->frame(ctx);
     }
+
+    ctx->cullingTop    = parentTop;
+    ctx->cullingRight  = parentRight;
+    ctx->cullingBottom = parentBottom;
+    ctx->cullingLeft   = parentLeft;
 }
 
 void Box::addView(View* view)
@@ -180,6 +200,8 @@ void Box::addView(View* view, size_t position)
     *userdata        = position;
 
     view->setParent(this, userdata);
+    this->childrenEpoch++;
+    View::layoutEpoch++;
 
     for (size_t i = position + 1; i < this->children.size(); i++)
     {
@@ -221,6 +243,8 @@ void Box::removeView(View* view, bool free)
     if (!view->isDetached())
         YGNodeRemoveChild(this->ygNode, view->getYGNode());
     this->children.erase(this->children.begin() + index);
+    this->childrenEpoch++;
+    View::layoutEpoch++;
 
     // Update parent userdata
     for (size_t i = index; i < this->children.size(); i++)
@@ -237,6 +261,23 @@ void Box::removeView(View* view, bool free)
     this->invalidate();
 }
 
+void Box::appendChild(View* view)
+{
+    this->children.push_back(view);
+    this->childrenEpoch++;
+}
+
+bool Box::eraseChild(View* view)
+{
+    auto it = std::find(this->children.begin(), this->children.end(), view);
+    if (it == this->children.end())
+        return false;
+
+    this->children.erase(it);
+    this->childrenEpoch++;
+    return true;
+}
+
 void Box::clearViews(bool free)
 {
     lastFocusedView          = nullptr;
@@ -249,6 +290,8 @@ void Box::clearViews(bool free)
         // Remove it
         YGNodeRemoveChild(this->ygNode, view->getYGNode());
         this->children.pop_back();
+        this->childrenEpoch++;
+        View::layoutEpoch++;
 
         view->willDisappear(true);
         if (free)
@@ -391,6 +434,37 @@ View* Box::hitTest(Point point)
     if (this->getFrame().pointInside(point))
     {
         //        Logger::debug(describe() + ": --- X: " + std::to_string((int)getX()) + ", Y: " + std::to_string((int)getY()) + ", W: " + std::to_string((int)getWidth()) + ", H: " + std::to_string((int)getHeight()));
+
+        // Children can only be hit inside of their frame: only try the ones of the grid cell under the point
+        if (this->children.size() >= HIT_TEST_GRID_MIN_CHILDREN)
+        {
+            this->updateHitTestGrid();
+
+            HitTestGrid* grid = this->hitTestGrid.get();
+            if (grid->usable)
+            {
+                float x = point.x - this->getX() - grid->bounds.getMinX();
+                float y = point.y - this->getY() - grid->bounds.getMinY();
+
+                if (x >= 0 && y >= 0 && x <= grid->bounds.getWidth() && y <= grid->bounds.getHeight())
+                {
+                    size_t column = std::min((size_t)(x / grid->cellWidth), grid->columns - 1);
+                    size_t row    = std::min((size_t)(y / grid->cellHeight), grid->rows - 1);
+                    size_t cell   = row * grid->columns + column;
+
+                    for (size_t i = grid->cells[cell + 1]; i > grid->cells[cell]; i--)
+                    {
+                        View* result = grid->views[i - 1]->hitTest(point);
+
+                        if (result)
+                            return result;
+                    }
+                }
+
+                return this;
+            }
+        }
+
         for (auto child = this->children.rbegin(); child != this->children.rend(); child++)
         {
             View* result = (*child)->hitTest(point);
@@ -406,6 +480,101 @@ View* Box::hitTest(Point point)
     return nullptr;
 }
 
+void Box::updateHitTestGrid()
+{
+    if (!this->hitTestGrid)
+        this->hitTestGrid = std::make_unique<HitTestGrid>();
+
+    HitTestGrid* grid = this->hitTestGrid.get();
+
+    if (grid->layoutEpoch == View::layoutEpoch && grid->childrenEpoch == this->childrenEpoch)
+        return;
+
+    grid->layoutEpoch   = View::layoutEpoch;
+    grid->childrenEpoch = this->childrenEpoch;
+    grid->usable        = false;
+
+    // Frames of the children relative to the Box, before collapsing (which only makes them smaller)
+    std::vector<Rect> frames;
+    frames.reserve(this->children.size());
+
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (View* child : this->children)
+    {
+        Rect frame = Rect(child->getLocalX() - HIT_TEST_GRID_MARGIN, child->getLocalY() - HIT_TEST_GRID_MARGIN,
+            child->getWidth() + HIT_TEST_GRID_MARGIN * 2, child->getHeight(false) + HIT_TEST_GRID_MARGIN * 2);
+
+        if (std::isnan(frame.getMinX()) || std::isnan(frame.getMinY()) || std::isnan(frame.getWidth()) || std::isnan(frame.getHeight()))
+            return;
+
+        minX = std::fmin(minX, frame.getMinX());
+        minY = std::fmin(minY, frame.getMinY());
+        maxX = std::fmax(maxX, frame.getMaxX());
+        maxY = std::fmax(maxY, frame.getMaxY());
+
+        frames.push_back(frame);
+    }
+
+    // As many cells as children, as square as possible
+    size_t count      = this->children.size();
+    float width       = maxX - minX;
+    float height      = maxY - minY;
+    grid->bounds      = Rect(minX, minY, width, height);
+    grid->columns     = std::clamp((size_t)std::round(std::sqrt(count * width / height)), (size_t)1, count);
+    grid->rows        = std::clamp((count + grid->columns - 1) / grid->columns, (size_t)1, count);
+    grid->cellWidth   = width / grid->columns;
+    grid->cellHeight  = height / grid->rows;
+
+    if (!(grid->cellWidth > 0) || !(grid->cellHeight > 0))
+        return;
+
+    // Cells covered by each child
+    auto range = [grid](const Rect& frame, size_t* firstColumn, size_t* lastColumn, size_t* firstRow, size_t* lastRow) {
+        *firstColumn = std::min((size_t)((frame.getMinX() - grid->bounds.getMinX()) / grid->cellWidth), grid->columns - 1);
+        *lastColumn  = std::min((size_t)((frame.getMaxX() - grid->bounds.getMinX()) / grid->cellWidth), grid->columns - 1);
+        *firstRow    = std::min((size_t)((frame.getMinY() - grid->bounds.getMinY()) / grid->cellHeight), grid->rows - 1);
+        *lastRow     = std::min((size_t)((frame.getMaxY() - grid->bounds.getMinY()) / grid->cellHeight), grid->rows - 1);
+    };
+
+    // Count the children of each cell first, then fill them
+    size_t cellsCount = grid->columns * grid->rows;
+    grid->cells.assign(cellsCount + 1, 0);
+
+    size_t total = 0;
+    for (const Rect& frame : frames)
+    {
+        size_t firstColumn, lastColumn, firstRow, lastRow;
+        range(frame, &firstColumn, &lastColumn, &firstRow, &lastRow);
+
+        for (size_t row = firstRow; row <= lastRow; row++)
+            for (size_t column = firstColumn; column <= lastColumn; column++)
+                grid->cells[row * grid->columns + column + 1]++;
+
+        total += (lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+    }
+
+    if (total > count * HIT_TEST_GRID_MAX_CELLS_PER_CHILD)
+        return;
+
+    for (size_t cell = 0; cell < cellsCount; cell++)
+        grid->cells[cell + 1] += grid->cells[cell];
+
+    std::vector<uint32_t> next(grid->cells.begin(), grid->cells.end() - 1);
+    grid->views.resize(total);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t firstColumn, lastColumn, firstRow, lastRow;
+        range(frames[i], &firstColumn, &lastColumn, &firstRow, &lastRow);
+
+        for (size_t row = firstRow; row <= lastRow; row++)
+            for (size_t column = firstColumn; column <= lastColumn; column++)
+                grid->views[next[row * grid->columns + column]++] = this->children[i];
+    }
+
+    grid->usable = true;
+}
+
 View* Box::getNextFocus(FocusDirection direction, View* currentView)
 {
     void* parentUserData = currentView->getParentUserData();
@@ -450,6 +619,11 @@ View* Box::getParentNavigationDecision(View* from, View* newFocus, FocusDirectio
     return getParent()->getParentNavigationDecision(from, newFocus, direction);
 }
 
+FocusGraphMode Box::getFocusGraphMode()
+{
+    return FocusGraphMode::CHILDREN;
+}
+
 void Box::willAppear(bool resetState)
 {
     for (View* child : this->children)
@@ -475,23 +649,13 @@ std::vector<View*>& Box::getChildren()
 
 void Box::inflateFromXMLString(std::string_view xml)
 {
-    // Load XML
-    std::shared_ptr<tinyxml2::XMLDocument> document = getXMLCache(xml);
-    tinyxml2::XMLElement* element = document->RootElement();
-
-    if (!element) {
-        tinyxml2::XMLError error = document->Parse(xml.data());
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayout(xml, &error);
 
-        if (error != tinyxml2::XMLError::XML_SUCCESS)
-            fatal("Invalid XML when inflating " + this->describe() + ": error " + std::to_string(error));
+    if (!layout)
+        fatal("Invalid XML when inflating " + this->describe() + ": " + error);
 
-        element = document->RootElement();
-
-        if (!element)
-            fatal("Invalid XML: no element found");
-    }
-
-    return Box::inflateFromXMLElement(element);
+    return Box::inflateFromXMLLayout(layout.get());
 }
 
 void Box::inflateFromXMLRes(const std::string& name)
@@ -502,36 +666,49 @@ void Box::inflateFromXMLRes(const std::string& name)
         return Box::inflateFromXMLFile(View::CUSTOM_RESOURCES_PATH + name);
     }
 
-#ifdef USE_LIBROMFS
-    return Box::inflateFromXMLString(romfs::get(name).string());
-#else
-    return Box::inflateFromXMLFile(std::string(BRLS_RESOURCES) + name);
-#endif
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayoutResource(name, &error);
+
+    if (!layout)
+        fatal("Invalid XML when inflating " + this->describe() + ": " + error);
+
+    return Box::inflateFromXMLLayout(layout.get());
 }
 
 void Box::inflateFromXMLFile(const std::string& path)
 {
-    // Load XML
-    std::shared_ptr<tinyxml2::XMLDocument> document = getXMLCache(path);
-    tinyxml2::XMLElement* element = document->RootElement();
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayoutFile(path, &error);
 
-    if (!element) {
-        tinyxml2::XMLError error = document->LoadFile(path.c_str());
+    if (!layout)
+        fatal("Invalid XML when inflating " + this->describe() + ": " + error);
 
-        if (error != tinyxml2::XMLError::XML_SUCCESS)
-            fatal("Invalid XML when inflating " + this->describe() + ": error " + std::to_string(error));
+    return Box::inflateFromXMLLayout(layout.get());
+}
 
-        element = document->RootElement();
+void Box::inflateFromXMLLayout(XMLLayout* layout, size_t element)
+{
+    const XMLLayout::Element& compiled = layout->getElement(element);
+    const std::string& name            = layout->getString(compiled.name);
 
-        if (!element)
-            fatal("Invalid XML: no element found");
-    }
+    // Ensure element is a Box
+    if (name != "brls:Box")
+        fatal("First XML element is " + name + ", expected brls:Box");
 
-    return Box::inflateFromXMLElement(element);
+    // Apply attributes
+    this->applyXMLAttributes(layout, element);
+
+    // Handle children
+    for (size_t child = element + 1; child < compiled.end; child = layout->getElement(child).end)
+        this->addView(View::createFromXMLLayout(layout, child)); // don't call handleXMLElement because this method is for user XMLs
 }
 
 void Box::inflateFromXMLElement(tinyxml2::XMLElement* element)
 {
+    size_t index;
+    if (XMLLayout* layout = XMLLayout::fromXMLElement(element, &index))
+        return Box::inflateFromXMLLayout(layout, index);
+
     // Ensure element is a Box
     if (std::string(element->Name()) != "brls:Box")
         fatal("First XML element is " + std::string(element->Name()) + ", expected brls:Box");
@@ -666,6 +843,11 @@ bool Box::applyXMLAttribute(std::string name, std::string value)
     return View::applyXMLAttribute(name, value);
 }
 
+bool Box::overridesXMLAttribute(const std::string& name)
+{
+    return this->forwardedAttributes.count(name) > 0 || View::overridesXMLAttribute(name);
+}
+
 void Box::forwardXMLAttribute(std::string attributeName, View* target)
 {
     this->forwardXMLAttribute(attributeName, target, attributeName);
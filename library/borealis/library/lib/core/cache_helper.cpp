@@ -0,0 +1,290 @@
+/*
+    Copyright 2022 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/cache_helper.hpp>
+#include <cstdio>
+#include <stdexcept>
+
+namespace brls
+{
+
+// All textures are created as RGBA
+static constexpr size_t TEXTURE_BPP = 4;
+
+static size_t getTextureBytes(int texture)
+{
+    int width = 0, height = 0;
+    nvgImageSize(Application::getNVGContext(), texture, &width, &height);
+    return (size_t)width * height * TEXTURE_BPP;
+}
+
+TextureCache::TextureCache()
+{
+    Application::getWindowSizeChangedEvent()->subscribe([this]()
+        { this->markAllDirty(); });
+
+    Application::getExitEvent()->subscribe([this]()
+        { this->clean(); });
+}
+
+int TextureCache::getCache(const std::string& key)
+{
+    auto it = this->keyMap.find(key);
+    if (it == this->keyMap.end())
+    {
+        this->stats.misses++;
+        return 0;
+    }
+
+    this->stats.hits++;
+    this->retainCache(it->second->texture);
+    return it->second->texture;
+}
+
+void TextureCache::addCache(const std::string& key, size_t texture)
+{
+    if (texture <= 0)
+        return;
+
+    if (this->keyMap.find(key) != this->keyMap.end())
+        throw std::logic_error("Can not cache the same key twice.");
+
+    auto entry     = std::make_unique<Entry>();
+    entry->key     = key;
+    entry->texture = (int)texture;
+    entry->bytes   = getTextureBytes(entry->texture);
+
+    this->stats.residentBytes += entry->bytes;
+    this->stats.pinnedBytes += entry->bytes;
+    this->stats.entries++;
+
+    this->keyMap[key]                = entry.get();
+    this->textureMap[entry->texture] = std::move(entry);
+
+    this->trim();
+}
+
+void TextureCache::retainCache(size_t texture)
+{
+    Entry* entry = this->findEntry(texture);
+    if (!entry)
+        return;
+
+    if (entry->count == 0)
+    {
+        this->unlink(entry);
+        this->stats.pinnedBytes += entry->bytes;
+    }
+
+    entry->count++;
+}
+
+void TextureCache::removeCache(size_t texture)
+{
+    Entry* entry = this->findEntry(texture);
+    if (!entry || entry->count == 0)
+        return;
+
+    if (--entry->count > 0)
+        return;
+
+    this->release(entry);
+    this->trim();
+}
+
+void TextureCache::markDirty(size_t texture)
+{
+    Entry* entry = this->findEntry(texture);
+    if (!entry || entry->dirty)
+        return;
+
+    this->keyMap.erase(entry->key);
+    entry->dirty = true;
+
+    // Nobody can get it back, no need to keep it around
+    if (entry->count == 0)
+    {
+        this->unlink(entry);
+        this->deleteEntry(entry);
+    }
+}
+
+void TextureCache::markAllDirty()
+{
+    for (auto it = this->textureMap.begin(); it != this->textureMap.end();)
+    {
+        // markDirty() can erase the entry
+        int texture = it->first;
+        it++;
+        this->markDirty(texture);
+    }
+}
+
+void TextureCache::updateCache(size_t old_tex, size_t new_tex)
+{
+    if (old_tex <= 0 || new_tex <= 0)
+        return;
+
+    auto it = this->textureMap.find((int)old_tex);
+    if (it == this->textureMap.end())
+        return;
+
+    std::unique_ptr<Entry> entry = std::move(it->second);
+    this->textureMap.erase(it);
+
+    size_t bytes = getTextureBytes((int)new_tex);
+    this->stats.residentBytes += bytes - entry->bytes;
+    if (entry->count > 0)
+        this->stats.pinnedBytes += bytes - entry->bytes;
+
+    entry->texture = (int)new_tex;
+    entry->bytes   = bytes;
+
+    this->textureMap[entry->texture] = std::move(entry);
+
+    this->trim();
+}
+
+void TextureCache::setBudget(size_t bytes)
+{
+    this->budget = bytes;
+    this->trim();
+}
+
+size_t TextureCache::getBudget()
+{
+    return this->budget;
+}
+
+TextureCacheStats TextureCache::getStats()
+{
+    return this->stats;
+}
+
+void TextureCache::resetStats()
+{
+    this->stats.hits      = 0;
+    this->stats.misses    = 0;
+    this->stats.evictions = 0;
+}
+
+void TextureCache::clean()
+{
+    NVGcontext* vg = Application::getNVGContext();
+    for (auto& i : this->textureMap)
+        nvgDeleteImage(vg, i.first);
+
+    this->keyMap.clear();
+    this->textureMap.clear();
+    this->lruHead = nullptr;
+    this->lruTail = nullptr;
+
+    this->stats.residentBytes = 0;
+    this->stats.pinnedBytes   = 0;
+    this->stats.entries       = 0;
+}
+
+void TextureCache::debug()
+{
+    printf("===== cache size: %zu, resident: %zu bytes, pinned: %zu bytes, budget: %zu bytes =====\n",
+        this->stats.entries, this->stats.residentBytes, this->stats.pinnedBytes, this->budget);
+    printf("hits: %zu, misses: %zu, evictions: %zu\n", this->stats.hits, this->stats.misses, this->stats.evictions);
+    for (auto& i : this->textureMap)
+    {
+        Entry* entry = i.second.get();
+        printf("count: %zu, dirty: %d, value: %d, bytes: %zu, key: %s\n", entry->count,
+            entry->dirty, entry->texture, entry->bytes, entry->key.c_str());
+    }
+}
+
+void TextureCache::pushFront(Entry* entry)
+{
+    entry->prev = nullptr;
+    entry->next = this->lruHead;
+
+    if (this->lruHead)
+        this->lruHead->prev = entry;
+    else
+        this->lruTail = entry;
+
+    this->lruHead = entry;
+}
+
+void TextureCache::unlink(Entry* entry)
+{
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else if (this->lruHead == entry)
+        this->lruHead = entry->next;
+
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else if (this->lruTail == entry)
+        this->lruTail = entry->prev;
+
+    entry->prev = nullptr;
+    entry->next = nullptr;
+}
+
+void TextureCache::release(Entry* entry)
+{
+    this->stats.pinnedBytes -= entry->bytes;
+
+    if (entry->dirty)
+        this->deleteEntry(entry);
+    else
+        this->pushFront(entry);
+}
+
+void TextureCache::deleteEntry(Entry* entry)
+{
+    nvgDeleteImage(Application::getNVGContext(), entry->texture);
+
+    this->stats.residentBytes -= entry->bytes;
+    this->stats.entries--;
+
+    if (!entry->dirty)
+        this->keyMap.erase(entry->key);
+
+    // Frees the entry
+    this->textureMap.erase(entry->texture);
+}
+
+void TextureCache::trim()
+{
+    while (this->stats.residentBytes > this->budget && this->lruTail)
+    {
+        Entry* entry = this->lruTail;
+        this->unlink(entry);
+        this->stats.evictions++;
+        this->deleteEntry(entry);
+    }
+}
+
+TextureCache::Entry* TextureCache::findEntry(size_t texture)
+{
+    if (texture <= 0)
+        return nullptr;
+
+    auto it = this->textureMap.find((int)texture);
+    if (it == this->textureMap.end())
+        return nullptr;
+
+    return it->second.get();
+}
+
+} // namespace brls
@@ -0,0 +1,288 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/focus_graph.hpp>
+#include <cmath>
+#include <numeric>
+
+namespace brls
+{
+
+#define NEXT_NONE -1
+#define NEXT_UNKNOWN -2
+
+// Weight of the distance along the direction against the distance across it:
+// a view slightly off the line wins over an aligned one much further away
+#define MAJOR_AXIS_WEIGHT 13.0f
+
+// Edges of a rect seen from a direction: moving forward increases start and end
+struct FocusExtent
+{
+    float start, end;
+    float crossStart, crossEnd;
+};
+
+static FocusExtent project(const Rect& rect, FocusDirection direction)
+{
+    switch (direction)
+    {
+        case FocusDirection::UP:
+            return { -rect.getMaxY(), -rect.getMinY(), rect.getMinX(), rect.getMaxX() };
+        case FocusDirection::DOWN:
+            return { rect.getMinY(), rect.getMaxY(), rect.getMinX(), rect.getMaxX() };
+        case FocusDirection::LEFT:
+            return { -rect.getMaxX(), -rect.getMinX(), rect.getMinY(), rect.getMaxY() };
+        case FocusDirection::RIGHT:
+        default:
+            return { rect.getMinX(), rect.getMaxX(), rect.getMinY(), rect.getMaxY() };
+    }
+}
+
+// Can the view still be focused, its visibility or focusability
+// may have changed since the graph was built
+static bool isFocusTarget(View* view)
+{
+    return view->getVisibility() == Visibility::VISIBLE && view->getDefaultFocus();
+}
+
+// Moves the rect inside of bounds, or returns bounds if they don't intersect
+static Rect clip(const Rect& rect, const Rect& bounds)
+{
+    float minX = std::fmax(rect.getMinX(), bounds.getMinX());
+    float minY = std::fmax(rect.getMinY(), bounds.getMinY());
+    float maxX = std::fmin(rect.getMaxX(), bounds.getMaxX());
+    float maxY = std::fmin(rect.getMaxY(), bounds.getMaxY());
+
+    if (minX >= maxX || minY >= maxY)
+        return bounds;
+
+    return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
+bool FocusGraph::getNextFocus(View* root, View* currentView, FocusDirection direction, View** next)
+{
+    if (root != this->root || View::getLayoutEpoch() != this->layoutEpoch)
+        this->build(root);
+
+    auto position = this->positions.find(currentView);
+    if (position == this->positions.end())
+        return false;
+
+    int scope   = position->second.first;
+    int index   = position->second.second;
+    int found   = this->scopes[scope].nodes[index].next[(int)direction];
+    bool cached = found != NEXT_UNKNOWN;
+
+    if (found >= 0 && !isFocusTarget(this->scopes[scope].nodes[found].view))
+        cached = false;
+
+    if (!cached)
+    {
+        found = this->search(scope, this->scopes[scope].nodes[index].frame, direction, index);
+
+        this->scopes[scope].nodes[index].next[(int)direction] = found;
+    }
+
+    if (found >= 0)
+    {
+        *next = this->decide(scope, this->scopes[scope].nodes[found].view->getDefaultFocus(), direction);
+        return true;
+    }
+
+    // Nothing in this scope: continue from the scrolled box, in the scope around it,
+    // where the view is taken at its current scrolling position
+    Rect from = currentView->getFrame();
+
+    while (this->scopes[scope].parent >= 0)
+    {
+        int box    = this->scopes[scope].parentNode;
+        int parent = this->scopes[scope].parent;
+
+        // The scrolled box can keep the focus (natural scrolling)
+        View* decision = this->decide(scope, nullptr, direction);
+        if (decision)
+        {
+            *next = decision;
+            return true;
+        }
+
+        View* origin = this->scopes[parent].origin;
+        Rect frame   = from.offsetBy(Point(-origin->getX(), -origin->getY()));
+
+        found = this->search(parent, clip(frame, this->scopes[parent].nodes[box].frame), direction, box);
+        if (found >= 0)
+        {
+            *next = this->decide(parent, this->scopes[parent].nodes[found].view->getDefaultFocus(), direction);
+            return true;
+        }
+
+        scope = parent;
+    }
+
+    *next = nullptr;
+    return true;
+}
+
+void FocusGraph::invalidate()
+{
+    this->root = nullptr;
+    this->scopes.clear();
+    this->positions.clear();
+}
+
+void FocusGraph::build(View* root)
+{
+    this->invalidate();
+
+    this->root        = root;
+    this->layoutEpoch = View::getLayoutEpoch();
+
+    if (!root)
+        return;
+
+    this->scopes.emplace_back(root, -1, -1);
+    this->collect(root, 0, Point());
+
+    for (Scope& scope : this->scopes)
+    {
+        for (int direction = 0; direction < 4; direction++)
+        {
+            std::vector<uint32_t>& order = scope.order[direction];
+
+            order.resize(scope.nodes.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&scope, direction](uint32_t a, uint32_t b) {
+                return project(scope.nodes[a].frame, (FocusDirection)direction).start < project(scope.nodes[b].frame, (FocusDirection)direction).start;
+            });
+        }
+    }
+}
+
+void FocusGraph::collect(View* view, int scope, Point origin)
+{
+    if (view->getVisibility() != Visibility::VISIBLE)
+        return;
+
+    Rect frame(origin.x, origin.y, view->getWidth(), view->getHeight());
+
+    // Focusable boxes can still give the focus to their children instead (scrolling frames)
+    Box* box = dynamic_cast<Box*>(view);
+    if (view->isFocusable() && (!box || box->getDefaultFocus() == box))
+    {
+        int node = this->addNode(scope, view, frame);
+        if (node >= 0)
+            this->positions[view] = std::make_pair(scope, node);
+        return;
+    }
+
+    if (!box)
+        return;
+
+    switch (box->getFocusGraphMode())
+    {
+        case FocusGraphMode::CHILDREN:
+            for (View* child : box->getChildren())
+                this->collect(child, scope, origin + Point(child->getLocalX(), child->getLocalY()));
+            break;
+        case FocusGraphMode::SCOPE:
+        {
+            int node = this->addNode(scope, view, frame);
+            if (node < 0)
+                break;
+
+            for (View* child : box->getChildren())
+            {
+                this->scopes.emplace_back(child, scope, node);
+                this->collect(child, (int)this->scopes.size() - 1, Point());
+            }
+            break;
+        }
+        case FocusGraphMode::OWN:
+            this->addNode(scope, view, frame);
+            break;
+    }
+}
+
+View* FocusGraph::decide(int scope, View* newFocus, FocusDirection direction)
+{
+    if (this->scopes[scope].parent < 0)
+        return newFocus;
+
+    // Same as a move through getNextFocus(): the scrolled box, then its parents,
+    // can replace the view found, for instance to scroll to it first
+    Box* box = (Box*)this->scopes[this->scopes[scope].parent].nodes[this->scopes[scope].parentNode].view;
+    return box->getParentNavigationDecision(this->scopes[scope].origin, newFocus, direction);
+}
+
+int FocusGraph::addNode(int scope, View* view, Rect frame)
+{
+    // Collapsed views cannot be reached
+    if (frame.getWidth() <= 0 || frame.getHeight() <= 0)
+        return NEXT_NONE;
+
+    std::vector<Node>& nodes = this->scopes[scope].nodes;
+    nodes.push_back(Node { view, frame, { NEXT_UNKNOWN, NEXT_UNKNOWN, NEXT_UNKNOWN, NEXT_UNKNOWN } });
+    return (int)nodes.size() - 1;
+}
+
+int FocusGraph::search(int scope, Rect from, FocusDirection direction, int exclude)
+{
+    Scope& nodes                 = this->scopes[scope];
+    std::vector<uint32_t>& order = nodes.order[(int)direction];
+    FocusExtent source           = project(from, direction);
+
+    // Candidates start past the start of the view, sorted by distance along the direction
+    auto candidate = std::upper_bound(order.begin(), order.end(), source.start, [&nodes, direction](float start, uint32_t node) {
+        return start < project(nodes.nodes[node].frame, direction).start;
+    });
+
+    int best        = NEXT_NONE;
+    float bestScore = INFINITY;
+
+    for (; candidate != order.end(); candidate++)
+    {
+        Node& node         = nodes.nodes[*candidate];
+        FocusExtent target = project(node.frame, direction);
+
+        // Every candidate left is further away than the best one
+        float major = std::fmax(target.start - source.end, 0.0f);
+        if (MAJOR_AXIS_WEIGHT * major * major > bestScore)
+            break;
+
+        if ((int)*candidate == exclude || target.end <= source.end)
+            continue;
+
+        // Views overlapping the view across the direction can be reached even if they
+        // overlap it along the direction, the others need to be entirely past it
+        bool inBeam = target.crossStart < source.crossEnd && target.crossEnd > source.crossStart;
+        if (!inBeam && target.start < source.end - 0.5f)
+            continue;
+
+        float minor = (target.crossStart + target.crossEnd - source.crossStart - source.crossEnd) / 2;
+        float score = MAJOR_AXIS_WEIGHT * major * major + minor * minor;
+
+        if (score < bestScore && isFocusTarget(node.view))
+        {
+            best      = *candidate;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+} // namespace brls
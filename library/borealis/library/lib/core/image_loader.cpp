@@ -0,0 +1,246 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stb_image.h>
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/cache_helper.hpp>
+#include <borealis/core/image_loader.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/thread.hpp>
+
+namespace brls
+{
+
+size_t ImageLoader::loadFile(const std::string& path, int imageFlags, ImageLoaderCallback callback)
+{
+    auto job        = std::make_shared<Job>();
+    job->key        = path;
+    job->imageFlags = imageFlags;
+    job->fromFile   = true;
+    job->source     = path;
+
+    return this->enqueue(job, callback);
+}
+
+size_t ImageLoader::loadMem(const std::string& key, const unsigned char* data, size_t size, int imageFlags, ImageLoaderCallback callback)
+{
+    auto job        = std::make_shared<Job>();
+    job->key        = key;
+    job->imageFlags = imageFlags;
+    job->source     = std::string((const char*)data, size);
+
+    return this->enqueue(job, callback);
+}
+
+size_t ImageLoader::prefetchFile(const std::string& path, int imageFlags)
+{
+    auto job        = std::make_shared<Job>();
+    job->key        = path;
+    job->imageFlags = imageFlags;
+    job->fromFile   = true;
+    job->source     = path;
+
+    return this->prefetch(job);
+}
+
+size_t ImageLoader::prefetchMem(const std::string& key, const unsigned char* data, size_t size, int imageFlags)
+{
+    auto job        = std::make_shared<Job>();
+    job->key        = key;
+    job->imageFlags = imageFlags;
+    job->source     = std::string((const char*)data, size);
+
+    return this->prefetch(job);
+}
+
+size_t ImageLoader::prefetch(std::shared_ptr<Job> job)
+{
+    TextureCache& cache = TextureCache::instance();
+
+    // Only refresh the position of the texture in the cache
+    int cached = cache.getCache(job->key);
+    if (cached > 0)
+    {
+        cache.removeCache(cached);
+        return 0;
+    }
+
+    // Give the reference back to the cache right away, the texture stays until evicted
+    return this->enqueue(
+        job, [](int texture)
+        {
+            if (texture > 0)
+                TextureCache::instance().removeCache(texture); },
+        TaskPriority::LOW);
+}
+
+size_t ImageLoader::enqueue(std::shared_ptr<Job> job, ImageLoaderCallback callback, TaskPriority priority)
+{
+    size_t id = ++this->lastId;
+
+    // Share the decoding of an image that is already being loaded
+    if (!job->key.empty())
+    {
+        auto& loading = this->loadingJobs[std::make_pair(job->key, job->imageFlags)];
+        if (loading && !loading->abandoned)
+        {
+            loading->callbacks.emplace_back(id, callback);
+            this->requests[id] = loading;
+            return id;
+        }
+
+        loading = job;
+    }
+
+    job->callbacks.emplace_back(id, callback);
+    this->requests[id] = job;
+
+    brls::async([job]()
+        {
+            int channels;
+
+            // Same settings as nvgCreateImage()
+            stbi_set_unpremultiply_on_load_thread(1);
+            stbi_convert_iphone_png_to_rgb_thread(1);
+
+            if (job->abandoned)
+                job->pixels = nullptr;
+            else if (job->fromFile)
+                job->pixels = stbi_load(job->source.c_str(), &job->width, &job->height, &channels, 4);
+            else
+                job->pixels = stbi_load_from_memory((const stbi_uc*)job->source.data(), (int)job->source.size(), &job->width, &job->height, &channels, 4);
+
+            if (!job->pixels && !job->abandoned)
+                Logger::error("ImageLoader: cannot decode image {}: {}", job->key, stbi_failure_reason());
+
+            job->source.clear();
+            job->source.shrink_to_fit();
+
+            ImageLoader& loader = ImageLoader::instance();
+            std::lock_guard<std::mutex> guard(loader.decodedMutex);
+            loader.decodedJobs.push_back(job); },
+        priority);
+
+    return id;
+}
+
+void ImageLoader::cancel(size_t id)
+{
+    auto it = this->requests.find(id);
+    if (it == this->requests.end())
+        return;
+
+    auto& callbacks = it->second->callbacks;
+    for (auto callback = callbacks.begin(); callback != callbacks.end(); callback++)
+    {
+        if (callback->first == id)
+        {
+            callbacks.erase(callback);
+            break;
+        }
+    }
+
+    if (callbacks.empty())
+        it->second->abandoned = true;
+
+    this->requests.erase(it);
+}
+
+void ImageLoader::setUploadBudget(Time budget)
+{
+    this->uploadBudget = budget;
+}
+
+void ImageLoader::processUploads()
+{
+    BRLS_PROFILE_ZONE("image uploads");
+
+    Time start      = getCPUTimeUsec();
+    size_t uploaded = 0;
+
+    while (uploaded == 0 || getCPUTimeUsec() - start < this->uploadBudget)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> guard(this->decodedMutex);
+            if (this->decodedJobs.empty())
+                return;
+
+            job = this->decodedJobs.front();
+            this->decodedJobs.pop_front();
+        }
+
+        this->upload(job);
+        uploaded++;
+    }
+}
+
+void ImageLoader::upload(const std::shared_ptr<Job>& job)
+{
+    NVGcontext* vg = Application::getNVGContext();
+
+    // An abandoned job may have been replaced by a new one for the same key
+    auto loading = this->loadingJobs.find(std::make_pair(job->key, job->imageFlags));
+    if (loading != this->loadingJobs.end() && loading->second == job)
+        this->loadingJobs.erase(loading);
+
+    int texture = 0;
+    if (job->pixels)
+    {
+        texture = nvgCreateImageRGBA(vg, job->width, job->height, job->imageFlags, job->pixels);
+        stbi_image_free(job->pixels);
+        job->pixels = nullptr;
+    }
+
+    // Register the texture, with one reference for each request
+    if (texture > 0 && !job->key.empty())
+    {
+        TextureCache& cache = TextureCache::instance();
+
+        int cached = cache.getCache(job->key);
+        if (cached > 0)
+        {
+            // The same image was loaded synchronously in the meantime
+            nvgDeleteImage(vg, texture);
+            texture = cached;
+        }
+        else
+        {
+            cache.addCache(job->key, texture);
+        }
+
+        if (job->callbacks.empty())
+            cache.removeCache(texture);
+
+        for (size_t i = 1; i < job->callbacks.size(); i++)
+            cache.retainCache(texture);
+    }
+    else if (texture > 0 && job->callbacks.empty())
+    {
+        nvgDeleteImage(vg, texture);
+    }
+
+    auto callbacks = std::move(job->callbacks);
+    for (auto& callback : callbacks)
+    {
+        this->requests.erase(callback.first);
+        callback.second(texture);
+    }
+}
+
+} // namespace brls
@@ -40,6 +40,10 @@
 #include <borealis/platforms/sdl/sdl_platform.hpp>
 #endif
 
+#ifdef __HEADLESS__
+#include <borealis/platforms/headless/headless_platform.hpp>
+#endif
+
 namespace brls
 {
 
@@ -53,6 +57,8 @@ Platform* Platform::createPlatform()
     return new PsvPlatform();
 #elif defined(PS4)
     return new Ps4Platform();
+#elif defined(__HEADLESS__)
+    return new HeadlessPlatform();
 #elif defined(__SDL2__)
     return new SDLPlatform();
 #elif defined(__GLFW__)
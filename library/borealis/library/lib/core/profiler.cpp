@@ -0,0 +1,263 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef _MSC_VER
+#include <cxxabi.h>
+#endif
+
+#include <algorithm>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/view.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+namespace brls
+{
+
+// Marks a zone opened after the zones of the frame were full
+static const size_t SKIPPED = (size_t)-1;
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && frames.empty())
+    {
+        frames.resize(FRAMES);
+        viewCosts.reserve(512);
+    }
+
+    Profiler::enabled          = enabled;
+    Profiler::inFrame          = false;
+    Profiler::openZoneCount    = 0;
+    Profiler::skippedZoneCount = 0;
+    Profiler::openViewCount    = 0;
+    Profiler::skippedViewCount = 0;
+}
+
+ProfileFrame& Profiler::currentFrame()
+{
+    return frames[nextFrame % FRAMES];
+}
+
+void Profiler::beginFrame()
+{
+    ProfileFrame& frame = currentFrame();
+
+    frame.index        = nextFrame;
+    frame.start        = getCPUTimeUsec();
+    frame.duration     = 0;
+    frame.zoneCount    = 0;
+    frame.droppedZones = 0;
+    frame.viewCount    = 0;
+
+    openZoneCount    = 0;
+    skippedZoneCount = 0;
+    openViewCount    = 0;
+    skippedViewCount = 0;
+    viewCosts.clear();
+
+    inFrame = true;
+}
+
+void Profiler::endFrame()
+{
+    if (!inFrame)
+        return;
+
+    ProfileFrame& frame = currentFrame();
+    Time now            = getCPUTimeUsec();
+
+    // Zones left open end with the frame
+    while (openZoneCount > 0)
+    {
+        size_t index = openZones[--openZoneCount];
+        if (index != SKIPPED)
+            frame.zones[index].duration = now - frame.zones[index].start;
+    }
+
+    frame.duration = now - frame.start;
+
+    // Keep the most expensive views
+    frame.viewCount = std::min(viewCosts.size(), ProfileFrame::MAX_VIEWS);
+    std::partial_sort(viewCosts.begin(), viewCosts.begin() + frame.viewCount, viewCosts.end(),
+        [](const ProfileViewCost& a, const ProfileViewCost& b)
+        { return a.self > b.self; });
+    std::copy(viewCosts.begin(), viewCosts.begin() + frame.viewCount, frame.views);
+
+    nextFrame++;
+    inFrame = false;
+}
+
+void Profiler::beginZone(const char* name)
+{
+    if (!inFrame)
+        return;
+
+    ProfileFrame& frame = currentFrame();
+
+    if (openZoneCount == sizeof(openZones) / sizeof(openZones[0]))
+    {
+        frame.droppedZones++;
+        skippedZoneCount++;
+        return;
+    }
+
+    size_t index = SKIPPED;
+    if (frame.zoneCount < ProfileFrame::MAX_ZONES)
+    {
+        index              = frame.zoneCount++;
+        frame.zones[index] = { name, getCPUTimeUsec(), 0, (uint8_t)openZoneCount };
+    }
+    else
+    {
+        frame.droppedZones++;
+    }
+
+    openZones[openZoneCount++] = index;
+}
+
+void Profiler::endZone()
+{
+    if (!inFrame || openZoneCount == 0)
+        return;
+
+    if (skippedZoneCount > 0)
+    {
+        skippedZoneCount--;
+        return;
+    }
+
+    size_t index = openZones[--openZoneCount];
+    if (index == SKIPPED)
+        return;
+
+    ProfileZone& zone = currentFrame().zones[index];
+    zone.duration     = getCPUTimeUsec() - zone.start;
+}
+
+void Profiler::beginView(const View* /*view*/)
+{
+    if (!inFrame)
+        return;
+
+    if (openViewCount == sizeof(openViews) / sizeof(openViews[0]))
+    {
+        skippedViewCount++;
+        return;
+    }
+
+    openViews[openViewCount++] = { getCPUTimeUsec(), 0 };
+}
+
+void Profiler::endView(const View* view)
+{
+    if (!inFrame || openViewCount == 0)
+        return;
+
+    if (skippedViewCount > 0)
+    {
+        skippedViewCount--;
+        return;
+    }
+
+    OpenView& open = openViews[--openViewCount];
+    Time total     = getCPUTimeUsec() - open.start;
+
+    if (openViewCount > 0)
+        openViews[openViewCount - 1].children += total;
+
+    viewCosts.push_back({ view, &typeid(*view), total - open.children, total });
+}
+
+size_t Profiler::getFrameCount()
+{
+    if (frames.empty())
+        return 0;
+
+    // The frame being recorded takes the place of the oldest one
+    return std::min(nextFrame, frames.size() - (inFrame ? 1 : 0));
+}
+
+const ProfileFrame& Profiler::getFrame(size_t age)
+{
+    return frames[(nextFrame - 1 - age) % FRAMES];
+}
+
+std::string Profiler::getViewName(const ProfileViewCost& cost)
+{
+    const char* name = cost.type->name();
+#ifndef _MSC_VER
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> res {
+        abi::__cxa_demangle(name, NULL, NULL, &status),
+        std::free
+    };
+    return (status == 0) ? res.get() : name;
+#else
+    return name;
+#endif
+}
+
+bool Profiler::exportChromeTrace(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        Logger::error("profiler: cannot write trace to {}", path);
+        return false;
+    }
+
+    size_t count = getFrameCount();
+    Time origin  = count > 0 ? getFrame(count - 1).start : 0;
+    bool first   = true;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (size_t age = count; age-- > 0;)
+    {
+        const ProfileFrame& frame = getFrame(age);
+
+        fprintf(file, "%s{\"name\":\"frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%lld,\"args\":{\"index\":%zu,\"dropped_zones\":%zu",
+            first ? "" : ",\n", (long long)(frame.start - origin), (long long)frame.duration, frame.index, frame.droppedZones);
+        first = false;
+
+        // The views do not have a start time, they are listed with the frame
+        for (size_t i = 0; i < frame.viewCount; i++)
+        {
+            const ProfileViewCost& cost = frame.views[i];
+            fprintf(file, ",\"view%zu\":\"%s: %lld us self, %lld us total\"", i, getViewName(cost).c_str(),
+                (long long)cost.self, (long long)cost.total);
+        }
+
+        fprintf(file, "}}");
+
+        for (size_t i = 0; i < frame.zoneCount; i++)
+        {
+            const ProfileZone& zone = frame.zones[i];
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%lld}",
+                zone.name, (long long)(zone.start - origin), (long long)zone.duration);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    Logger::info("profiler: {} frames written to {}", count, path);
+    return true;
+}
+
+} // namespace brls
@@ -0,0 +1,282 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/scroll_engine.hpp>
+#include <cmath>
+
+namespace brls
+{
+
+// Time constant of the velocity decay while flinging, in ms:
+// the offset travels velocity * FLING_TIME_CONSTANT before stopping
+#define FLING_TIME_CONSTANT 325.0f
+
+// Flings slower than this (in px/s) do not move, and a fling stops below it
+#define MIN_FLING_VELOCITY 20.0f
+
+// Stiffness of the rubber band: the first pixels of overscroll move by this fraction of the finger
+#define RUBBER_BAND_COEFFICIENT 0.55f
+
+// Angular frequency of the critically damped spring bringing the offset back
+// into the range, in rad/s. Settles in about 0.4s
+#define BOUNCE_FREQUENCY 12.0f
+
+void ScrollEngine::setRange(float maxOffset, float viewport)
+{
+    this->maxOffset = std::fmax(maxOffset, 0.0f);
+    this->viewport  = viewport;
+
+    if (motion == Motion::NONE && !dragging && isOverscrolled())
+        moveTo(clamp(offset));
+}
+
+void ScrollEngine::setOverscrollEnabled(bool enabled)
+{
+    this->overscrollEnabled = enabled;
+}
+
+void ScrollEngine::setScrollCallback(TickingGenericCallback callback)
+{
+    this->scrollCallback = callback;
+}
+
+void ScrollEngine::setOffset(float value)
+{
+    dragging = false;
+    setMotion(Motion::NONE);
+    velocity = 0;
+    moveTo(clamp(value));
+}
+
+void ScrollEngine::animateTo(float value, Time duration)
+{
+    dragging = false;
+    velocity = 0;
+
+    value = clamp(value);
+    if (duration <= 0 || value == offset)
+    {
+        setMotion(Motion::NONE);
+        moveTo(value);
+        return;
+    }
+
+    animationFrom = offset;
+    animationTo   = value;
+    animationTime = 0;
+    animationEnd  = duration;
+
+    setMotion(Motion::ANIMATION);
+}
+
+void ScrollEngine::beginDrag()
+{
+    setMotion(Motion::NONE);
+    velocity = 0;
+
+    dragging = true;
+
+    // Continue from the overscroll if there is one
+    if (offset < 0)
+        dragStart = -rubberBandInverse(-offset);
+    else if (offset > maxOffset)
+        dragStart = maxOffset + rubberBandInverse(offset - maxOffset);
+    else
+        dragStart = offset;
+}
+
+void ScrollEngine::dragTo(float distance)
+{
+    if (!dragging)
+        return;
+
+    float value = dragStart + distance;
+
+    if (!overscrollEnabled || viewport <= 0)
+        value = clamp(value);
+    else if (value < 0)
+        value = -rubberBand(-value);
+    else if (value > maxOffset)
+        value = maxOffset + rubberBand(value - maxOffset);
+
+    moveTo(value);
+}
+
+void ScrollEngine::endDrag(float velocity)
+{
+    if (!dragging)
+        return;
+
+    dragging = false;
+    fling(velocity);
+}
+
+void ScrollEngine::fling(float velocity)
+{
+    dragging       = false;
+    this->velocity = velocity;
+
+    if (isOverscrolled())
+        setMotion(Motion::BOUNCE);
+    else if (std::fabs(velocity) >= MIN_FLING_VELOCITY)
+        setMotion(Motion::FLING);
+    else
+    {
+        this->velocity = 0;
+        setMotion(Motion::NONE);
+    }
+}
+
+bool ScrollEngine::isOverscrolled() const
+{
+    return offset < 0 || offset > maxOffset;
+}
+
+bool ScrollEngine::onUpdate(Time delta)
+{
+    float dt = delta / 1000.0f;
+
+    switch (motion)
+    {
+        case Motion::NONE:
+            return false;
+        case Motion::ANIMATION:
+        {
+            animationTime += delta;
+            if (animationTime >= animationEnd)
+            {
+                moveTo(animationTo);
+                motion = Motion::NONE;
+                return false;
+            }
+
+            // Quadratic ease-out
+            float progress = (float)animationTime / animationEnd;
+            progress       = 1.0f - (1.0f - progress) * (1.0f - progress);
+            moveTo(animationFrom + (animationTo - animationFrom) * progress);
+            return true;
+        }
+        case Motion::FLING:
+        {
+            float decay = std::exp(-delta / FLING_TIME_CONSTANT);
+
+            // Exact integral of the decaying velocity over the frame
+            float value = offset + velocity * FLING_TIME_CONSTANT / 1000.0f * (1.0f - decay);
+            velocity *= decay;
+
+            if (value < 0 || value > maxOffset)
+            {
+                if (!overscrollEnabled || viewport <= 0)
+                {
+                    moveTo(clamp(value));
+                    velocity = 0;
+                    motion   = Motion::NONE;
+                    return false;
+                }
+
+                // Hit a bound, the spring takes over from there
+                moveTo(value);
+                motion = Motion::BOUNCE;
+                return true;
+            }
+
+            moveTo(value);
+
+            if (std::fabs(velocity) < MIN_FLING_VELOCITY)
+            {
+                velocity = 0;
+                motion   = Motion::NONE;
+                return false;
+            }
+            return true;
+        }
+        case Motion::BOUNCE:
+        {
+            float target       = clamp(offset);
+            float displacement = offset - target;
+
+            // Exact step of a critically damped spring:
+            // x(t) = (x0 + (v0 + w * x0) * t) * e^(-w * t)
+            float w     = BOUNCE_FREQUENCY;
+            float decay = std::exp(-w * dt);
+            float c     = velocity + w * displacement;
+
+            displacement = (displacement + c * dt) * decay;
+            velocity     = (velocity - w * c * dt) * decay;
+
+            if (std::fabs(displacement) < 0.5f && std::fabs(velocity) < MIN_FLING_VELOCITY)
+            {
+                moveTo(target);
+                velocity = 0;
+                motion   = Motion::NONE;
+                return false;
+            }
+
+            moveTo(target + displacement);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ScrollEngine::onStop()
+{
+    // Stopped from the outside (or finished): the offset stays where it is
+    motion   = Motion::NONE;
+    velocity = 0;
+}
+
+float ScrollEngine::clamp(float value) const
+{
+    return std::fmin(std::fmax(value, 0.0f), maxOffset);
+}
+
+float ScrollEngine::rubberBand(float value) const
+{
+    // Grows slower and slower, never reaching the viewport size
+    return (1.0f - 1.0f / (value * RUBBER_BAND_COEFFICIENT / viewport + 1.0f)) * viewport;
+}
+
+float ScrollEngine::rubberBandInverse(float value) const
+{
+    if (viewport <= 0)
+        return value;
+
+    value = std::fmin(value, viewport * 0.99f);
+    return value * viewport / ((viewport - value) * RUBBER_BAND_COEFFICIENT);
+}
+
+void ScrollEngine::setMotion(Motion motion)
+{
+    this->motion = motion;
+
+    if (motion == Motion::NONE)
+        this->stop();
+    else
+        this->start();
+}
+
+void ScrollEngine::moveTo(float value)
+{
+    if (value == offset)
+        return;
+
+    offset = value;
+    scrollCallback();
+}
+
+} // namespace brls
@@ -19,6 +19,7 @@
 #include <borealis/core/style.hpp>
 #include <borealis/core/util.hpp>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace brls
 {
@@ -155,25 +156,94 @@ Style getStyle()
     return style;
 }
 
+// Interned metric names, a key id is its index in styleKeyNames()
+static std::unordered_map<std::string, size_t>& styleKeyIds()
+{
+    static std::unordered_map<std::string, size_t> ids;
+    return ids;
+}
+
+static std::vector<std::string>& styleKeyNames()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+StyleKey::StyleKey(const std::string& name)
+{
+    auto& ids = styleKeyIds();
+    auto it   = ids.find(name);
+
+    if (it != ids.end())
+    {
+        this->id = it->second;
+        return;
+    }
+
+    this->id = styleKeyNames().size();
+    styleKeyNames().push_back(name);
+    ids[name] = this->id;
+}
+
+const std::string& StyleKey::getName() const
+{
+    return styleKeyNames()[this->id];
+}
+
 StyleValues::StyleValues(std::initializer_list<std::pair<std::string, float>> list)
 {
     for (std::pair<std::string, float> metric : list)
-        this->values.insert(metric);
+    {
+        StyleKey key(metric.first);
+        if (key.getId() >= this->defined.size() || !this->defined[key.getId()])
+            this->addMetric(key, metric.second);
+    }
 }
 
 void StyleValues::addMetric(const std::string& name, float metric)
 {
-    this->values[name] = metric;
+    this->addMetric(StyleKey(name), metric);
 }
 
 float StyleValues::getMetric(const std::string& name)
 {
-    if (this->values.count(name) == 0) {
-        brls::Logger::error("Unknown style metric {} in size: {}", name, std::to_string(this->values.size()));
+    // Don't intern unknown names
+    auto it = styleKeyIds().find(name);
+    if (it == styleKeyIds().end() || it->second >= this->defined.size() || !this->defined[it->second])
+    {
+        brls::Logger::error("Unknown style metric {} in size: {}", name, std::to_string(this->count));
         return 0;
     }
 
-    return this->values[name];
+    return this->values[it->second];
+}
+
+void StyleValues::addMetric(StyleKey key, float metric)
+{
+    size_t id = key.getId();
+    if (id >= this->values.size())
+    {
+        this->values.resize(id + 1, 0.0f);
+        this->defined.resize(id + 1, false);
+    }
+
+    if (!this->defined[id])
+        this->count++;
+
+    this->values[id]  = metric;
+    this->defined[id] = true;
+}
+
+float StyleValues::getMetric(StyleKey key)
+{
+    size_t id = key.getId();
+    if (id >= this->defined.size() || !this->defined[id])
+    {
+        brls::Logger::error("Unknown style metric {} in size: {}", key.getName(), std::to_string(this->count));
+        return 0;
+    }
+
+    return this->values[id];
 }
 
 Style::Style(StyleValues* values)
@@ -196,6 +266,21 @@ float Style::operator[](const std::string& name)
     return this->getMetric(name);
 }
 
+float Style::getMetric(StyleKey key)
+{
+    return this->values->getMetric(key);
+}
+
+void Style::addMetric(StyleKey key, float metric)
+{
+    return this->values->addMetric(key, metric);
+}
+
+float Style::operator[](StyleKey key)
+{
+    return this->getMetric(key);
+}
+
 /*
 HorizonStyle::HorizonStyle()
 {
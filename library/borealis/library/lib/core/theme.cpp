@@ -18,6 +18,7 @@
 #include <borealis/core/theme.hpp>
 #include <borealis/core/util.hpp>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace brls
 {
@@ -139,23 +140,88 @@ static ThemeValues darkThemeValues = {
     { "brls/spinner/bar_color", nvgRGBA(192, 192, 192, 80) }, // TODO: get this right
 };
 
+// Interned color names, a key id is its index in themeKeyNames()
+static std::unordered_map<std::string, size_t>& themeKeyIds()
+{
+    static std::unordered_map<std::string, size_t> ids;
+    return ids;
+}
+
+static std::vector<std::string>& themeKeyNames()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+ThemeKey::ThemeKey(const std::string& name)
+{
+    auto& ids = themeKeyIds();
+    auto it   = ids.find(name);
+
+    if (it != ids.end())
+    {
+        this->id = it->second;
+        return;
+    }
+
+    this->id = themeKeyNames().size();
+    themeKeyNames().push_back(name);
+    ids[name] = this->id;
+}
+
+const std::string& ThemeKey::getName() const
+{
+    return themeKeyNames()[this->id];
+}
+
 ThemeValues::ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list)
 {
     for (std::pair<std::string, NVGcolor> color : list)
-        this->values.insert(color);
+    {
+        ThemeKey key(color.first);
+        if (key.getId() >= this->defined.size() || !this->defined[key.getId()])
+            this->addColor(key, color.second);
+    }
 }
 
 void ThemeValues::addColor(const std::string& name, NVGcolor color)
 {
-        this->values[name] = color;
+    this->addColor(ThemeKey(name), color);
 }
 
 NVGcolor ThemeValues::getColor(const std::string& name)
 {
-    if (this->values.count(name) == 0)
-        fatal("Unknown theme value \"" + name + "\" in size: " + std::to_string(this->values.size()));
+    // Don't intern unknown names
+    auto it = themeKeyIds().find(name);
+    if (it == themeKeyIds().end() || it->second >= this->defined.size() || !this->defined[it->second])
+        fatal("Unknown theme value \"" + name + "\" in size: " + std::to_string(this->count));
+
+    return this->values[it->second];
+}
+
+void ThemeValues::addColor(ThemeKey key, NVGcolor color)
+{
+    size_t id = key.getId();
+    if (id >= this->values.size())
+    {
+        this->values.resize(id + 1);
+        this->defined.resize(id + 1, false);
+    }
+
+    if (!this->defined[id])
+        this->count++;
+
+    this->values[id]  = color;
+    this->defined[id] = true;
+}
 
-    return this->values[name];
+NVGcolor ThemeValues::getColor(ThemeKey key)
+{
+    size_t id = key.getId();
+    if (id >= this->defined.size() || !this->defined[id])
+        fatal("Unknown theme value \"" + key.getName() + "\" in size: " + std::to_string(this->count));
+
+    return this->values[id];
 }
 
 Theme::Theme(ThemeValues* values)
@@ -178,6 +244,21 @@ NVGcolor Theme::operator[](const std::string& name)
     return this->getColor(name);
 }
 
+NVGcolor Theme::getColor(ThemeKey key)
+{
+    return this->values->getColor(key);
+}
+
+void Theme::addColor(ThemeKey key, NVGcolor color)
+{
+    return this->values->addColor(key, color);
+}
+
+NVGcolor Theme::operator[](ThemeKey key)
+{
+    return this->getColor(key);
+}
+
 Theme& Theme::getLightTheme()
 {
     static Theme lightTheme(&lightThemeValues);
@@ -14,10 +14,11 @@
     limitations under the License.
 */
 
-#include <libretro-common/retro_timers.h>
-
+#include <algorithm>
 #include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/thread.hpp>
+#include <cstdint>
 #include <exception>
 
 #ifdef BOREALIS_USE_STD_THREAD
@@ -34,11 +35,14 @@ namespace brls
 {
 
 #ifdef BOREALIS_USE_STD_THREAD
-static std::thread *task_loop_thread = nullptr;
+static std::vector<std::thread*> task_loop_threads;
 #else
-static pthread_t task_loop_thread = pthread_t(0);
+static std::vector<pthread_t> task_loop_threads;
 #endif
 
+// Index of the worker running on the current thread, if any
+static thread_local size_t current_worker = SIZE_MAX;
+
 Threading::Threading()
 {
     start_task_loop();
@@ -54,6 +58,11 @@ void async(const std::function<void()>& task)
     Threading::async(task);
 }
 
+void async(const std::function<void()>& task, TaskPriority priority)
+{
+    Threading::async(task, priority);
+}
+
 size_t delay(long milliseconds, const std::function<void()>& func)
 {
     return Threading::delay(milliseconds, func);
@@ -72,8 +81,43 @@ void Threading::sync(const std::function<void()>& func)
 
 void Threading::async(const std::function<void()>& task)
 {
-    std::lock_guard<std::mutex> guard(m_async_mutex);
-    m_async_tasks.push_back(task);
+    Threading::async(task, TaskPriority::NORMAL);
+}
+
+void Threading::async(const std::function<void()>& task, TaskPriority priority)
+{
+    // Tasks posted by a worker stay on its own queue,
+    // the others are spread over all the workers
+    size_t worker = current_worker;
+    {
+        std::lock_guard<std::mutex> guard(m_async_mutex);
+        init_task_queues();
+        if (worker >= m_async_queues.size())
+            worker = m_async_next_queue++ % m_async_queues.size();
+
+        // Counted before the task is published: a worker can pop it
+        // as soon as it is queued, and decrements the count when it does
+        m_async_pending++;
+    }
+
+    TaskQueue* queue = m_async_queues[worker];
+    {
+        std::lock_guard<std::mutex> guard(queue->mutex);
+        queue->tasks[(size_t)priority].push_back(task);
+    }
+
+    m_async_condition.notify_one();
+}
+
+size_t Threading::getWorkerCount()
+{
+#ifdef __PSV__
+    // Only 3 of the 4 cores are available to applications
+    return 3;
+#else
+    size_t cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 2;
+#endif
 }
 
 size_t Threading::delay(long milliseconds, const std::function<void()>& func)
@@ -81,26 +125,39 @@ size_t Threading::delay(long milliseconds, const std::function<void()>& func)
     std::lock_guard<std::mutex> guard(m_delay_mutex);
     DelayOperation operation;
 #ifdef PS4
-    operation.startPoint        = sceKernelGetProcessTime();
-    operation.delayMilliseconds = milliseconds * 1000;
+    operation.deadline = sceKernelGetProcessTime() + milliseconds * 1000;
 #else
-    operation.startPoint        = std::chrono::high_resolution_clock::now();
-    operation.delayMilliseconds = milliseconds;
+    operation.deadline = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(milliseconds);
 #endif
-    operation.func              = func;
-    operation.index             = ++m_delay_index;
-    m_delay_tasks.push_back(operation);
+    operation.func     = func;
+    operation.index    = ++m_delay_index;
+
+    m_delay_tasks.push_back(std::move(operation));
+    std::push_heap(m_delay_tasks.begin(), m_delay_tasks.end(), std::greater<DelayOperation>());
+    m_delay_pending.insert(m_delay_index);
+
     return m_delay_index;
 }
 
 void Threading::cancelDelay(size_t iter)
 {
     std::lock_guard<std::mutex> guard(m_delay_mutex);
-    m_delay_cancel_set.insert(iter);
+    m_delay_pending.erase(iter);
+
+    // Drop cancelled operations once they make up most of the heap
+    if (m_delay_tasks.size() > 32 && m_delay_pending.size() < m_delay_tasks.size() / 2)
+    {
+        m_delay_tasks.erase(std::remove_if(m_delay_tasks.begin(), m_delay_tasks.end(), [](const DelayOperation& d)
+                                { return m_delay_pending.count(d.index) == 0; }),
+            m_delay_tasks.end());
+        std::make_heap(m_delay_tasks.begin(), m_delay_tasks.end(), std::greater<DelayOperation>());
+    }
 }
 
 void Threading::performSyncTasks()
 {
+    BRLS_PROFILE_ZONE("sync tasks");
+
     m_sync_mutex.lock();
     auto local = m_sync_functions;
     m_sync_functions.clear();
@@ -118,53 +175,43 @@ void Threading::performSyncTasks()
         }
     }
 
+#ifdef PS4
+    uint64_t now = sceKernelGetProcessTime();
+#else
+    auto now = std::chrono::high_resolution_clock::now();
+#endif
+
+    // Pop the expired operations, the heap top is always the next one to expire
     m_delay_mutex.lock();
-    auto delay_local = m_delay_tasks;
-    m_delay_tasks.clear();
+    while (!m_delay_tasks.empty() && m_delay_tasks.front().deadline <= now)
+    {
+        std::pop_heap(m_delay_tasks.begin(), m_delay_tasks.end(), std::greater<DelayOperation>());
+        if (m_delay_pending.count(m_delay_tasks.back().index))
+            m_delay_expired.push_back(std::move(m_delay_tasks.back()));
+        m_delay_tasks.pop_back();
+    }
     m_delay_mutex.unlock();
 
-    for (auto& d : delay_local)
+    for (auto& d : m_delay_expired)
     {
-        // Check cancel
+        // A previous operation may have cancelled this one
         m_delay_mutex.lock();
-        if (m_delay_cancel_set.count(d.index))
-        {
-            m_delay_cancel_set.erase(d.index);
-            m_delay_mutex.unlock();
-            continue;
-        }
+        bool cancelled = m_delay_pending.erase(d.index) == 0;
         m_delay_mutex.unlock();
 
-#ifdef PS4
-        uint64_t duration = sceKernelGetProcessTime() - d.startPoint;
-#else
-        auto timeNow  = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(timeNow - d.startPoint).count();
-#endif
+        if (cancelled)
+            continue;
 
-        if (duration >= d.delayMilliseconds)
+        try
         {
-            try
-            {
-                d.func();
-            }
-            catch (std::exception& e)
-            {
-                brls::Logger::error("error: performSyncTasks(delay): {}", e.what());
-            }
-
-            m_delay_mutex.lock();
-            if (m_delay_cancel_set.count(d.index)) m_delay_cancel_set.erase(d.index);
-            m_delay_mutex.unlock();
-
+            d.func();
         }
-        else
+        catch (std::exception& e)
         {
-            m_delay_mutex.lock();
-            m_delay_tasks.push_back(d);
-            m_delay_mutex.unlock();
+            brls::Logger::error("error: performSyncTasks(delay): {}", e.what());
         }
     }
+    m_delay_expired.clear();
 }
 
 void Threading::start()
@@ -175,47 +222,132 @@ void Threading::start()
 
 void Threading::stop()
 {
-    task_loop_active = false;
+    {
+        std::lock_guard<std::mutex> guard(m_async_mutex);
+        task_loop_active = false;
+    }
+    m_async_condition.notify_all();
 
 #ifdef BOREALIS_USE_STD_THREAD
-    task_loop_thread->join();
-    delete task_loop_thread;
-    task_loop_thread = nullptr;
+    for (std::thread* thread : task_loop_threads)
+    {
+        thread->join();
+        delete thread;
+    }
 #else
-    pthread_join(task_loop_thread, NULL);
+    for (pthread_t thread : task_loop_threads)
+        pthread_join(thread, NULL);
 #endif
+    task_loop_threads.clear();
 }
-void Threading::std_task_loop() {
-    task_loop(nullptr);
+
+void Threading::std_task_loop(size_t worker)
+{
+    task_loop((void*)worker);
 }
+
 void* Threading::task_loop(void* a)
 {
+    size_t worker  = (size_t)a;
+    current_worker = worker;
+
     while (task_loop_active)
     {
-        std::vector<std::function<void()>> m_tasks_copy;
+        std::function<void()> task;
+        if (pop_task(worker, &task))
         {
-            std::lock_guard<std::mutex> guard(m_async_mutex);
-            m_tasks_copy = m_async_tasks;
-            m_async_tasks.clear();
+            try
+            {
+                task();
+            }
+            catch (std::exception& e)
+            {
+                brls::Logger::error("error: async task: {}", e.what());
+            }
+            continue;
         }
 
-        for (auto task : m_tasks_copy)
+        // Sleep until a task is posted
+        std::unique_lock<std::mutex> lock(m_async_mutex);
+        m_async_condition.wait(lock, []
+            { return m_async_pending > 0 || !task_loop_active; });
+    }
+    return NULL;
+}
+
+bool Threading::pop_task(size_t worker, std::function<void()>* task)
+{
+    size_t count = m_async_queues.size();
+    bool found   = false;
+
+    // Highest priority first, looking at our own queue then stealing from the others
+    for (size_t priority = 0; priority < 3 && !found; priority++)
+    {
+        for (size_t i = 0; i < count && !found; i++)
         {
-            task();
+            TaskQueue* queue = m_async_queues[(worker + i) % count];
+            std::lock_guard<std::mutex> guard(queue->mutex);
+
+            auto& tasks = queue->tasks[priority];
+            if (tasks.empty())
+                continue;
+
+            if (i == 0)
+            {
+                *task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            else
+            {
+                *task = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            found = true;
         }
+    }
 
-        retro_sleep(500);
+    if (found)
+    {
+        std::lock_guard<std::mutex> guard(m_async_mutex);
+        m_async_pending--;
     }
-    return NULL;
+
+    return found;
+}
+
+void Threading::init_task_queues()
+{
+    // Must be called with m_async_mutex held.
+    // Queues are never freed so workers can read the list without locking
+    if (!m_async_queues.empty())
+        return;
+
+    for (size_t i = 0; i < getWorkerCount(); i++)
+        m_async_queues.push_back(new TaskQueue());
 }
 
 void Threading::start_task_loop()
 {
+    {
+        std::lock_guard<std::mutex> guard(m_async_mutex);
+        init_task_queues();
+    }
+
+    if (!task_loop_threads.empty())
+        return;
+
+    for (size_t i = 0; i < m_async_queues.size(); i++)
+    {
 #ifdef BOREALIS_USE_STD_THREAD
-    task_loop_thread = new std::thread(std_task_loop);
+        task_loop_threads.push_back(new std::thread(std_task_loop, i));
 #else
-    pthread_create(&task_loop_thread, NULL, task_loop, NULL);
+        pthread_t thread;
+        pthread_create(&thread, NULL, task_loop, (void*)i);
+        task_loop_threads.push_back(thread);
 #endif
+    }
+
+    Logger::debug("Threading: started {} workers", task_loop_threads.size());
 }
 
 } // namespace brls
@@ -14,6 +14,7 @@
     limitations under the License.
 */
 
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/time.hpp>
 
 namespace brls
@@ -21,6 +22,8 @@ namespace brls
 
 void Ticking::updateTickings()
 {
+    BRLS_PROFILE_ZONE("tickings");
+
     // Update time
     static Time previousTime = 0;
 
@@ -23,6 +23,10 @@
 // Touch history limit which uses to calculate current pan speed
 #define HISTORY_LIMIT 5
 
+// Only the touch history younger than this (in usec) is used to calculate the pan speed,
+// so that stopping the finger before releasing it does not fling
+#define VELOCITY_WINDOW 100000
+
 // Negative acceleration to calculate
 // time to play acceleration animation
 #define PAN_SCROLL_ACCELERATION -3000
@@ -67,6 +71,8 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
     }
 
     static PanAcceleration acceleration;
+    Time now       = getCPUTimeUsec();
+    Point velocity = Point();
     switch (phase)
     {
         case TouchPhase::START:
@@ -127,32 +133,24 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
                     this->state = GestureState::END;
             }
 
-            // If last touch frame, calculate acceleration
+            if (this->state == GestureState::STAY || this->state == GestureState::END)
+                velocity = this->getVelocity(now);
 
+            // If last touch frame, calculate acceleration
+            // (the distance is the one to scroll, opposite to the finger movement)
             if (this->state == GestureState::END)
             {
-                float time = posHistory.size() * 1.0f / Application::getFPS();
-
-                float distanceX = posHistory[posHistory.size()-1].x - posHistory[0].x;
-                float distanceY = posHistory[posHistory.size()-1].y - posHistory[0].y;
+                acceleration.time.x = -fabs(velocity.x) / PAN_SCROLL_ACCELERATION;
+                acceleration.time.y = -fabs(velocity.y) / PAN_SCROLL_ACCELERATION;
 
-                float velocityX = distanceX / time;
-                float velocityY = distanceY / time;
-                if (panFactor > 0.0f) {
-                    velocityX *= panFactor;
-                    velocityY *= panFactor;
-                }
-
-                acceleration.time.x = -fabs(velocityX) / PAN_SCROLL_ACCELERATION;
-                acceleration.time.y = -fabs(velocityY) / PAN_SCROLL_ACCELERATION;
-
-                acceleration.distance.x = velocityX * acceleration.time.x / 2;
-                acceleration.distance.y = velocityY * acceleration.time.y / 2;
+                acceleration.distance.x = -velocity.x * acceleration.time.x / 2;
+                acceleration.distance.y = -velocity.y * acceleration.time.y / 2;
             }
 
             if (this->state == GestureState::START || this->state == GestureState::STAY || this->state == GestureState::END)
             {
                 PanGestureStatus state = getCurrentStatus();
+                state.velocity         = velocity;
                 state.acceleration     = acceleration;
                 this->panEvent.fire(state, soundToPlay);
             }
@@ -164,7 +162,7 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
     }
 
     // Add current state to history
-    posHistory.insert(posHistory.begin(), this->position);
+    posHistory.insert(posHistory.begin(), PanSample { this->position, now });
     while (posHistory.size() > HISTORY_LIMIT)
     {
         posHistory.pop_back();
@@ -174,6 +172,28 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
     return this->state;
 }
 
+Point PanGestureRecognizer::getVelocity(Time now)
+{
+    // The newest sample is the current position, not in the history yet
+    PanSample oldest = { this->position, now };
+    for (const PanSample& sample : posHistory)
+    {
+        if (now - sample.time > VELOCITY_WINDOW)
+            break;
+        oldest = sample;
+    }
+
+    float time = (now - oldest.time) / 1000000.0f;
+    if (time <= 0)
+        return Point();
+
+    Point velocity = (this->position - oldest.position) / time;
+    if (panFactor > 0.0f)
+        velocity = velocity * panFactor;
+
+    return velocity;
+}
+
 PanGestureStatus PanGestureRecognizer::getCurrentStatus()
 {
     return PanGestureStatus {
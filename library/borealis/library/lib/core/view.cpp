@@ -30,11 +30,25 @@
 #include <borealis/core/box.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/applet_frame.hpp>
 #include <fstream>
 
+#ifdef USE_BOOST_FILESYSTEM
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#elif __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include("experimental/filesystem")
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error "Failed to include <filesystem> header!"
+#endif
+
 // Avoid conflicts with macro definitions in windows.h
 #undef RGB
 #undef TRANSPARENT
@@ -46,6 +60,25 @@ using namespace brls::literals;
 namespace brls
 {
 
+// Keys looked up on every frame
+static const ThemeKey THEME_CLICK_PULSE("brls/click_pulse");
+static const ThemeKey THEME_HIGHLIGHT_BACKGROUND("brls/highlight/background");
+static const ThemeKey THEME_HIGHLIGHT_COLOR1("brls/highlight/color1");
+static const ThemeKey THEME_HIGHLIGHT_COLOR2("brls/highlight/color2");
+static const ThemeKey THEME_SIDEBAR_BACKGROUND("brls/sidebar/background");
+static const ThemeKey THEME_BACKDROP("brls/backdrop");
+static const StyleKey STYLE_HIGHLIGHT_STROKE_WIDTH("brls/highlight/stroke_width");
+static const StyleKey STYLE_ANIMATIONS_HIGHLIGHT_SHAKE("brls/animations/highlight_shake");
+static const StyleKey STYLE_HIGHLIGHT_SHADOW_OFFSET("brls/highlight/shadow_offset");
+static const StyleKey STYLE_HIGHLIGHT_SHADOW_WIDTH("brls/highlight/shadow_width");
+static const StyleKey STYLE_HIGHLIGHT_SHADOW_FEATHER("brls/highlight/shadow_feather");
+static const StyleKey STYLE_HIGHLIGHT_SHADOW_OPACITY("brls/highlight/shadow_opacity");
+static const StyleKey STYLE_SHADOW_WIDTH("brls/shadow/width");
+static const StyleKey STYLE_SHADOW_FEATHER("brls/shadow/feather");
+static const StyleKey STYLE_SHADOW_OPACITY("brls/shadow/opacity");
+static const StyleKey STYLE_SHADOW_OFFSET("brls/shadow/offset");
+static const StyleKey STYLE_SIDEBAR_BORDER_HEIGHT("brls/sidebar/border_height");
+
 void AppletFrameItem::setHintView(View* hintView)
 {
     this->hintView = hintView;
@@ -164,6 +197,8 @@ void View::frame(FrameContext* ctx)
     if (this->visibility != Visibility::VISIBLE)
         return;
 
+    BRLS_PROFILE_VIEW(this);
+
     Style style    = Application::getStyle();
     Theme oldTheme = ctx->theme;
 
@@ -303,7 +338,7 @@ const std::vector<std::shared_ptr<Action> >& View::getActions()
 void View::drawClickAnimation(NVGcontext* vg, FrameContext* ctx, Rect frame)
 {
     Theme theme    = ctx->theme;
-    NVGcolor color = theme["brls/click_pulse"];
+    NVGcolor color = theme[THEME_CLICK_PULSE];
 
     color.a *= this->clickAlpha;
 
@@ -443,10 +478,10 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
     switch (this->shadowType)
     {
         case ShadowType::GENERIC:
-            shadowWidth   = style["brls/shadow/width"];
-            shadowFeather = style["brls/shadow/feather"];
-            shadowOpacity = style["brls/shadow/opacity"];
-            shadowOffset  = style["brls/shadow/offset"];
+            shadowWidth   = style[STYLE_SHADOW_WIDTH];
+            shadowFeather = style[STYLE_SHADOW_FEATHER];
+            shadowOpacity = style[STYLE_SHADOW_OPACITY];
+            shadowOffset  = style[STYLE_SHADOW_OFFSET];
             break;
         case ShadowType::CUSTOM:
             break;
@@ -528,6 +563,7 @@ void View::expand(bool animated)
 void View::setAlpha(float alpha)
 {
     this->alpha = alpha;
+    this->setNeedsRedraw();
 }
 
 void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style, bool background)
@@ -540,7 +576,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
 
     float padding      = this->highlightPadding;
     float cornerRadius = this->highlightCornerRadius;
-    float strokeWidth  = style["brls/highlight/stroke_width"];
+    float strokeWidth  = style[STYLE_HIGHLIGHT_STROKE_WIDTH];
 
     float x      = this->getX() - padding - strokeWidth / 2;
     float y      = this->getY() - padding - strokeWidth / 2;
@@ -553,7 +589,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         Time curTime = getCPUTimeUsec() / 1000;
         Time t       = (curTime - highlightShakeStart) / 10;
 
-        if (t >= style["brls/animations/highlight_shake"])
+        if (t >= style[STYLE_ANIMATIONS_HIGHLIGHT_SHAKE])
         {
             this->highlightShaking = false;
         }
@@ -581,7 +617,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     if (background)
     {
         // Background
-        NVGcolor highlightBackgroundColor = theme["brls/highlight/background"];
+        NVGcolor highlightBackgroundColor = theme[THEME_HIGHLIGHT_BACKGROUND];
         nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha));
         nvgBeginPath(vg);
         nvgRoundedRect(vg, x, y, width, height, cornerRadius);
@@ -592,19 +628,19 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
 #ifdef SIMPLE_HIGHLIGHT
         // Border
         nvgBeginPath(vg);
-        nvgStrokeColor(vg, a(theme["brls/highlight/color1"]));
-        nvgStrokeWidth(vg, style["brls/highlight/stroke_width"]);
+        nvgStrokeColor(vg, a(theme[THEME_HIGHLIGHT_COLOR1]));
+        nvgStrokeWidth(vg, style[STYLE_HIGHLIGHT_STROKE_WIDTH]);
         nvgRoundedRect(vg, x, y, width, height, cornerRadius);
         nvgStroke(vg);
 #else
-        float shadowOffset = style["brls/highlight/shadow_offset"];
+        float shadowOffset = style[STYLE_HIGHLIGHT_SHADOW_OFFSET];
 
         // Shadow
         NVGpaint shadowPaint = nvgBoxGradient(vg,
-            x, y + style["brls/highlight/shadow_width"],
+            x, y + style[STYLE_HIGHLIGHT_SHADOW_WIDTH],
             width, height,
-            cornerRadius * 2, style["brls/highlight/shadow_feather"],
-            RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha), TRANSPARENT);
+            cornerRadius * 2, style[STYLE_HIGHLIGHT_SHADOW_FEATHER],
+            RGBA(0, 0, 0, style[STYLE_HIGHLIGHT_SHADOW_OPACITY] * alpha), TRANSPARENT);
 
         nvgBeginPath(vg);
         nvgRect(vg, x - shadowOffset, y - shadowOffset,
@@ -618,17 +654,17 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         float gradientX, gradientY, color;
         getHighlightAnimation(&gradientX, &gradientY, &color);
 
-        NVGcolor highlightColor1 = theme["brls/highlight/color1"];
+        NVGcolor highlightColor1 = theme[THEME_HIGHLIGHT_COLOR1];
 
         NVGcolor pulsationColor = RGBAf((color * highlightColor1.r) + (1 - color) * highlightColor1.r,
             (color * highlightColor1.g) + (1 - color) * highlightColor1.g,
             (color * highlightColor1.b) + (1 - color) * highlightColor1.b,
             alpha);
 
-        NVGcolor borderColor = theme["brls/highlight/color2"];
+        NVGcolor borderColor = theme[THEME_HIGHLIGHT_COLOR2];
         borderColor.a        = 0.5f * alpha * this->getAlpha();
 
-        float strokeWidth = style["brls/highlight/stroke_width"];
+        float strokeWidth = style[STYLE_HIGHLIGHT_STROKE_WIDTH];
 
         NVGpaint border1Paint = nvgRadialGradient(vg,
             x + gradientX * width, y + gradientY * height,
@@ -666,6 +702,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
 void View::setBackground(ViewBackground background)
 {
     this->background = background;
+    this->setNeedsRedraw();
 }
 
 void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame)
@@ -681,8 +718,8 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect f
     {
         case ViewBackground::SIDEBAR:
         {
-            float backdropHeight  = style["brls/sidebar/border_height"];
-            NVGcolor sidebarColor = theme["brls/sidebar/background"];
+            float backdropHeight  = style[STYLE_SIDEBAR_BORDER_HEIGHT];
+            NVGcolor sidebarColor = theme[THEME_SIDEBAR_BACKGROUND];
 
             // Solid color
             nvgBeginPath(vg);
@@ -720,7 +757,7 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect f
         }
         case ViewBackground::BACKDROP:
         {
-            nvgFillColor(vg, a(theme["brls/backdrop"]));
+            nvgFillColor(vg, a(theme[THEME_BACKDROP]));
             nvgBeginPath(vg);
             nvgRect(vg, x, y, width, height);
             nvgFill(vg);
@@ -837,6 +874,8 @@ void View::setParent(Box* parent, void* parentUserdata)
 
     this->parent         = parent;
     this->parentUserdata = parentUserdata;
+
+    View::invalidateGeometry();
 }
 
 void* View::getParentUserData()
@@ -1215,9 +1254,73 @@ void View::invalidate()
         YGNodeMarkDirty(this->ygNode);
 
     if (this->hasParent() && !this->detached)
+    {
         this->getParent()->invalidate();
-    else
-        YGNodeCalculateLayout(this->ygNode, YGUndefined, YGUndefined, YGDirectionLTR);
+    }
+    else if (!this->layoutPending)
+    {
+        this->layoutPending = true;
+        Application::requestLayout(this);
+    }
+}
+
+void View::setNeedsRedraw()
+{
+    Application::requestRedraw();
+}
+
+void View::invalidateGeometry()
+{
+    View::geometryEpoch++;
+    Application::requestRedraw();
+}
+
+size_t View::getLayoutEpoch()
+{
+    return View::layoutEpoch;
+}
+
+View* View::getLayoutRoot()
+{
+    View* root = this;
+    while (root->hasParent() && !root->isDetached())
+        root = root->getParent();
+    return root;
+}
+
+void View::layoutIfNeeded()
+{
+    View* root = this->getLayoutRoot();
+    if (!root->layoutPending)
+        return;
+
+    Application::cancelLayout(root);
+    root->performPendingLayout();
+}
+
+void View::performPendingLayout()
+{
+    if (!this->layoutPending)
+        return;
+
+    this->layoutPending = false;
+
+    // The view may have been attached to a parent since it was invalidated,
+    // in which case the layout of its new root takes care of it
+    if (this->hasParent() && !this->detached)
+        return;
+
+    YGNodeCalculateLayout(this->ygNode, YGUndefined, YGUndefined, YGDirectionLTR);
+    View::layoutEpoch++;
+    View::invalidateGeometry();
+}
+
+void View::invalidateFrameInParent()
+{
+    if (this->hasParent())
+        static_cast<View*>(this->getParent())->childrenEpoch++;
+
+    View::invalidateGeometry();
 }
 
 Rect View::getFrame()
@@ -1225,18 +1328,38 @@ Rect View::getFrame()
     return Rect(getX(), getY(), getWidth(), getHeight());
 }
 
-float View::getX()
+void View::updateAbsoluteOrigin()
 {
+    if (this->absoluteOriginEpoch == View::geometryEpoch)
+        return;
+
     if (this->hasParent())
-        return this->getParent()->getX() + YGNodeLayoutGetLeft(this->ygNode) + this->translation.x + (isDetached() ? this->detachedOrigin.x : 0);
-    return YGNodeLayoutGetLeft(this->ygNode) + this->translation.x;
+    {
+        Box* parent = this->getParent();
+        parent->updateAbsoluteOrigin();
+
+        this->absoluteOrigin.x = parent->absoluteOrigin.x + this->getLocalX();
+        this->absoluteOrigin.y = parent->absoluteOrigin.y + this->getLocalY();
+    }
+    else
+    {
+        this->absoluteOrigin.x = YGNodeLayoutGetLeft(this->ygNode) + this->translation.x;
+        this->absoluteOrigin.y = YGNodeLayoutGetTop(this->ygNode) + this->translation.y;
+    }
+
+    this->absoluteOriginEpoch = View::geometryEpoch;
+}
+
+float View::getX()
+{
+    this->updateAbsoluteOrigin();
+    return this->absoluteOrigin.x;
 }
 
 float View::getY()
 {
-    if (this->hasParent())
-        return this->getParent()->getY() + YGNodeLayoutGetTop(this->ygNode) + this->translation.y + (isDetached() ? this->detachedOrigin.y : 0);
-    return YGNodeLayoutGetTop(this->ygNode) + this->translation.y;
+    this->updateAbsoluteOrigin();
+    return this->absoluteOrigin.y;
 }
 
 Rect View::getLocalFrame()
@@ -1267,22 +1390,26 @@ float View::getWidth()
 void View::detach()
 {
     this->detached = true;
+    this->invalidateFrameInParent();
 }
 
 void View::setDetachedPosition(float x, float y)
 {
     this->detachedOrigin.x = x;
     this->detachedOrigin.y = y;
+    this->invalidateFrameInParent();
 }
 
 void View::setDetachedPositionX(float x)
 {
     this->detachedOrigin.x = x;
+    this->invalidateFrameInParent();
 }
 
 void View::setDetachedPositionY(float y)
 {
     this->detachedOrigin.y = y;
+    this->invalidateFrameInParent();
 }
 
 bool View::isDetached()
@@ -1541,6 +1668,9 @@ View::~View()
     highlightAlpha.stop();
     collapseState.stop();
 
+    if (this->layoutPending)
+        Application::cancelLayout(this);
+
     YGNodeFree(this->ygNode);
 
     if (deletionToken)
@@ -1573,32 +1703,65 @@ std::string View::getFilePathXMLAttributeValue(std::string value)
     return value;
 }
 
+// Resolved by the first view created from each element of a layout, for the next ones
+struct XMLLayoutCache
+{
+    // View creator of each string used as an element name
+    std::vector<XMLViewCreator> creators;
+
+    // Value of each attribute, with the class it was resolved for
+    std::vector<std::pair<const XMLAttributeTable*, XMLAttributeValue>> attributes;
+};
+
+// Defined here as the XMLLayout sources are also built into brls-xml-compiler
+XMLLayoutCache* XMLLayout::getCache()
+{
+    if (!this->cache)
+    {
+        this->cache = std::make_shared<XMLLayoutCache>();
+        this->cache->attributes.resize(this->attributes.size());
+    }
+
+    return this->cache.get();
+}
+
 bool View::applyXMLAttribute(std::string name, std::string value)
+{
+    XMLAttributeValue resolved;
+
+    if (!this->resolveXMLAttribute(name, value, &resolved))
+        return false;
+
+    this->applyXMLAttributeValue(resolved);
+    return true;
+}
+
+bool View::overridesXMLAttribute(const std::string& name)
+{
+    return this->instanceAttributes && this->instanceAttributes->knownAttributes.count(name) > 0;
+}
+
+bool View::resolveXMLAttribute(const std::string& name, const std::string& value, XMLAttributeValue* resolved)
 {
     // String -> string
-    if (this->stringAttributes.count(name) > 0)
+    if (auto handler = this->findXMLAttribute(&XMLAttributeTable::stringAttributes, name))
     {
         if (startsWith(value, "@i18n/"))
-        {
-            this->stringAttributes[name](View::getStringXMLAttributeValue(value));
-            return true;
-        }
+            return resolved->setString(XMLAttributeValue::Type::STRING, handler, View::getStringXMLAttributeValue(value));
 
-        this->stringAttributes[name](value);
-        return true;
+        return resolved->setString(XMLAttributeValue::Type::STRING, handler, value);
     }
 
     // File path -> file path
     if (startsWith(value, "@res/"))
     {
-        if (this->filePathAttributes.count(name) > 0)
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::filePathAttributes, name))
         {
 #ifdef USE_LIBROMFS
-            this->filePathAttributes[name](value);
+            return resolved->setString(XMLAttributeValue::Type::FILE_PATH, handler, value);
 #else
-            this->filePathAttributes[name](View::getFilePathXMLAttributeValue(value));
+            return resolved->setString(XMLAttributeValue::Type::FILE_PATH, handler, View::getFilePathXMLAttributeValue(value));
 #endif
-            return true;
         }
         else
         {
@@ -1607,11 +1770,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     }
     else
     {
-        if (this->filePathAttributes.count(name) > 0)
-        {
-            this->filePathAttributes[name](value);
-            return true;
-        }
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::filePathAttributes, name))
+            return resolved->setString(XMLAttributeValue::Type::FILE_PATH, handler, value);
 
         // don't return false as it can be anything else
     }
@@ -1619,9 +1779,10 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     // Auto -> auto
     if (value == "auto")
     {
-        if (this->autoAttributes.count(name) > 0)
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::autoAttributes, name))
         {
-            this->autoAttributes[name]();
+            resolved->type        = XMLAttributeValue::Type::AUTO;
+            resolved->autoHandler = handler;
             return true;
         }
         else
@@ -1638,11 +1799,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
         try
         {
             float floatValue = std::stof(newFloat);
-            if (this->floatAttributes.count(name) > 0)
-            {
-                this->floatAttributes[name](floatValue);
-                return true;
-            }
+            if (auto handler = this->findXMLAttribute(&XMLAttributeTable::floatAttributes, name))
+                return resolved->setNumber(XMLAttributeValue::Type::FLOAT, handler, floatValue);
             else
             {
                 return false;
@@ -1666,11 +1824,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
             if (floatValue < -100 || floatValue > 100)
                 return false;
 
-            if (this->percentageAttributes.count(name) > 0)
-            {
-                this->percentageAttributes[name](floatValue);
-                return true;
-            }
+            if (auto handler = this->findXMLAttribute(&XMLAttributeTable::percentageAttributes, name))
+                return resolved->setNumber(XMLAttributeValue::Type::PERCENTAGE, handler, floatValue);
             else
             {
                 return false;
@@ -1688,11 +1843,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
         std::string styleName = value.substr(7); // length of "@style/"
         float value           = Application::getStyle()[styleName]; // will throw logic_error if the metric doesn't exist
 
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](value);
-            return true;
-        }
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::floatAttributes, name))
+            return resolved->setNumber(XMLAttributeValue::Type::FLOAT, handler, value);
         else
         {
             return false;
@@ -1717,10 +1869,9 @@ bool View::applyXMLAttribute(std::string name, std::string value)
             {
                 return false;
             }
-            else if (this->colorAttributes.count(name) > 0)
+            else if (auto handler = this->findXMLAttribute(&XMLAttributeTable::colorAttributes, name))
             {
-                this->colorAttributes[name](nvgRGB(r, g, b));
-                return true;
+                return resolved->setColor(handler, nvgRGB(r, g, b));
             }
             else
             {
@@ -1744,10 +1895,9 @@ bool View::applyXMLAttribute(std::string name, std::string value)
             {
                 return false;
             }
-            else if (this->colorAttributes.count(name) > 0)
+            else if (auto handler = this->findXMLAttribute(&XMLAttributeTable::colorAttributes, name))
             {
-                this->colorAttributes[name](nvgRGBA(r, g, b, a));
-                return true;
+                return resolved->setColor(handler, nvgRGBA(r, g, b, a));
             }
             else
             {
@@ -1766,10 +1916,11 @@ bool View::applyXMLAttribute(std::string name, std::string value)
         std::string colorName = value.substr(7); // length of "@theme/"
         NVGcolor value        = Application::getTheme()[colorName]; // will throw logic_error if the color doesn't exist
 
-        if (this->colorAttributes.count(name) > 0)
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::colorAttributes, name))
         {
-            this->colorAttributes[name](value);
-            return true;
+            // The theme can change, do not reuse the color for other views
+            resolved->reusable = false;
+            return resolved->setColor(handler, value);
         }
         else
         {
@@ -1781,9 +1932,11 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     {
         bool boolValue = value == "true" ? true : false;
 
-        if (this->boolAttributes.count(name) > 0)
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::boolAttributes, name))
         {
-            this->boolAttributes[name](boolValue);
+            resolved->type        = XMLAttributeValue::Type::BOOL;
+            resolved->boolHandler = handler;
+            resolved->boolean     = boolValue;
             return true;
         }
         else
@@ -1796,11 +1949,8 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     try
     {
         float newValue = std::stof(value);
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](newValue);
-            return true;
-        }
+        if (auto handler = this->findXMLAttribute(&XMLAttributeTable::floatAttributes, name))
+            return resolved->setNumber(XMLAttributeValue::Type::FLOAT, handler, newValue);
         else
         {
             return false;
@@ -1812,6 +1962,30 @@ bool View::applyXMLAttribute(std::string name, std::string value)
     }
 }
 
+void View::applyXMLAttributeValue(const XMLAttributeValue& value)
+{
+    switch (value.type)
+    {
+        case XMLAttributeValue::Type::AUTO:
+            (*value.autoHandler)(this);
+            break;
+        case XMLAttributeValue::Type::PERCENTAGE:
+        case XMLAttributeValue::Type::FLOAT:
+            (*value.floatHandler)(this, value.number);
+            break;
+        case XMLAttributeValue::Type::STRING:
+        case XMLAttributeValue::Type::FILE_PATH:
+            (*value.stringHandler)(this, value.string);
+            break;
+        case XMLAttributeValue::Type::COLOR:
+            (*value.colorHandler)(this, value.color);
+            break;
+        case XMLAttributeValue::Type::BOOL:
+            (*value.boolHandler)(this, value.boolean);
+            break;
+    }
+}
+
 void View::applyXMLAttributes(tinyxml2::XMLElement* element)
 {
     if (!element)
@@ -1823,13 +1997,83 @@ void View::applyXMLAttributes(tinyxml2::XMLElement* element)
         std::string value = std::string(attribute->Value());
 
         if (!this->applyXMLAttribute(name, value))
-            this->printXMLAttributeErrorMessage(element, name, value);
+            this->printXMLAttributeErrorMessage(element->Name(), name, value);
+    }
+}
+
+void View::applyXMLAttributes(XMLLayout* layout, size_t element)
+{
+    const XMLLayout::Element& compiled = layout->getElement(element);
+    XMLLayoutCache* cache              = layout->getCache();
+
+    for (uint32_t i = 0; i < compiled.attributeCount; i++)
+    {
+        const XMLLayout::Attribute& attribute = layout->getAttribute(compiled.firstAttribute + i);
+        const std::string& name               = layout->getString(attribute.name);
+        const std::string& value              = layout->getString(attribute.value);
+
+        if (this->overridesXMLAttribute(name))
+        {
+            if (!this->applyXMLAttribute(name, value))
+                this->printXMLAttributeErrorMessage(layout->getString(compiled.name), name, value);
+
+            continue;
+        }
+
+        // Parsed for a previous view of the same class
+        std::pair<const XMLAttributeTable*, XMLAttributeValue>& cached = cache->attributes[compiled.firstAttribute + i];
+        if (cached.first == this->classAttributes)
+        {
+            this->applyXMLAttributeValue(cached.second);
+            continue;
+        }
+
+        XMLAttributeValue resolved;
+        if (!this->resolveXMLAttribute(name, value, &resolved))
+            this->printXMLAttributeErrorMessage(layout->getString(compiled.name), name, value);
+
+        this->applyXMLAttributeValue(resolved);
+
+        if (resolved.reusable)
+            cached = { this->classAttributes, std::move(resolved) };
     }
 }
 
+template <typename Handler>
+const Handler* View::findXMLAttribute(std::unordered_map<std::string, Handler> XMLAttributeTable::*attributes, const std::string& name)
+{
+    // Instance attributes first, then from the most derived class to View
+    if (this->instanceAttributes)
+    {
+        auto& handlers = (*this->instanceAttributes).*attributes;
+        auto it        = handlers.find(name);
+        if (it != handlers.end())
+            return &it->second;
+    }
+
+    for (const XMLAttributeTable* table = this->classAttributes; table; table = table->parent)
+    {
+        auto& handlers = table->*attributes;
+        auto it        = handlers.find(name);
+        if (it != handlers.end())
+            return &it->second;
+    }
+
+    return nullptr;
+}
+
 bool View::isXMLAttributeValid(std::string attributeName)
 {
-    return this->knownAttributes.count(attributeName) > 0;
+    if (this->instanceAttributes && this->instanceAttributes->knownAttributes.count(attributeName) > 0)
+        return true;
+
+    for (const XMLAttributeTable* table = this->classAttributes; table; table = table->parent)
+    {
+        if (table->knownAttributes.count(attributeName) > 0)
+            return true;
+    }
+
+    return false;
 }
 
 View* View::createFromXMLResource(std::string name)
@@ -1840,52 +2084,206 @@ View* View::createFromXMLResource(std::string name)
         return View::createFromXMLFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
     }
 
-#ifdef USE_LIBROMFS
-    return View::createFromXMLString(romfs::get("xml/" + name).string());
-#else
-    return View::createFromXMLFile(std::string(BRLS_RESOURCES) + "xml/" + name);
-#endif
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayoutResource("xml/" + name, &error);
+
+    if (!layout)
+        fatal("Unable to load XML resource \"" + name + "\": " + error);
+
+    return View::createFromXMLLayout(layout.get());
 }
 
 View* View::createFromXMLString(std::string_view xml)
 {
-    std::shared_ptr<tinyxml2::XMLDocument> document = getXMLCache(xml);
-    tinyxml2::XMLElement* element = document->RootElement();
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayout(xml, &error);
+
+    if (!layout)
+        fatal("Invalid XML when creating View from XML: " + error);
+
+    return View::createFromXMLLayout(layout.get());
+}
+
+View* View::createFromXMLFile(std::string path)
+{
+    std::string error;
+    std::shared_ptr<XMLLayout> layout = View::getXMLLayoutFile(path, &error);
 
-    if (!element) {
-        tinyxml2::XMLError error = document->Parse(xml.data());
+    if (!layout)
+        fatal("Unable to load XML file \"" + path + "\": " + error);
 
-        if (error != tinyxml2::XMLError::XML_SUCCESS)
-            fatal("Invalid XML when creating View from XML: error " + std::to_string(error));
+    return View::createFromXMLLayout(layout.get());
+}
 
-        element = document->RootElement();
+std::shared_ptr<XMLLayout> View::getXMLLayout(std::string_view xml, std::string* error)
+{
+    // Keyed by the hash of the content, kept along to tell collisions apart
+    static std::unordered_multimap<size_t, std::pair<std::string, std::shared_ptr<XMLLayout>>> layouts;
 
-        if (!element)
-            fatal("Invalid XML: no element found");
+    size_t hash = std::hash<std::string_view> {}(xml);
+    auto range  = layouts.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.first == xml)
+            return it->second.second;
     }
 
-    View* view = View::createFromXMLElement(element);
-    return view;
+    std::shared_ptr<XMLLayout> layout = XMLLayout::parse(xml, error);
+
+    if (layout)
+        layouts.emplace(hash, std::make_pair(std::string(xml), layout));
+
+    return layout;
 }
 
-View* View::createFromXMLFile(std::string path)
+// A compiled layout is only used if it is at least as recent as its XML file:
+// an XML edited after it was compiled is parsed instead of the stale .bxml
+static bool isCompiledLayoutUpToDate(const std::string& compiledPath, const std::string& path)
+{
+    try
+    {
+        if (compiledPath.empty() || !fs::exists(compiledPath))
+            return false;
+
+        // Layouts shipped without their XML
+        if (!fs::exists(path))
+            return true;
+
+        return fs::last_write_time(compiledPath) >= fs::last_write_time(path);
+    }
+    catch (const fs::filesystem_error&)
+    {
+        return false;
+    }
+}
+
+std::shared_ptr<XMLLayout> View::getXMLLayoutFile(const std::string& path, std::string* error)
+{
+    static std::unordered_map<std::string, std::shared_ptr<XMLLayout>> layouts;
+
+    auto it = layouts.find(path);
+    if (it != layouts.end())
+        return it->second;
+
+    std::shared_ptr<XMLLayout> layout;
+    std::string compiledPath = XMLLayout::getCompiledPath(path);
+
+    if (isCompiledLayoutUpToDate(compiledPath, path))
+        layout = XMLLayout::load(compiledPath, error);
+    else
+        layout = XMLLayout::load(path, error);
+
+    if (layout)
+        layouts[path] = layout;
+
+    return layout;
+}
+
+std::shared_ptr<XMLLayout> View::getXMLLayoutResource(const std::string& path, std::string* error)
 {
-    std::shared_ptr<tinyxml2::XMLDocument> document = getXMLCache(path);
-    tinyxml2::XMLElement* element = document->RootElement();
+#ifdef USE_LIBROMFS
+    static std::unordered_map<std::string, std::shared_ptr<XMLLayout>> layouts;
+
+    auto it = layouts.find(path);
+    if (it != layouts.end())
+        return it->second;
+
+    std::shared_ptr<XMLLayout> layout;
+    std::string compiledPath = XMLLayout::getCompiledPath(path);
+
+    if (!compiledPath.empty())
+    {
+        try
+        {
+            layout = XMLLayout::decode(romfs::get(compiledPath).string());
+
+            if (!layout)
+            {
+                *error = "invalid compiled layout";
+                return nullptr;
+            }
+        }
+        catch (const std::invalid_argument&)
+        {
+            // Not compiled, use the XML
+        }
+    }
+
+    if (!layout)
+        layout = XMLLayout::parse(romfs::get(path).string(), error);
+
+    if (layout)
+        layouts[path] = layout;
+
+    return layout;
+#else
+    return View::getXMLLayoutFile(std::string(BRLS_RESOURCES) + path, error);
+#endif
+}
+
+View* View::createFromXMLLayout(XMLLayout* layout, size_t element)
+{
+    const XMLLayout::Element& compiled = layout->getElement(element);
+    const std::string& viewName        = layout->getString(compiled.name);
+
+    // Instantiate the view
+    View* view = nullptr;
+
+    // Special case where element name is brls:View, see createFromXMLElement()
+    if (viewName == "brls:View")
+    {
+        const std::string* xml = layout->findAttribute(element, "xml");
+
+        if (!xml)
+            fatal("brls:View XML tag must have an \"xml\" attribute");
+
+        std::string error;
+#ifdef USE_LIBROMFS
+        std::shared_ptr<XMLLayout> included = View::getXMLLayoutResource(View::getFilePathXMLAttributeValue(*xml), &error);
+#else
+        std::shared_ptr<XMLLayout> included = View::getXMLLayoutFile(View::getFilePathXMLAttributeValue(*xml), &error);
+#endif
+
+        if (!included)
+            fatal("Unable to load XML file \"" + *xml + "\": " + error);
+
+        view = View::createFromXMLLayout(included.get());
+    }
+    // Otherwise look in the register, once per layout and element name
+    else
+    {
+        XMLLayoutCache* cache = layout->getCache();
 
-    if (!element) {
-        tinyxml2::XMLError error = document->LoadFile(path.c_str());
+        if (cache->creators.size() <= compiled.name)
+            cache->creators.resize(compiled.name + 1);
 
-        if (error != tinyxml2::XMLError::XML_SUCCESS)
-            fatal("Unable to load XML file \"" + path + "\": error " + std::to_string(error));
+        XMLViewCreator& creator = cache->creators[compiled.name];
 
-        element = document->RootElement();
+        if (!creator)
+        {
+            if (!Application::XMLViewsRegisterContains(viewName))
+                fatal("Unknown XML tag \"" + viewName + "\"");
 
-        if (!element)
-            fatal("Unable to load XML file \"" + path + "\": no root element found, is the file empty?");
+            creator = Application::getXMLViewCreator(viewName);
+        }
+
+        view = creator();
+
+        view->applyXMLAttributes(layout, element);
+    }
+
+    unsigned count = 0;
+    unsigned max   = view->getMaximumAllowedXMLElements();
+    for (size_t child = element + 1; child < compiled.end; child = layout->getElement(child).end)
+    {
+        if (count >= max)
+            fatal("View \"" + view->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
+        else
+            view->handleXMLElement(layout->getXMLElement(child));
+
+        count++;
     }
 
-    View* view = View::createFromXMLElement(element);
     return view;
 }
 
@@ -1894,6 +2292,11 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
     if (!element)
         return nullptr;
 
+    // Elements given to handleXMLElement() by createFromXMLLayout()
+    size_t index;
+    if (XMLLayout* layout = XMLLayout::fromXMLElement(element, &index))
+        return View::createFromXMLLayout(layout, index);
+
     std::string viewName = element->Name();
 
     // Instantiate the view
@@ -1963,387 +2366,397 @@ unsigned View::getMaximumAllowedXMLElements()
 
 void View::registerCommonAttributes()
 {
-    // Width
-    this->registerAutoXMLAttribute("width", [this] {
-        this->setWidth(View::AUTO);
-    });
-
-    this->registerFloatXMLAttribute("width", [this](float value) {
-        this->setWidth(value);
-    });
-
-    this->registerPercentageXMLAttribute("width", [this](float value) {
-        this->setWidthPercentage(value);
-    });
+    this->registerXMLAttributes<View>([](XMLAttributes<View>& attributes) {
+        // Width
+        attributes.registerAutoXMLAttribute("width", [](View* view) {
+            view->setWidth(View::AUTO);
+        });
 
-    // Height
-    this->registerAutoXMLAttribute("height", [this] {
-        this->setHeight(View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("width", [](View* view, float value) {
+            view->setWidth(value);
+        });
 
-    this->registerFloatXMLAttribute("height", [this](float value) {
-        this->setHeight(value);
-    });
+        attributes.registerPercentageXMLAttribute("width", [](View* view, float value) {
+            view->setWidthPercentage(value);
+        });
 
-    this->registerPercentageXMLAttribute("height", [this](float value) {
-        this->setHeightPercentage(value);
-    });
+        // Height
+        attributes.registerAutoXMLAttribute("height", [](View* view) {
+            view->setHeight(View::AUTO);
+        });
 
-    // Min width
-    this->registerAutoXMLAttribute("minWidth", [this] {
-        this->setMinWidth(View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("height", [](View* view, float value) {
+            view->setHeight(value);
+        });
 
-    this->registerFloatXMLAttribute("minWidth", [this](float value) {
-        this->setMinWidth(value);
-    });
+        attributes.registerPercentageXMLAttribute("height", [](View* view, float value) {
+            view->setHeightPercentage(value);
+        });
 
-    this->registerPercentageXMLAttribute("minWidth", [this](float percentage) {
-        this->setMinWidthPercentage(percentage);
-    });
+        // Min width
+        attributes.registerAutoXMLAttribute("minWidth", [](View* view) {
+            view->setMinWidth(View::AUTO);
+        });
 
-    // Min height
-    this->registerAutoXMLAttribute("minHeight", [this] {
-        this->setMinHeight(View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("minWidth", [](View* view, float value) {
+            view->setMinWidth(value);
+        });
 
-    this->registerFloatXMLAttribute("minHeight", [this](float value) {
-        this->setMinHeight(value);
-    });
+        attributes.registerPercentageXMLAttribute("minWidth", [](View* view, float percentage) {
+            view->setMinWidthPercentage(percentage);
+        });
 
-    this->registerPercentageXMLAttribute("minHeight", [this](float percentage) {
-        this->setMinHeightPercentage(percentage);
-    });
+        // Min height
+        attributes.registerAutoXMLAttribute("minHeight", [](View* view) {
+            view->setMinHeight(View::AUTO);
+        });
 
-    // Max width
-    this->registerAutoXMLAttribute("maxWidth", [this] {
-        this->setMaxWidth(View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("minHeight", [](View* view, float value) {
+            view->setMinHeight(value);
+        });
 
-    this->registerFloatXMLAttribute("maxWidth", [this](float value) {
-        this->setMaxWidth(value);
-    });
+        attributes.registerPercentageXMLAttribute("minHeight", [](View* view, float percentage) {
+            view->setMinHeightPercentage(percentage);
+        });
 
-    this->registerPercentageXMLAttribute("maxWidth", [this](float percentage) {
-        this->setMaxWidthPercentage(percentage);
-    });
+        // Max width
+        attributes.registerAutoXMLAttribute("maxWidth", [](View* view) {
+            view->setMaxWidth(View::AUTO);
+        });
 
-    // Max height
-    this->registerAutoXMLAttribute("maxHeight", [this] {
-        this->setMaxHeight(View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("maxWidth", [](View* view, float value) {
+            view->setMaxWidth(value);
+        });
 
-    this->registerFloatXMLAttribute("maxHeight", [this](float value) {
-        this->setMaxHeight(value);
-    });
+        attributes.registerPercentageXMLAttribute("maxWidth", [](View* view, float percentage) {
+            view->setMaxWidthPercentage(percentage);
+        });
 
-    this->registerPercentageXMLAttribute("maxHeight", [this](float percentage) {
-        this->setMaxHeightPercentage(percentage);
-    });
+        // Max height
+        attributes.registerAutoXMLAttribute("maxHeight", [](View* view) {
+            view->setMaxHeight(View::AUTO);
+        });
 
-    // Grow and shrink
-    this->registerFloatXMLAttribute("grow", [this](float value) {
-        this->setGrow(value);
-    });
+        attributes.registerFloatXMLAttribute("maxHeight", [](View* view, float value) {
+            view->setMaxHeight(value);
+        });
 
-    this->registerFloatXMLAttribute("shrink", [this](float value) {
-        this->setShrink(value);
-    });
+        attributes.registerPercentageXMLAttribute("maxHeight", [](View* view, float percentage) {
+            view->setMaxHeightPercentage(percentage);
+        });
 
-    // Alignment
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "alignSelf", AlignSelf, this->setAlignSelf,
-        {
-            { "auto", AlignSelf::AUTO },
-            { "flexStart", AlignSelf::FLEX_START },
-            { "center", AlignSelf::CENTER },
-            { "flexEnd", AlignSelf::FLEX_END },
-            { "stretch", AlignSelf::STRETCH },
-            { "baseline", AlignSelf::BASELINE },
-            { "spaceBetween", AlignSelf::SPACE_BETWEEN },
-            { "spaceAround", AlignSelf::SPACE_AROUND },
-        });
-
-    // Margins all
-    this->registerFloatXMLAttribute("margin", [this](float value) {
-        this->setMargins(value, value, value, value);
-    });
+        // Grow and shrink
+        attributes.registerFloatXMLAttribute("grow", [](View* view, float value) {
+            view->setGrow(value);
+        });
 
-    this->registerAutoXMLAttribute("margin", [this] {
-        this->setMargins(View::AUTO, View::AUTO, View::AUTO, View::AUTO);
-    });
+        attributes.registerFloatXMLAttribute("shrink", [](View* view, float value) {
+            view->setShrink(value);
+        });
 
-    // Margin top
-    this->registerFloatXMLAttribute("marginTop", [this](float value) {
-        this->setMarginTop(value);
-    });
+        // Alignment
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "alignSelf", AlignSelf, setAlignSelf,
+            {
+                { "auto", AlignSelf::AUTO },
+                { "flexStart", AlignSelf::FLEX_START },
+                { "center", AlignSelf::CENTER },
+                { "flexEnd", AlignSelf::FLEX_END },
+                { "stretch", AlignSelf::STRETCH },
+                { "baseline", AlignSelf::BASELINE },
+                { "spaceBetween", AlignSelf::SPACE_BETWEEN },
+                { "spaceAround", AlignSelf::SPACE_AROUND },
+            });
+
+        // Margins all
+        attributes.registerFloatXMLAttribute("margin", [](View* view, float value) {
+            view->setMargins(value, value, value, value);
+        });
 
-    this->registerAutoXMLAttribute("marginTop", [this] {
-        this->setMarginTop(View::AUTO);
-    });
+        attributes.registerAutoXMLAttribute("margin", [](View* view) {
+            view->setMargins(View::AUTO, View::AUTO, View::AUTO, View::AUTO);
+        });
 
-    // Margin right
-    this->registerFloatXMLAttribute("marginRight", [this](float value) {
-        this->setMarginRight(value);
-    });
+        // Margin top
+        attributes.registerFloatXMLAttribute("marginTop", [](View* view, float value) {
+            view->setMarginTop(value);
+        });
 
-    this->registerAutoXMLAttribute("marginRight", [this] {
-        this->setMarginRight(View::AUTO);
-    });
+        attributes.registerAutoXMLAttribute("marginTop", [](View* view) {
+            view->setMarginTop(View::AUTO);
+        });
 
-    // Margin bottom
-    this->registerFloatXMLAttribute("marginBottom", [this](float value) {
-        this->setMarginBottom(value);
-    });
+        // Margin right
+        attributes.registerFloatXMLAttribute("marginRight", [](View* view, float value) {
+            view->setMarginRight(value);
+        });
 
-    this->registerAutoXMLAttribute("marginBottom", [this] {
-        this->setMarginBottom(View::AUTO);
-    });
+        attributes.registerAutoXMLAttribute("marginRight", [](View* view) {
+            view->setMarginRight(View::AUTO);
+        });
 
-    // Margin left
-    this->registerFloatXMLAttribute("marginLeft", [this](float value) {
-        this->setMarginLeft(value);
-    });
+        // Margin bottom
+        attributes.registerFloatXMLAttribute("marginBottom", [](View* view, float value) {
+            view->setMarginBottom(value);
+        });
 
-    this->registerAutoXMLAttribute("marginLeft", [this] {
-        this->setMarginLeft(View::AUTO);
-    });
+        attributes.registerAutoXMLAttribute("marginBottom", [](View* view) {
+            view->setMarginBottom(View::AUTO);
+        });
 
-    // Line
-    this->registerColorXMLAttribute("lineColor", [this](NVGcolor color) {
-        this->setLineColor(color);
-    });
+        // Margin left
+        attributes.registerFloatXMLAttribute("marginLeft", [](View* view, float value) {
+            view->setMarginLeft(value);
+        });
 
-    this->registerFloatXMLAttribute("lineTop", [this](float value) {
-        this->setLineTop(value);
-    });
+        attributes.registerAutoXMLAttribute("marginLeft", [](View* view) {
+            view->setMarginLeft(View::AUTO);
+        });
 
-    this->registerFloatXMLAttribute("lineRight", [this](float value) {
-        this->setLineRight(value);
-    });
+        // Line
+        attributes.registerColorXMLAttribute("lineColor", [](View* view, NVGcolor color) {
+            view->setLineColor(color);
+        });
 
-    this->registerFloatXMLAttribute("lineBottom", [this](float value) {
-        this->setLineBottom(value);
-    });
+        attributes.registerFloatXMLAttribute("lineTop", [](View* view, float value) {
+            view->setLineTop(value);
+        });
 
-    this->registerFloatXMLAttribute("lineLeft", [this](float value) {
-        this->setLineLeft(value);
-    });
+        attributes.registerFloatXMLAttribute("lineRight", [](View* view, float value) {
+            view->setLineRight(value);
+        });
 
-    // Position
-    this->registerFloatXMLAttribute("positionTop", [this](float value) {
-        this->setPositionTop(value);
-    });
+        attributes.registerFloatXMLAttribute("lineBottom", [](View* view, float value) {
+            view->setLineBottom(value);
+        });
 
-    this->registerFloatXMLAttribute("positionRight", [this](float value) {
-        this->setPositionRight(value);
-    });
+        attributes.registerFloatXMLAttribute("lineLeft", [](View* view, float value) {
+            view->setLineLeft(value);
+        });
 
-    this->registerFloatXMLAttribute("positionBottom", [this](float value) {
-        this->setPositionBottom(value);
-    });
+        // Position
+        attributes.registerFloatXMLAttribute("positionTop", [](View* view, float value) {
+            view->setPositionTop(value);
+        });
 
-    this->registerFloatXMLAttribute("positionLeft", [this](float value) {
-        this->setPositionLeft(value);
-    });
+        attributes.registerFloatXMLAttribute("positionRight", [](View* view, float value) {
+            view->setPositionRight(value);
+        });
 
-    this->registerPercentageXMLAttribute("positionTop", [this](float value) {
-        this->setPositionTopPercentage(value);
-    });
+        attributes.registerFloatXMLAttribute("positionBottom", [](View* view, float value) {
+            view->setPositionBottom(value);
+        });
 
-    this->registerPercentageXMLAttribute("positionRight", [this](float value) {
-        this->setPositionRightPercentage(value);
-    });
+        attributes.registerFloatXMLAttribute("positionLeft", [](View* view, float value) {
+            view->setPositionLeft(value);
+        });
 
-    this->registerPercentageXMLAttribute("positionBottom", [this](float value) {
-        this->setPositionBottomPercentage(value);
-    });
+        attributes.registerPercentageXMLAttribute("positionTop", [](View* view, float value) {
+            view->setPositionTopPercentage(value);
+        });
 
-    this->registerPercentageXMLAttribute("positionLeft", [this](float value) {
-        this->setPositionLeftPercentage(value);
-    });
+        attributes.registerPercentageXMLAttribute("positionRight", [](View* view, float value) {
+            view->setPositionRightPercentage(value);
+        });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "positionType", PositionType, this->setPositionType,
-        {
-            { "relative", PositionType::RELATIVE },
-            { "absolute", PositionType::ABSOLUTE },
+        attributes.registerPercentageXMLAttribute("positionBottom", [](View* view, float value) {
+            view->setPositionBottomPercentage(value);
         });
 
-    // Custom focus routes
-    this->registerStringXMLAttribute("focusUp", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::UP, value);
-    });
+        attributes.registerPercentageXMLAttribute("positionLeft", [](View* view, float value) {
+            view->setPositionLeftPercentage(value);
+        });
 
-    this->registerStringXMLAttribute("focusRight", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::RIGHT, value);
-    });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "positionType", PositionType, setPositionType,
+            {
+                { "relative", PositionType::RELATIVE },
+                { "absolute", PositionType::ABSOLUTE },
+            });
 
-    this->registerStringXMLAttribute("focusDown", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::DOWN, value);
-    });
+        // Custom focus routes
+        attributes.registerStringXMLAttribute("focusUp", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::UP, value);
+        });
 
-    this->registerStringXMLAttribute("focusLeft", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::LEFT, value);
-    });
+        attributes.registerStringXMLAttribute("focusRight", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::RIGHT, value);
+        });
 
-    // Shape
-    this->registerColorXMLAttribute("backgroundColor", [this](NVGcolor value) {
-        this->setBackgroundColor(value);
-    });
+        attributes.registerStringXMLAttribute("focusDown", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::DOWN, value);
+        });
 
-    this->registerColorXMLAttribute("borderColor", [this](NVGcolor value) {
-        this->setBorderColor(value);
-    });
+        attributes.registerStringXMLAttribute("focusLeft", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::LEFT, value);
+        });
 
-    this->registerFloatXMLAttribute("borderThickness", [this](float value) {
-        this->setBorderThickness(value);
-    });
+        // Shape
+        attributes.registerColorXMLAttribute("backgroundColor", [](View* view, NVGcolor value) {
+            view->setBackgroundColor(value);
+        });
 
-    this->registerFloatXMLAttribute("cornerRadius", [this](float value) {
-        this->setCornerRadius(value);
-    });
+        attributes.registerColorXMLAttribute("borderColor", [](View* view, NVGcolor value) {
+            view->setBorderColor(value);
+        });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "shadowType", ShadowType, this->setShadowType,
-        {
-            {
-                "none",
-                ShadowType::NONE,
-            },
-            {
-                "generic",
-                ShadowType::GENERIC,
-            },
-            {
-                "custom",
-                ShadowType::CUSTOM,
-            },
+        attributes.registerFloatXMLAttribute("borderThickness", [](View* view, float value) {
+            view->setBorderThickness(value);
         });
 
-    // Misc
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "visibility", Visibility, this->setVisibility,
-        {
-            { "visible", Visibility::VISIBLE },
-            { "invisible", Visibility::INVISIBLE },
-            { "gone", Visibility::GONE },
+        attributes.registerFloatXMLAttribute("cornerRadius", [](View* view, float value) {
+            view->setCornerRadius(value);
         });
 
-    this->registerStringXMLAttribute("id", [this](std::string value) {
-        this->setId(value);
-    });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "shadowType", ShadowType, setShadowType,
+            {
+                {
+                    "none",
+                    ShadowType::NONE,
+                },
+                {
+                    "generic",
+                    ShadowType::GENERIC,
+                },
+                {
+                    "custom",
+                    ShadowType::CUSTOM,
+                },
+            });
+
+        // Misc
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "visibility", Visibility, setVisibility,
+            {
+                { "visible", Visibility::VISIBLE },
+                { "invisible", Visibility::INVISIBLE },
+                { "gone", Visibility::GONE },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "background", ViewBackground, this->setBackground,
-        {
-            { "sidebar", ViewBackground::SIDEBAR },
-            { "backdrop", ViewBackground::BACKDROP },
-            { "vertical_linear", ViewBackground::VERTICAL_LINEAR },
+        attributes.registerStringXMLAttribute("id", [](View* view, std::string value) {
+            view->setId(value);
         });
 
-    // background start and end color for vertical linear style
-    this->registerColorXMLAttribute("backgroundStartColor", [this](NVGcolor value) {
-        this->backgroundStartColor = value;
-    });
-    this->registerColorXMLAttribute("backgroundEndColor", [this](NVGcolor value) {
-        this->backgroundEndColor = value;
-    });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "background", ViewBackground, setBackground,
+            {
+                { "sidebar", ViewBackground::SIDEBAR },
+                { "backdrop", ViewBackground::BACKDROP },
+                { "vertical_linear", ViewBackground::VERTICAL_LINEAR },
+            });
+
+        // background start and end color for vertical linear style
+        attributes.registerColorXMLAttribute("backgroundStartColor", [](View* view, NVGcolor value) {
+            view->backgroundStartColor = value;
+        });
+        attributes.registerColorXMLAttribute("backgroundEndColor", [](View* view, NVGcolor value) {
+            view->backgroundEndColor = value;
+        });
 
-    // background corner radius for vertical linear style
-    this->registerFloatXMLAttribute("backgroundTopLeftRadius", [this](float value) {
-        this->backgroundRadius[0] = value;
-    });
-    this->registerFloatXMLAttribute("backgroundTopRightRadius", [this](float value) {
-        this->backgroundRadius[1] = value;
-    });
-    this->registerFloatXMLAttribute("backgroundBottomRightRadius", [this](float value) {
-        this->backgroundRadius[2] = value;
-    });
-    this->registerFloatXMLAttribute("backgroundBottomLeftRadius", [this](float value) {
-        this->backgroundRadius[3] = value;
-    });
+        // background corner radius for vertical linear style
+        attributes.registerFloatXMLAttribute("backgroundTopLeftRadius", [](View* view, float value) {
+            view->backgroundRadius[0] = value;
+        });
+        attributes.registerFloatXMLAttribute("backgroundTopRightRadius", [](View* view, float value) {
+            view->backgroundRadius[1] = value;
+        });
+        attributes.registerFloatXMLAttribute("backgroundBottomRightRadius", [](View* view, float value) {
+            view->backgroundRadius[2] = value;
+        });
+        attributes.registerFloatXMLAttribute("backgroundBottomLeftRadius", [](View* view, float value) {
+            view->backgroundRadius[3] = value;
+        });
 
-    this->registerBoolXMLAttribute("focusable", [this](bool value) {
-        this->setFocusable(value);
-    });
+        attributes.registerBoolXMLAttribute("focusable", [](View* view, bool value) {
+            view->setFocusable(value);
+        });
 
-    this->registerBoolXMLAttribute("wireframe", [this](bool value) {
-        this->setWireframeEnabled(value);
-    });
+        attributes.registerBoolXMLAttribute("wireframe", [](View* view, bool value) {
+            view->setWireframeEnabled(value);
+        });
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlightBackground", [this](bool value) {
-        this->setHideHighlightBackground(value);
-    });
+        // Highlight
+        attributes.registerBoolXMLAttribute("hideHighlightBackground", [](View* view, bool value) {
+            view->setHideHighlightBackground(value);
+        });
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlightBorder", [this](bool value) {
-        this->setHideHighlightBorder(value);
-    });
+        // Highlight
+        attributes.registerBoolXMLAttribute("hideHighlightBorder", [](View* view, bool value) {
+            view->setHideHighlightBorder(value);
+        });
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideClickAnimation", [this](bool value) {
-        this->setHideClickAnimation(value);
-    });
+        // Highlight
+        attributes.registerBoolXMLAttribute("hideClickAnimation", [](View* view, bool value) {
+            view->setHideClickAnimation(value);
+        });
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlight", [this](bool value) {
-        this->setHideHighlight(value);
-    });
+        // Highlight
+        attributes.registerBoolXMLAttribute("hideHighlight", [](View* view, bool value) {
+            view->setHideHighlight(value);
+        });
 
-    this->registerFloatXMLAttribute("highlightPadding", [this](float value) {
-        this->setHighlightPadding(value);
-    });
+        attributes.registerFloatXMLAttribute("highlightPadding", [](View* view, float value) {
+            view->setHighlightPadding(value);
+        });
 
-    this->registerFloatXMLAttribute("highlightCornerRadius", [this](float value) {
-        this->setHighlightCornerRadius(value);
-    });
+        attributes.registerFloatXMLAttribute("highlightCornerRadius", [](View* view, float value) {
+            view->setHighlightCornerRadius(value);
+        });
 
-    // Misc
-    this->registerStringXMLAttribute("title", [this](std::string value) {
-        this->getAppletFrameItem()->title = value;
-    });
+        // Misc
+        attributes.registerStringXMLAttribute("title", [](View* view, std::string value) {
+            view->getAppletFrameItem()->title = value;
+        });
 
-    this->registerFilePathXMLAttribute("icon", [this](std::string value) {
-        this->getAppletFrameItem()->setIconFromFile(value);
-    });
+        attributes.registerFilePathXMLAttribute("icon", [](View* view, std::string value) {
+            view->getAppletFrameItem()->setIconFromFile(value);
+        });
 
-    this->registerFloatXMLAttribute("detachedX", [this](float value) {
-        this->detach();
-        this->setDetachedPositionX(value);
-    });
+        attributes.registerFloatXMLAttribute("detachedX", [](View* view, float value) {
+            view->detach();
+            view->setDetachedPositionX(value);
+        });
 
-    this->registerFloatXMLAttribute("detachedY", [this](float value) {
-        this->detach();
-        this->setDetachedPositionY(value);
-    });
+        attributes.registerFloatXMLAttribute("detachedY", [](View* view, float value) {
+            view->detach();
+            view->setDetachedPositionY(value);
+        });
 
-    this->registerFloatXMLAttribute("alpha", [this](float value) {
-        this->setAlpha(value);
-    });
+        attributes.registerFloatXMLAttribute("alpha", [](View* view, float value) {
+            view->setAlpha(value);
+        });
 
-    this->registerBoolXMLAttribute("clipsToBounds", [this](float value) {
-        this->setClipsToBounds(value);
-    });
+        attributes.registerBoolXMLAttribute("clipsToBounds", [](View* view, float value) {
+            view->setClipsToBounds(value);
+        });
 
-    this->registerBoolXMLAttribute("culled", [this](float value) {
-        this->setCulled(value);
-    });
+        attributes.registerBoolXMLAttribute("culled", [](View* view, float value) {
+            view->setCulled(value);
+        });
 
-    this->registerFloatXMLAttribute("aspectRatio", [this](float value) {
-        this->setAspectRatio(value);
+        attributes.registerFloatXMLAttribute("aspectRatio", [](View* view, float value) {
+            view->setAspectRatio(value);
+        });
     });
 }
 
 void View::setTranslationY(float translationY)
 {
+    if (this->translation.y == translationY)
+        return;
+
     this->translation.y = translationY;
+    this->invalidateFrameInParent();
 }
 
 void View::setTranslationX(float translationX)
 {
+    if (this->translation.x == translationX)
+        return;
+
     this->translation.x = translationX;
+    this->invalidateFrameInParent();
 }
 
 void View::setVisibility(Visibility visibility)
@@ -2372,54 +2785,76 @@ Visibility View::getVisibility()
     return visibility;
 }
 
-void View::printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value)
+void View::printXMLAttributeErrorMessage(const std::string& tag, std::string name, std::string value)
 {
-    if (this->knownAttributes.find(name) != this->knownAttributes.end())
-        fatal("Illegal value \"" + value + "\" for \"" + std::string(element->Name()) + "\" XML attribute \"" + name + "\"");
+    if (this->isXMLAttributeValid(name))
+        fatal("Illegal value \"" + value + "\" for \"" + tag + "\" XML attribute \"" + name + "\"");
     else
-        fatal("Unknown XML attribute \"" + name + "\" for tag \"" + std::string(element->Name()) + "\" (with value \"" + value + "\")");
+        fatal("Unknown XML attribute \"" + name + "\" for tag \"" + tag + "\" (with value \"" + value + "\")");
+}
+
+XMLAttributeTable* View::getInstanceXMLAttributes()
+{
+    if (!this->instanceAttributes)
+        this->instanceAttributes = std::make_unique<XMLAttributeTable>();
+
+    return this->instanceAttributes.get();
 }
 
 void View::registerFloatXMLAttribute(std::string name, FloatAttributeHandler handler)
 {
-    this->floatAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->floatAttributes[name] = [handler](View*, float value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerPercentageXMLAttribute(std::string name, FloatAttributeHandler handler)
 {
-    this->percentageAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->percentageAttributes[name] = [handler](View*, float value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerAutoXMLAttribute(std::string name, AutoAttributeHandler handler)
 {
-    this->autoAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->autoAttributes[name] = [handler](View*) { handler(); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerStringXMLAttribute(std::string name, StringAttributeHandler handler)
 {
-    this->stringAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->stringAttributes[name] = [handler](View*, std::string value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerColorXMLAttribute(std::string name, ColorAttributeHandler handler)
 {
-    this->colorAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->colorAttributes[name] = [handler](View*, NVGcolor value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerBoolXMLAttribute(std::string name, BoolAttributeHandler handler)
 {
-    this->boolAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->boolAttributes[name] = [handler](View*, bool value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 void View::registerFilePathXMLAttribute(std::string name, FilePathAttributeHandler handler)
 {
-    this->filePathAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    XMLAttributeTable* attributes = this->getInstanceXMLAttributes();
+
+    attributes->filePathAttributes[name] = [handler](View*, std::string value) { handler(value); };
+    attributes->knownAttributes.insert(name);
 }
 
 float ntz(float value)
@@ -2502,6 +2937,7 @@ std::shared_ptr<tinyxml2::XMLDocument> View::getXMLCache(std::string_view path)
 void View::setWireframeEnabled(bool wireframe)
 {
     this->wireframeEnabled = wireframe;
+    this->setNeedsRedraw();
 }
 
 bool View::isWireframeEnabled()
@@ -0,0 +1,337 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <tinyxml2.h>
+
+#include <borealis/core/xml_layout.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// This file is also built into the brls-xml-compiler tool:
+// it must not depend on the rest of the library
+
+namespace brls
+{
+
+// Binary form, all integers are 32 bits little endian:
+//   magic "BRLX", version
+//   strings count, then for each string: size, bytes
+//   elements count, then for each element: name, attributes count, end,
+//   then for each attribute: name, value
+static const char LAYOUT_MAGIC[4] = { 'B', 'R', 'L', 'X' };
+static const uint32_t LAYOUT_VERSION = 1;
+
+static void writeInteger(std::string& data, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        data.push_back((char)((value >> (i * 8)) & 0xFF));
+}
+
+static bool readInteger(std::string_view data, size_t& position, uint32_t* value)
+{
+    if (data.size() - position < 4)
+        return false;
+
+    *value = 0;
+    for (int i = 0; i < 4; i++)
+        *value |= (uint32_t)(uint8_t)data[position + i] << (i * 8);
+
+    position += 4;
+    return true;
+}
+
+std::shared_ptr<XMLLayout> XMLLayout::compile(const tinyxml2::XMLElement* root)
+{
+    std::shared_ptr<XMLLayout> layout = std::make_shared<XMLLayout>();
+    std::unordered_map<std::string, uint32_t> indices;
+
+    layout->compileElement(root, indices);
+
+    return layout;
+}
+
+void XMLLayout::compileElement(const tinyxml2::XMLElement* element, std::unordered_map<std::string, uint32_t>& indices)
+{
+    size_t index = this->elements.size();
+
+    Element compiled;
+    compiled.name           = this->intern(element->Name(), indices);
+    compiled.firstAttribute = (uint32_t)this->attributes.size();
+    compiled.attributeCount = 0;
+    compiled.end            = 0;
+
+    for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+    {
+        this->attributes.push_back({ this->intern(attribute->Name(), indices), this->intern(attribute->Value(), indices) });
+        compiled.attributeCount++;
+    }
+
+    this->elements.push_back(compiled);
+
+    for (const tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+        this->compileElement(child, indices);
+
+    this->elements[index].end = (uint32_t)this->elements.size();
+}
+
+uint32_t XMLLayout::intern(const char* string, std::unordered_map<std::string, uint32_t>& indices)
+{
+    auto it = indices.find(string);
+    if (it != indices.end())
+        return it->second;
+
+    uint32_t index = (uint32_t)this->strings.size();
+    this->strings.emplace_back(string);
+    indices[this->strings.back()] = index;
+
+    return index;
+}
+
+std::shared_ptr<XMLLayout> XMLLayout::parse(std::string_view xml, std::string* error)
+{
+    tinyxml2::XMLDocument document;
+    tinyxml2::XMLError result = document.Parse(xml.data(), xml.size());
+
+    if (result != tinyxml2::XMLError::XML_SUCCESS)
+    {
+        *error = "error " + std::to_string(result);
+        return nullptr;
+    }
+
+    tinyxml2::XMLElement* root = document.RootElement();
+
+    if (!root)
+    {
+        *error = "no element found";
+        return nullptr;
+    }
+
+    return XMLLayout::compile(root);
+}
+
+std::shared_ptr<XMLLayout> XMLLayout::load(const std::string& path, std::string* error)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.good())
+    {
+        *error = "cannot open file";
+        return nullptr;
+    }
+
+    std::stringstream content;
+    content << file.rdbuf();
+
+    if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".bxml") == 0)
+    {
+        std::shared_ptr<XMLLayout> layout = XMLLayout::decode(content.str());
+
+        if (!layout)
+            *error = "invalid compiled layout";
+
+        return layout;
+    }
+
+    std::shared_ptr<XMLLayout> layout = XMLLayout::parse(content.str(), error);
+
+    if (!layout && *error == "no element found")
+        *error = "no root element found, is the file empty?";
+
+    return layout;
+}
+
+std::shared_ptr<XMLLayout> XMLLayout::decode(std::string_view data)
+{
+    size_t position = sizeof(LAYOUT_MAGIC);
+    uint32_t version;
+
+    if (data.size() < position || std::memcmp(data.data(), LAYOUT_MAGIC, sizeof(LAYOUT_MAGIC)) != 0)
+        return nullptr;
+
+    if (!readInteger(data, position, &version) || version != LAYOUT_VERSION)
+        return nullptr;
+
+    std::shared_ptr<XMLLayout> layout = std::make_shared<XMLLayout>();
+
+    // Strings
+    uint32_t stringsCount;
+    if (!readInteger(data, position, &stringsCount))
+        return nullptr;
+
+    layout->strings.reserve(std::min<size_t>(stringsCount, data.size()));
+    for (uint32_t i = 0; i < stringsCount; i++)
+    {
+        uint32_t size;
+        if (!readInteger(data, position, &size) || data.size() - position < size)
+            return nullptr;
+
+        layout->strings.emplace_back(data.substr(position, size));
+        position += size;
+    }
+
+    // Elements
+    uint32_t elementsCount;
+    if (!readInteger(data, position, &elementsCount) || elementsCount == 0)
+        return nullptr;
+
+    // Ends of the elements containing the current one
+    std::vector<uint32_t> parents;
+
+    layout->elements.reserve(std::min<size_t>(elementsCount, data.size()));
+    for (uint32_t i = 0; i < elementsCount; i++)
+    {
+        Element element;
+        element.firstAttribute = (uint32_t)layout->attributes.size();
+
+        if (!readInteger(data, position, &element.name) || !readInteger(data, position, &element.attributeCount) || !readInteger(data, position, &element.end))
+            return nullptr;
+
+        while (!parents.empty() && parents.back() <= i)
+            parents.pop_back();
+
+        // The subtree of an element holds at least itself and ends within its parent
+        if (element.name >= stringsCount || element.end <= i || element.end > (parents.empty() ? elementsCount : parents.back()))
+            return nullptr;
+
+        parents.push_back(element.end);
+
+        for (uint32_t j = 0; j < element.attributeCount; j++)
+        {
+            Attribute attribute;
+            if (!readInteger(data, position, &attribute.name) || !readInteger(data, position, &attribute.value))
+                return nullptr;
+
+            if (attribute.name >= stringsCount || attribute.value >= stringsCount)
+                return nullptr;
+
+            layout->attributes.push_back(attribute);
+        }
+
+        layout->elements.push_back(element);
+    }
+
+    if (layout->elements[0].end != elementsCount || position != data.size())
+        return nullptr;
+
+    return layout;
+}
+
+std::string XMLLayout::encode() const
+{
+    std::string data(LAYOUT_MAGIC, sizeof(LAYOUT_MAGIC));
+    writeInteger(data, LAYOUT_VERSION);
+
+    writeInteger(data, (uint32_t)this->strings.size());
+    for (const std::string& string : this->strings)
+    {
+        writeInteger(data, (uint32_t)string.size());
+        data += string;
+    }
+
+    writeInteger(data, (uint32_t)this->elements.size());
+    for (const Element& element : this->elements)
+    {
+        writeInteger(data, element.name);
+        writeInteger(data, element.attributeCount);
+        writeInteger(data, element.end);
+
+        for (uint32_t i = 0; i < element.attributeCount; i++)
+        {
+            writeInteger(data, this->attributes[element.firstAttribute + i].name);
+            writeInteger(data, this->attributes[element.firstAttribute + i].value);
+        }
+    }
+
+    return data;
+}
+
+std::string XMLLayout::getCompiledPath(const std::string& path)
+{
+    if (path.size() < 4 || path.compare(path.size() - 4, 4, ".xml") != 0)
+        return "";
+
+    return path.substr(0, path.size() - 4) + ".bxml";
+}
+
+const std::string* XMLLayout::findAttribute(size_t element, const std::string& name) const
+{
+    const Element& compiled = this->elements[element];
+
+    for (uint32_t i = 0; i < compiled.attributeCount; i++)
+    {
+        const Attribute& attribute = this->attributes[compiled.firstAttribute + i];
+        if (this->strings[attribute.name] == name)
+            return &this->strings[attribute.value];
+    }
+
+    return nullptr;
+}
+
+tinyxml2::XMLElement* XMLLayout::getXMLElement(size_t index)
+{
+    if (!this->document)
+    {
+        this->document = std::make_shared<tinyxml2::XMLDocument>();
+        this->documentElements.resize(this->elements.size());
+        this->documentSources.resize(this->elements.size());
+
+        // Parents of the element being created
+        std::vector<size_t> parents;
+
+        for (size_t i = 0; i < this->elements.size(); i++)
+        {
+            const Element& compiled      = this->elements[i];
+            tinyxml2::XMLElement* element = this->document->NewElement(this->strings[compiled.name].c_str());
+
+            for (uint32_t j = 0; j < compiled.attributeCount; j++)
+            {
+                const Attribute& attribute = this->attributes[compiled.firstAttribute + j];
+                element->SetAttribute(this->strings[attribute.name].c_str(), this->strings[attribute.value].c_str());
+            }
+
+            this->documentSources[i] = { this, i };
+            element->SetUserData(&this->documentSources[i]);
+
+            while (!parents.empty() && this->elements[parents.back()].end <= i)
+                parents.pop_back();
+
+            if (parents.empty())
+                this->document->InsertEndChild(element);
+            else
+                this->documentElements[parents.back()]->InsertEndChild(element);
+
+            this->documentElements[i] = element;
+            parents.push_back(i);
+        }
+    }
+
+    return this->documentElements[index];
+}
+
+XMLLayout* XMLLayout::fromXMLElement(const tinyxml2::XMLElement* element, size_t* index)
+{
+    XMLElementSource* source = (XMLElementSource*)element->GetUserData();
+
+    if (!source)
+        return nullptr;
+
+    *index = source->index;
+    return source->layout;
+}
+
+} // namespace brls
@@ -147,8 +147,7 @@ struct NVGcontext {
 	float fringeWidth;
 	float devicePxRatio;
 	struct FONScontext* fs;
-	int fontImages[NVG_MAX_FONTIMAGES];
-	int fontImageIdx;
+	int fontImages[NVG_MAX_FONTIMAGES];	// Texture of each page of the font atlas.
 	int drawCallCount;
 	int fillTriCount;
 	int strokeTriCount;
@@ -186,6 +185,7 @@ static float nvg__normalize(float *x, float* y)
 }
 
 static void nvg__flushTextTexture(NVGcontext* ctx);
+static void nvg__fontAtlasFull(void* uptr, int error, int val);
 
 static void nvg__deletePathCache(NVGpathCache* c)
 {
@@ -352,7 +352,7 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	// Create font texture
 	ctx->fontImages[0] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, fontParams.width, fontParams.height, 0, NULL);
 	if (ctx->fontImages[0] == 0) goto error;
-	ctx->fontImageIdx = 0;
+	fonsSetErrorCallback(ctx->fs, nvg__fontAtlasFull, ctx);
 
 	return ctx;
 
@@ -408,6 +408,9 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 	ctx->strokeTriCount = 0;
 	ctx->textTriCount = 0;
 	ctx->textTextureDirty = 0;
+
+	// Glyphs drawn from now on are not evicted from the font atlas until the next frame.
+	fonsNextFrame(ctx->fs);
 }
 
 void nvgCancelFrame(NVGcontext* ctx)
@@ -423,31 +426,6 @@ void nvgEndFrame(NVGcontext* ctx)
 	}
 
 	ctx->params.renderFlush(ctx->params.userPtr);
-	if (ctx->fontImageIdx != 0) {
-		int fontImage = ctx->fontImages[ctx->fontImageIdx];
-		ctx->fontImages[ctx->fontImageIdx] = 0;
-		int i, j, iw, ih;
-		// delete images that smaller than current one
-		if (fontImage == 0)
-			return;
-		nvgImageSize(ctx, fontImage, &iw, &ih);
-		for (i = j = 0; i < ctx->fontImageIdx; i++) {
-			if (ctx->fontImages[i] != 0) {
-				int nw, nh;
-				int image = ctx->fontImages[i];
-				ctx->fontImages[i] = 0;
-				nvgImageSize(ctx, image, &nw, &nh);
-				if (nw < iw || nh < ih)
-					nvgDeleteImage(ctx, image);
-				else
-					ctx->fontImages[j++] = image;
-			}
-		}
-		// make current font image to first
-		ctx->fontImages[j] = ctx->fontImages[0];
-		ctx->fontImages[0] = fontImage;
-		ctx->fontImageIdx = 0;
-	}
 }
 
 NVGcolor nvgRGB(unsigned char r, unsigned char g, unsigned char b)
@@ -2433,53 +2411,68 @@ static float nvg__getFontScale(NVGstate* state)
 static void nvg__flushTextTexture(NVGcontext* ctx)
 {
 	int dirty[4];
+	int i;
 
-	if (fonsValidateTexture(ctx->fs, dirty)) {
-		int fontImage = ctx->fontImages[ctx->fontImageIdx];
-		// Update texture
-		if (fontImage != 0) {
-			int iw, ih;
-			const unsigned char* data = fonsGetTextureData(ctx->fs, &iw, &ih);
-			int x = dirty[0];
-			int y = dirty[1];
-			int w = dirty[2] - dirty[0];
-			int h = dirty[3] - dirty[1];
-			ctx->params.renderUpdateTexture(ctx->params.userPtr, fontImage, x,y, w,h, data);
+	for (i = 0; i < fonsGetPageCount(ctx->fs); i++) {
+		if (fonsValidatePage(ctx->fs, i, dirty)) {
+			int fontImage = ctx->fontImages[i];
+			// Update texture
+			if (fontImage != 0) {
+				int iw, ih;
+				const unsigned char* data = fonsGetPageData(ctx->fs, i, &iw, &ih);
+				int x = dirty[0];
+				int y = dirty[1];
+				int w = dirty[2] - dirty[0];
+				int h = dirty[3] - dirty[1];
+				ctx->params.renderUpdateTexture(ctx->params.userPtr, fontImage, x,y, w,h, data);
+			}
 		}
 	}
 }
 
 static int nvg__allocTextAtlas(NVGcontext* ctx)
 {
-	int iw, ih;
-	nvg__flushTextTexture(ctx);
-	if (ctx->fontImageIdx >= NVG_MAX_FONTIMAGES-1)
+	int iw, ih, image, page;
+	int npages = fonsGetPageCount(ctx->fs);
+	if (npages >= NVG_MAX_FONTIMAGES)
+		return 0;
+	// calculate the new page size from the last one and create its texture.
+	nvgImageSize(ctx, ctx->fontImages[npages-1], &iw, &ih);
+	if (iw > ih)
+		ih *= 2;
+	else
+		iw *= 2;
+	if (iw > NVG_MAX_FONTIMAGE_SIZE || ih > NVG_MAX_FONTIMAGE_SIZE)
+		iw = ih = NVG_MAX_FONTIMAGE_SIZE;
+	image = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
+	if (image == 0)
+		return 0;
+	page = fonsAddPage(ctx->fs, iw, ih);
+	if (page < 0) {
+		ctx->params.renderDeleteTexture(ctx->params.userPtr, image);
 		return 0;
-	// if next fontImage already have a texture
-	if (ctx->fontImages[ctx->fontImageIdx+1] != 0)
-		nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx+1], &iw, &ih);
-	else { // calculate the new font image size and create it.
-		nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx], &iw, &ih);
-		if (iw > ih)
-			ih *= 2;
-		else
-			iw *= 2;
-		if (iw > NVG_MAX_FONTIMAGE_SIZE || ih > NVG_MAX_FONTIMAGE_SIZE)
-			iw = ih = NVG_MAX_FONTIMAGE_SIZE;
-		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
 	}
-	++ctx->fontImageIdx;
-	fonsResetAtlas(ctx->fs, iw, ih);
+	ctx->fontImages[page] = image;
 	return 1;
 }
 
-static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
+// Called by fontstash when a glyph does not fit in the pages of the atlas, before evicting the least recently used glyphs.
+static void nvg__fontAtlasFull(void* uptr, int error, int val)
+{
+	NVG_NOTUSED(val);
+	if (error == FONS_ATLAS_FULL)
+		nvg__allocTextAtlas((NVGcontext*)uptr);
+}
+
+static void nvg__renderText(NVGcontext* ctx, int page, NVGvertex* verts, int nverts)
 {
 	NVGstate* state = nvg__getState(ctx);
 	NVGpaint paint = state->fill;
 
+	if (nverts == 0) return;
+
 	// Render triangles.
-	paint.image = ctx->fontImages[ctx->fontImageIdx];
+	paint.image = ctx->fontImages[page];
 
 	// Apply global alpha
 	paint.innerColor.a *= state->alpha;
@@ -2500,13 +2493,14 @@ static int nvg__isTransformFlipped(const float *xform)
 float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char* end)
 {
 	NVGstate* state = nvg__getState(ctx);
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	NVGvertex* verts;
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio * state->fontQuality;
 	float invscale = 1.0f / scale;
 	int cverts = 0;
 	int nverts = 0;
+	int page = 0;
 	int isFlipped = nvg__isTransformFlipped(state->xform);
 
 	if (end == NULL)
@@ -2526,22 +2520,15 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	if (verts == NULL) return x;
 
 	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_REQUIRED);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
 		float c[4*2];
-		if (iter.prevGlyphIndex == -1) { // can not retrieve glyph?
-			if (nverts != 0) {
-				nvg__renderText(ctx, verts, nverts);
-				nverts = 0;
-			}
-			if (!nvg__allocTextAtlas(ctx))
-				break; // no memory :(
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-			if (iter.prevGlyphIndex == -1) // still can not find glyph?
-				break;
+		if (iter.prevGlyphIndex == -1) // glyphs of the frame fill the atlas
+			continue;
+		if (q.page >= 0 && q.page != page) { // glyphs of the same page are drawn together
+			nvg__renderText(ctx, page, verts, nverts);
+			nverts = 0;
+			page = q.page;
 		}
-		prevIter = iter;
 		if(isFlipped) {
 			float tmp;
 
@@ -2567,7 +2554,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	// Back-end bit to do this just once per frame.
 	ctx->textTextureDirty = 1;
 
-	nvg__renderText(ctx, verts, nverts);
+	nvg__renderText(ctx, page, verts, nverts);
 
 	return iter.nextx / scale;
 }
@@ -2575,13 +2562,14 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 float nvgTextWithCursor(NVGcontext* ctx, float x, float y, const char* string, const char* end, int cursor)
 {
 	NVGstate* state = nvg__getState(ctx);
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	NVGvertex* verts;
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio * state->fontQuality;
 	float invscale = 1.0f / scale;
 	int cverts = 0;
 	int nverts = 0;
+	int page = 0;
 	int isFlipped = nvg__isTransformFlipped(state->xform);
 	int charIndex = 0;
 	float cursorX = x * scale;
@@ -2603,22 +2591,15 @@ float nvgTextWithCursor(NVGcontext* ctx, float x, float y, const char* string, c
 	if (verts == NULL) return x;
 
 	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_REQUIRED);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
 		float c[4*2];
-		if (iter.prevGlyphIndex == -1) { // can not retrieve glyph?
-			if (nverts != 0) {
-				nvg__renderText(ctx, verts, nverts);
-				nverts = 0;
-			}
-			if (!nvg__allocTextAtlas(ctx))
-				break; // no memory :(
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-			if (iter.prevGlyphIndex == -1) // still can not find glyph?
-				break;
+		if (iter.prevGlyphIndex == -1) // glyphs of the frame fill the atlas
+			continue;
+		if (q.page >= 0 && q.page != page) { // glyphs of the same page are drawn together
+			nvg__renderText(ctx, page, verts, nverts);
+			nverts = 0;
+			page = q.page;
 		}
-		prevIter = iter;
 		if(isFlipped) {
 			float tmp;
 
@@ -2651,7 +2632,7 @@ float nvgTextWithCursor(NVGcontext* ctx, float x, float y, const char* string, c
 	// Back-end bit to do this just once per frame.
 	ctx->textTextureDirty = 1;
 
-	nvg__renderText(ctx, verts, nverts);
+	nvg__renderText(ctx, page, verts, nverts);
 
 	if (cursor >= 0) {
 		nvgBeginPath(ctx);
@@ -2662,6 +2643,115 @@ float nvgTextWithCursor(NVGcontext* ctx, float x, float y, const char* string, c
 	return iter.nextx / scale;
 }
 
+int nvgTextQuads(NVGcontext* ctx, float x, float y, const char* string, const char* end, NVGglyphQuad* quads, int maxQuads)
+{
+	NVGstate* state = nvg__getState(ctx);
+	FONStextIter iter;
+	FONSquad q;
+	float scale = nvg__getFontScale(state) * ctx->devicePxRatio * state->fontQuality;
+	float invscale = 1.0f / scale;
+	int nquads = 0;
+
+	if (end == NULL)
+		end = string + strlen(string);
+
+	if (state->fontId == FONS_INVALID) return 0;
+
+	fonsSetSize(ctx->fs, state->fontSize*scale);
+	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
+	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetDilate(ctx->fs, state->fontDilate);
+	fonsSetAlign(ctx->fs, state->textAlign);
+	fonsSetFont(ctx->fs, state->fontId);
+
+	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_REQUIRED);
+	while (nquads < maxQuads && fonsTextIterNext(ctx->fs, &iter, &q)) {
+		if (iter.prevGlyphIndex == -1) // glyphs of the frame fill the atlas
+			return -1;
+		quads[nquads].x0 = q.x0*invscale;
+		quads[nquads].y0 = q.y0*invscale;
+		quads[nquads].x1 = q.x1*invscale;
+		quads[nquads].y1 = q.y1*invscale;
+		quads[nquads].s0 = q.s0;
+		quads[nquads].t0 = q.t0;
+		quads[nquads].s1 = q.s1;
+		quads[nquads].t1 = q.t1;
+		quads[nquads].page = q.page;
+		quads[nquads].shelf = q.shelf;
+		nquads++;
+	}
+
+	// Back-end bit to do this just once per frame.
+	ctx->textTextureDirty = 1;
+
+	return nquads;
+}
+
+void nvgTextQuadsDraw(NVGcontext* ctx, float x, float y, const NVGglyphQuad* quads, int nquads)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGvertex* verts;
+	float scale = nvg__getFontScale(state) * ctx->devicePxRatio * state->fontQuality;
+	int nverts = 0;
+	int isFlipped = nvg__isTransformFlipped(state->xform);
+	int page = -1;
+	int i;
+
+	if (nquads <= 0) return;
+
+	// Snap the offset to the pixel grid, like the glyphs of nvgText()
+	x = floorf(x*scale + 0.5f) / scale;
+	y = floorf(y*scale + 0.5f) / scale;
+
+	verts = nvg__allocTempVerts(ctx, nquads * 6);
+	if (verts == NULL) return;
+
+	for (i = 0; i < nquads; i++) {
+		NVGglyphQuad q = quads[i];
+		float c[4*2];
+		if (q.page < 0) // empty glyph
+			continue;
+		// The glyph is drawn without being looked up, keep it in the atlas.
+		fonsTouchShelf(ctx->fs, q.page, q.shelf);
+		if (q.page != page) {
+			nvg__renderText(ctx, page, verts, nverts);
+			nverts = 0;
+			page = q.page;
+		}
+		if(isFlipped) {
+			float tmp;
+
+			tmp = q.y0; q.y0 = q.y1; q.y1 = tmp;
+			tmp = q.t0; q.t0 = q.t1; q.t1 = tmp;
+		}
+		// Transform corners.
+		nvgTransformPoint(&c[0],&c[1], state->xform, x + q.x0, y + q.y0);
+		nvgTransformPoint(&c[2],&c[3], state->xform, x + q.x1, y + q.y0);
+		nvgTransformPoint(&c[4],&c[5], state->xform, x + q.x1, y + q.y1);
+		nvgTransformPoint(&c[6],&c[7], state->xform, x + q.x0, y + q.y1);
+		// Create triangles
+		nvg__vset(&verts[nverts], c[0], c[1], q.s0, q.t0); nverts++;
+		nvg__vset(&verts[nverts], c[4], c[5], q.s1, q.t1); nverts++;
+		nvg__vset(&verts[nverts], c[2], c[3], q.s1, q.t0); nverts++;
+		nvg__vset(&verts[nverts], c[0], c[1], q.s0, q.t0); nverts++;
+		nvg__vset(&verts[nverts], c[6], c[7], q.s0, q.t1); nverts++;
+		nvg__vset(&verts[nverts], c[4], c[5], q.s1, q.t1); nverts++;
+	}
+
+	nvg__renderText(ctx, page, verts, nverts);
+}
+
+float nvgTextQuadsScale(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+	return nvg__getFontScale(state) * ctx->devicePxRatio * state->fontQuality;
+}
+
+int nvgTextAtlasGeneration(NVGcontext* ctx)
+{
+	return fonsGetAtlasGeneration(ctx->fs);
+}
+
 void nvgStencil(NVGcontext* ctx)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2761,7 +2851,7 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 	NVGstate* state = nvg__getState(ctx);
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
 	float invscale = 1.0f / scale;
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	int npos = 0;
 
@@ -2781,13 +2871,7 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 	fonsSetFont(ctx->fs, state->fontId);
 
 	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_OPTIONAL);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
-		if (iter.prevGlyphIndex < 0 && nvg__allocTextAtlas(ctx)) { // can not retrieve glyph?
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-		}
-		prevIter = iter;
 		positions[npos].str = iter.str;
 		positions[npos].x = iter.x * invscale;
 		positions[npos].minx = nvg__minf(iter.x, q.x0) * invscale;
@@ -2813,7 +2897,7 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 	NVGstate* state = nvg__getState(ctx);
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
 	float invscale = 1.0f / scale;
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	int nrows = 0;
 	float rowStartX = 0;
@@ -2852,13 +2936,7 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 	breakRowWidth *= scale;
 
 	fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, FONS_GLYPH_BITMAP_OPTIONAL);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
-		if (iter.prevGlyphIndex < 0 && nvg__allocTextAtlas(ctx)) { // can not retrieve glyph?
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-		}
-		prevIter = iter;
 		switch (iter.codepoint) {
 			case 9:			// \t
 			case 11:		// \v
@@ -182,7 +182,7 @@ int darwin_get_powerstate()
     CFRelease(blob);
     return capacity;
 }
-#elif __SDL2__
+#elif defined(__SDL2__) || defined(__HEADLESS__)
 #elif defined(__linux__)
 // Thanks to: https://github.com/videolan/vlc/blob/master/modules/misc/inhibit/dbus.c
 enum INHIBIT_TYPE
@@ -445,7 +445,7 @@ DesktopPlatform::DesktopPlatform()
     this->fontLoader = new DesktopFontLoader();
     this->imeManager = new DesktopImeManager();
 
-#if defined(__linux__) && !defined(__SDL2__)
+#if defined(__linux__) && !defined(__SDL2__) && !defined(__HEADLESS__)
     probeInhibitor(dbus_conn.get());
 #endif
 }
@@ -625,7 +625,7 @@ void DesktopPlatform::disableScreenDimming(bool disable, const std::string& reas
 
     if (disable)
     {
-#ifdef __SDL2__
+#if defined(__SDL2__) || defined(__HEADLESS__)
 #elif defined(__linux__)
         inhibitCookie = dbusInhibit(dbus_conn.get(), app, reason);
 #elif __APPLE__
@@ -641,7 +641,7 @@ void DesktopPlatform::disableScreenDimming(bool disable, const std::string& reas
     }
     else
     {
-#ifdef __SDL2__
+#if defined(__SDL2__) || defined(__HEADLESS__)
 #elif defined(__linux__)
         if (inhibitCookie != 0)
             dbusUnInhibit(dbus_conn.get(), inhibitCookie);
@@ -928,6 +928,8 @@ void DesktopPlatform::openBrowser(std::string url)
     brls::Logger::debug("open url: {}", url);
 #if __SDL2__
     SDL_OpenURL(url.c_str());
+#elif defined(__HEADLESS__)
+    // Nothing to open a browser on
 #elif __APPLE__
     std::string cmd = "open \"" + url + "\"";
     system(cmd.c_str());
@@ -0,0 +1,245 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/logger.hpp>
+#include <borealis/platforms/headless/headless_input.hpp>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace brls
+{
+
+static const std::unordered_map<std::string, ControllerButton> HEADLESS_BUTTONS = {
+    { "LT", BUTTON_LT },
+    { "LB", BUTTON_LB },
+    { "LSB", BUTTON_LSB },
+    { "UP", BUTTON_UP },
+    { "RIGHT", BUTTON_RIGHT },
+    { "DOWN", BUTTON_DOWN },
+    { "LEFT", BUTTON_LEFT },
+    { "BACK", BUTTON_BACK },
+    { "GUIDE", BUTTON_GUIDE },
+    { "START", BUTTON_START },
+    { "RSB", BUTTON_RSB },
+    { "Y", BUTTON_Y },
+    { "B", BUTTON_B },
+    { "A", BUTTON_A },
+    { "X", BUTTON_X },
+    { "RB", BUTTON_RB },
+    { "RT", BUTTON_RT },
+};
+
+HeadlessInputManager::HeadlessInputManager(const std::string& script)
+{
+    if (!script.empty())
+        this->load(script);
+}
+
+void HeadlessInputManager::load(const std::string& script)
+{
+    std::ifstream file(script);
+    if (!file)
+    {
+        Logger::error("headless: cannot open input script {}", script);
+        return;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+
+        std::istringstream stream(line);
+        size_t frame;
+        std::string action;
+
+        if (line.empty() || line[0] == '#' || line[0] == '\r')
+            continue;
+
+        if (!(stream >> frame >> action))
+        {
+            Logger::warning("headless: {}:{}: expected a frame and an action", script, lineNumber);
+            continue;
+        }
+
+        if (action == "press" || action == "down" || action == "up")
+        {
+            std::string name;
+            stream >> name;
+
+            auto button = HEADLESS_BUTTONS.find(name);
+            if (button == HEADLESS_BUTTONS.end())
+            {
+                Logger::warning("headless: {}:{}: unknown button \"{}\"", script, lineNumber, name);
+                continue;
+            }
+
+            if (action != "up")
+                this->events.push_back({ frame, ScriptAction::BUTTON_DOWN, button->second });
+            if (action == "press")
+                this->events.push_back({ frame + 1, ScriptAction::BUTTON_UP, button->second });
+            else if (action == "up")
+                this->events.push_back({ frame, ScriptAction::BUTTON_UP, button->second });
+        }
+        else if (action == "touch")
+        {
+            float x, y;
+            if (!(stream >> x >> y))
+            {
+                Logger::warning("headless: {}:{}: expected a position", script, lineNumber);
+                continue;
+            }
+
+            this->events.push_back({ frame, ScriptAction::TOUCH, BUTTON_A, Point(x, y) });
+        }
+        else if (action == "drag")
+        {
+            float x0, y0, x1, y1;
+            size_t frames;
+            if (!(stream >> x0 >> y0 >> x1 >> y1 >> frames) || frames == 0)
+            {
+                Logger::warning("headless: {}:{}: expected two positions and a number of frames", script, lineNumber);
+                continue;
+            }
+
+            for (size_t i = 0; i <= frames; i++)
+            {
+                float progress = (float)i / frames;
+                this->events.push_back({ frame + i, ScriptAction::TOUCH, BUTTON_A,
+                    Point(x0 + (x1 - x0) * progress, y0 + (y1 - y0) * progress) });
+            }
+            this->events.push_back({ frame + frames + 1, ScriptAction::RELEASE });
+        }
+        else if (action == "release")
+        {
+            this->events.push_back({ frame, ScriptAction::RELEASE });
+        }
+        else if (action == "quit")
+        {
+            this->events.push_back({ frame, ScriptAction::QUIT });
+        }
+        else
+        {
+            Logger::warning("headless: {}:{}: unknown action \"{}\"", script, lineNumber, action);
+        }
+    }
+
+    std::stable_sort(this->events.begin(), this->events.end(), [](const ScriptEvent& a, const ScriptEvent& b)
+        { return a.frame < b.frame; });
+
+    Logger::info("headless: loaded {} input events from {}", this->events.size(), script);
+}
+
+void HeadlessInputManager::setFrame(size_t frame)
+{
+    for (; this->nextEvent < this->events.size() && this->events[this->nextEvent].frame <= frame; this->nextEvent++)
+    {
+        ScriptEvent& event = this->events[this->nextEvent];
+
+        switch (event.action)
+        {
+            case ScriptAction::BUTTON_DOWN:
+                this->buttons[event.button] = true;
+                break;
+            case ScriptAction::BUTTON_UP:
+                this->buttons[event.button] = false;
+                break;
+            case ScriptAction::TOUCH:
+                this->touching = true;
+                this->touch    = event.position;
+                break;
+            case ScriptAction::RELEASE:
+                this->touching = false;
+                break;
+            case ScriptAction::QUIT:
+                this->quit = true;
+                break;
+        }
+    }
+}
+
+bool HeadlessInputManager::isQuitRequested()
+{
+    return this->quit;
+}
+
+void HeadlessInputManager::setButton(ControllerButton button, bool pressed)
+{
+    this->buttons[button] = pressed;
+}
+
+void HeadlessInputManager::setTouch(bool touching, Point position)
+{
+    this->touching = touching;
+    this->touch    = position;
+}
+
+short HeadlessInputManager::getControllersConnectedCount()
+{
+    return 1;
+}
+
+void HeadlessInputManager::updateUnifiedControllerState(ControllerState* state)
+{
+    this->updateControllerState(state, 0);
+}
+
+void HeadlessInputManager::updateControllerState(ControllerState* state, int controller)
+{
+    for (size_t i = 0; i < _BUTTON_MAX; i++)
+        state->buttons[i] = controller == 0 && this->buttons[i];
+
+    for (float& axe : state->axes)
+        axe = 0;
+
+    state->buttons[BUTTON_NAV_UP] |= state->buttons[BUTTON_UP];
+    state->buttons[BUTTON_NAV_RIGHT] |= state->buttons[BUTTON_RIGHT];
+    state->buttons[BUTTON_NAV_DOWN] |= state->buttons[BUTTON_DOWN];
+    state->buttons[BUTTON_NAV_LEFT] |= state->buttons[BUTTON_LEFT];
+}
+
+bool HeadlessInputManager::getKeyboardKeyState(BrlsKeyboardScancode /*state*/)
+{
+    return false;
+}
+
+void HeadlessInputManager::updateTouchStates(std::vector<RawTouchState>* states)
+{
+    if (!this->touching)
+        return;
+
+    RawTouchState state;
+    state.pressed  = true;
+    state.fingerId = 0;
+    state.position = this->touch;
+    states->push_back(state);
+}
+
+void HeadlessInputManager::updateMouseStates(RawMouseState* state)
+{
+    state->leftButton   = false;
+    state->middleButton = false;
+    state->rightButton  = false;
+}
+
+void HeadlessInputManager::sendRumble(unsigned short /*controller*/, unsigned short /*lowFreqMotor*/, unsigned short /*highFreqMotor*/)
+{
+}
+
+} // namespace brls
@@ -0,0 +1,187 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/application.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/platforms/headless/headless_platform.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace brls
+{
+
+HeadlessPlatform::HeadlessPlatform()
+{
+    char* env;
+
+    if ((env = getenv("BOREALIS_HEADLESS_FRAMES")))
+        HeadlessPlatform::FRAMES = strtoul(env, nullptr, 10);
+    if ((env = getenv("BOREALIS_HEADLESS_INPUT")))
+        HeadlessPlatform::INPUT_SCRIPT = env;
+    if ((env = getenv("BOREALIS_HEADLESS_SCREENSHOTS")))
+        HeadlessPlatform::SCREENSHOTS_DIRECTORY = env;
+    if ((env = getenv("BOREALIS_HEADLESS_SCREENSHOTS_INTERVAL")))
+        HeadlessPlatform::SCREENSHOTS_INTERVAL = std::max<size_t>(strtoul(env, nullptr, 10), 1);
+    if ((env = getenv("BOREALIS_HEADLESS_TIMINGS")))
+        HeadlessPlatform::TIMINGS_FILE = env;
+    if ((env = getenv("BOREALIS_HEADLESS_RASTERIZE")))
+        HeadlessPlatform::RASTERIZE = strcmp(env, "0") != 0;
+    if ((env = getenv("BOREALIS_HEADLESS_TRACE")))
+        HeadlessPlatform::TRACE_FILE = env;
+
+    if (!HeadlessPlatform::TRACE_FILE.empty())
+    {
+#ifdef BRLS_PROFILER
+        Profiler::setEnabled(true);
+#else
+        Logger::warning("headless: no trace without the profiler, build with -DBRLS_PROFILER=ON");
+#endif
+    }
+
+    // Platform impls
+    this->audioPlayer = new NullAudioPlayer();
+}
+
+void HeadlessPlatform::createWindow(std::string /*windowTitle*/, uint32_t windowWidth, uint32_t windowHeight, float /*windowXPos*/, float /*windowYPos*/)
+{
+    this->videoContext = new HeadlessVideoContext(windowWidth, windowHeight, HeadlessPlatform::RASTERIZE);
+    this->inputManager = new HeadlessInputManager(HeadlessPlatform::INPUT_SCRIPT);
+}
+
+std::string HeadlessPlatform::getName()
+{
+    return "Headless";
+}
+
+bool HeadlessPlatform::mainLoopIteration()
+{
+    // The previous iteration is over
+    if (this->frameStart > 0)
+        this->recordFrame();
+
+    this->inputManager->setFrame(this->frame);
+
+    if (this->inputManager->isQuitRequested() || (HeadlessPlatform::FRAMES > 0 && this->frame >= HeadlessPlatform::FRAMES))
+        return false;
+
+    Application::requestRedraw();
+
+    this->frameStart = getCPUTimeUsec();
+    this->frame++;
+    return true;
+}
+
+void HeadlessPlatform::recordFrame()
+{
+    size_t index = this->frame - 1;
+
+    // Drawing was skipped, if the application blocked it
+    if (this->videoContext->getFrameEndTime() < this->frameStart)
+        return;
+
+    this->timings.push_back({ index, this->videoContext->getFrameEndTime() - this->frameStart, this->videoContext->getFrameStats() });
+
+    if (!HeadlessPlatform::SCREENSHOTS_DIRECTORY.empty() && index % HeadlessPlatform::SCREENSHOTS_INTERVAL == 0)
+    {
+        std::string path = fmt::format("{}/frame_{:05d}.png", HeadlessPlatform::SCREENSHOTS_DIRECTORY, index);
+        if (!this->videoContext->writeFrame(path))
+            Logger::warning("headless: cannot write {}", path);
+    }
+}
+
+void HeadlessPlatform::report()
+{
+    if (this->timings.empty())
+        return;
+
+    std::vector<Time> durations;
+    double fills = 0, strokes = 0, triangles = 0, vertices = 0, pixels = 0;
+
+    for (FrameTiming& timing : this->timings)
+    {
+        durations.push_back(timing.duration);
+        fills += timing.stats.fills;
+        strokes += timing.stats.strokes;
+        triangles += timing.stats.triangles;
+        vertices += timing.stats.vertices;
+        pixels += timing.stats.pixels;
+    }
+
+    std::sort(durations.begin(), durations.end());
+
+    size_t count  = durations.size();
+    double total  = 0;
+    auto quantile = [&durations, count](double q)
+    { return durations[std::min((size_t)(q * count), count - 1)] / 1000.0; };
+
+    for (Time duration : durations)
+        total += duration;
+
+    Logger::info("headless: {} frames, {:.3f} ms average, {:.3f} ms median, {:.3f} ms p95, {:.3f} ms p99, {:.3f} ms max",
+        count, total / count / 1000.0, quantile(0.5), quantile(0.95), quantile(0.99), durations.back() / 1000.0);
+    Logger::info("headless: per frame {:.1f} fills, {:.1f} strokes, {:.1f} text draws, {:.0f} vertices, {:.0f} pixels",
+        fills / count, strokes / count, triangles / count, vertices / count, pixels / count);
+
+    if (HeadlessPlatform::TIMINGS_FILE.empty())
+        return;
+
+    FILE* file = fopen(HeadlessPlatform::TIMINGS_FILE.c_str(), "w");
+    if (!file)
+    {
+        Logger::error("headless: cannot write {}", HeadlessPlatform::TIMINGS_FILE);
+        return;
+    }
+
+    fmt::print(file, "frame,usec,fills,strokes,triangles,vertices,pixels\n");
+    for (FrameTiming& timing : this->timings)
+    {
+        fmt::print(file, "{},{},{},{},{},{},{}\n", timing.frame, timing.duration, timing.stats.fills, timing.stats.strokes,
+            timing.stats.triangles, timing.stats.vertices, timing.stats.pixels);
+    }
+    fclose(file);
+}
+
+AudioPlayer* HeadlessPlatform::getAudioPlayer()
+{
+    return this->audioPlayer;
+}
+
+VideoContext* HeadlessPlatform::getVideoContext()
+{
+    return this->videoContext;
+}
+
+InputManager* HeadlessPlatform::getInputManager()
+{
+    return this->inputManager;
+}
+
+HeadlessPlatform::~HeadlessPlatform()
+{
+    this->report();
+
+    if (Profiler::isEnabled() && !HeadlessPlatform::TRACE_FILE.empty())
+        Profiler::exportChromeTrace(HeadlessPlatform::TRACE_FILE);
+
+    delete this->audioPlayer;
+    delete this->inputManager;
+    delete this->videoContext;
+}
+
+} // namespace brls
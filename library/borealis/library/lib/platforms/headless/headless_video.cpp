@@ -0,0 +1,120 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/logger.hpp>
+#include <borealis/platforms/headless/headless_video.hpp>
+
+#define NANOVG_SW_IMPLEMENTATION
+#include <nanovg_sw.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+namespace brls
+{
+
+HeadlessVideoContext::HeadlessVideoContext(uint32_t windowWidth, uint32_t windowHeight, bool rasterize)
+    : width(windowWidth)
+    , height(windowHeight)
+{
+    this->nvgContext = nvgCreateSW(0);
+    if (!this->nvgContext)
+    {
+        brls::fatal("headless: unable to init nanovg");
+    }
+
+    if (rasterize)
+    {
+        this->framebuffer.resize((size_t)windowWidth * windowHeight * 4);
+        nvgswSetFramebuffer(this->nvgContext, this->framebuffer.data(), windowWidth, windowHeight, windowWidth * 4);
+    }
+
+    Logger::info("headless: {}x{} framebuffer, {}", windowWidth, windowHeight, rasterize ? "rasterized" : "draw calls only");
+
+    // There is no window: the framebuffer has the size of the window, without any scaling
+    Application::setWindowSize(windowWidth, windowHeight);
+    Application::setWindowPosition(0, 0);
+
+    if (!VideoContext::FULLSCREEN)
+    {
+        VideoContext::sizeW = windowWidth;
+        VideoContext::sizeH = windowHeight;
+        VideoContext::posX  = 0;
+        VideoContext::posY  = 0;
+    }
+}
+
+void HeadlessVideoContext::beginFrame()
+{
+}
+
+void HeadlessVideoContext::endFrame()
+{
+    this->frameEndTime = getCPUTimeUsec();
+    nvgswGetStats(this->nvgContext, &this->frameStats);
+}
+
+void HeadlessVideoContext::setSwapInterval(int interval)
+{
+    // Frames are not paced, they are drawn as fast as possible
+    VideoContext::swapInterval = interval;
+}
+
+void HeadlessVideoContext::clear(NVGcolor color)
+{
+    nvgswClear(this->nvgContext, color);
+}
+
+void HeadlessVideoContext::resetState()
+{
+}
+
+double HeadlessVideoContext::getScaleFactor()
+{
+    return 1.0;
+}
+
+Time HeadlessVideoContext::getFrameEndTime()
+{
+    return this->frameEndTime;
+}
+
+NVGswStats HeadlessVideoContext::getFrameStats()
+{
+    return this->frameStats;
+}
+
+bool HeadlessVideoContext::writeFrame(const std::string& path)
+{
+    if (this->framebuffer.empty())
+        return false;
+
+    return stbi_write_png(path.c_str(), this->width, this->height, 4, this->framebuffer.data(), this->width * 4) != 0;
+}
+
+HeadlessVideoContext::~HeadlessVideoContext()
+{
+    if (this->nvgContext)
+        nvgDeleteSW(this->nvgContext);
+}
+
+NVGcontext* HeadlessVideoContext::getNVGContext()
+{
+    return this->nvgContext;
+}
+
+} // namespace brls
@@ -99,22 +99,24 @@ AppletFrame::AppletFrame()
 
     this->forwardXMLAttribute("iconInterpolation", this->icon, "interpolation");
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "style", HeaderStyle, this->setHeaderStyle,
-        {
-            { "regular", HeaderStyle::REGULAR },
-            { "popup", HeaderStyle::POPUP },
-        });
-
-    this->registerBoolXMLAttribute("headerHidden", [this](bool value)
-        { this->setHeaderVisibility(value ? Visibility::GONE : Visibility::VISIBLE); });
-
-    this->registerBoolXMLAttribute("footerHidden", [this](bool value)
-        {
-        if(HIDE_BOTTOM_BAR)
-            this->setFooterVisibility(Visibility::GONE);
-        else
-            this->setFooterVisibility(value ? Visibility::GONE : Visibility::VISIBLE); });
+    this->registerXMLAttributes<AppletFrame>([](XMLAttributes<AppletFrame>& attributes) {
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "style", HeaderStyle, setHeaderStyle,
+            {
+                { "regular", HeaderStyle::REGULAR },
+                { "popup", HeaderStyle::POPUP },
+            });
+
+        attributes.registerBoolXMLAttribute("headerHidden", [](AppletFrame* view, bool value)
+            { view->setHeaderVisibility(value ? Visibility::GONE : Visibility::VISIBLE); });
+
+        attributes.registerBoolXMLAttribute("footerHidden", [](AppletFrame* view, bool value)
+            {
+            if(HIDE_BOTTOM_BAR)
+                view->setFooterVisibility(Visibility::GONE);
+            else
+                view->setFooterVisibility(value ? Visibility::GONE : Visibility::VISIBLE); });
+    });
 
     this->registerAction(
         "hints/back"_i18n, BUTTON_B, [this](View* view)
@@ -62,26 +62,28 @@ Button::Button()
     this->forwardXMLAttribute("autoAnimate", this->label);
     this->forwardXMLAttribute("textHorizontalAlign", this->label, "horizontalAlign");
 
-    this->registerColorXMLAttribute("textColor", [this](NVGcolor color) {
-        this->setTextColor(color);
-    });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "style", const ButtonStyle*, this->setStyle,
-        {
-            { "default", &BUTTONSTYLE_DEFAULT },
-            { "primary", &BUTTONSTYLE_PRIMARY },
-            { "highlight", &BUTTONSTYLE_HIGHLIGHT },
-            { "bordered", &BUTTONSTYLE_BORDERED },
-            { "borderless", &BUTTONSTYLE_BORDERLESS },
+    this->registerXMLAttributes<Button>([](XMLAttributes<Button>& attributes) {
+        attributes.registerColorXMLAttribute("textColor", [](Button* view, NVGcolor color) {
+            view->setTextColor(color);
         });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "state", ButtonState, this->setState,
-        {
-            { "enabled", ButtonState::ENABLED },
-            { "disabled", ButtonState::DISABLED },
-        });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "style", const ButtonStyle*, setStyle,
+            {
+                { "default", &BUTTONSTYLE_DEFAULT },
+                { "primary", &BUTTONSTYLE_PRIMARY },
+                { "highlight", &BUTTONSTYLE_HIGHLIGHT },
+                { "bordered", &BUTTONSTYLE_BORDERED },
+                { "borderless", &BUTTONSTYLE_BORDERLESS },
+            });
+
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "state", ButtonState, setState,
+            {
+                { "enabled", ButtonState::ENABLED },
+                { "disabled", ButtonState::DISABLED },
+            });
+    });
 
     this->applyStyle();
 
@@ -54,8 +54,10 @@ DetailCell::DetailCell()
 {
     this->inflateFromXMLString(detailCellXML);
 
-    this->registerStringXMLAttribute("title", [this](std::string value)
-        { this->title->setText(value); });
+    this->registerXMLAttributes<DetailCell>([](XMLAttributes<DetailCell>& attributes) {
+        attributes.registerStringXMLAttribute("title", [](DetailCell* view, std::string value)
+            { view->title->setText(value); });
+    });
 }
 
 void DetailCell::setText(std::string title)
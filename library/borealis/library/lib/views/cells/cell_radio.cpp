@@ -100,8 +100,10 @@ RadioCell::RadioCell()
 {
     this->inflateFromXMLString(radioCellXML);
 
-    this->registerStringXMLAttribute("title", [this](std::string value){
-        this->title->setText(value);
+    this->registerXMLAttributes<RadioCell>([](XMLAttributes<RadioCell>& attributes) {
+        attributes.registerStringXMLAttribute("title", [](RadioCell* view, std::string value){
+            view->title->setText(value);
+        });
     });
 }
 
@@ -16,7 +16,9 @@
 
 #include <yoga/YGNode.h>
 
+#include <algorithm>
 #include <borealis/core/application.hpp>
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/views/debug_layer.hpp>
 #include <borealis/views/label.hpp>
@@ -102,5 +104,87 @@ DebugLayer::DebugLayer()
             if (contentView->getChildren().size() > brls::Application::contentHeight / 10 - 1)
                 contentView->removeView(contentView->getChildren()[contentView->getChildren().size() - 1]); }); });
 }
+void DebugLayer::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+{
+    Box::draw(vg, x, y, width, height, style, ctx);
+
+    if (Profiler::isEnabled() && Profiler::getFrameCount() > 0)
+        this->drawProfiler(vg, x + 5, y + 5, width / 2 - 10);
+}
+
+void DebugLayer::drawProfiler(NVGcontext* vg, float x, float y, float width)
+{
+    // Frames above the budget of 60 FPS are drawn in red, the graph goes up to two budgets
+    const Time budget         = 1000000 / 60;
+    const float graphHeight   = 60;
+    const float lineHeight    = 10;
+    const ProfileFrame& frame = Profiler::getFrame(0);
+
+    size_t count     = Profiler::getFrameCount();
+    size_t lineCount = 1 + frame.zoneCount + (frame.viewCount > 0 ? frame.viewCount + 1 : 0);
+    float height     = graphHeight + 10 + lineCount * lineHeight;
+
+    nvgBeginPath(vg);
+    nvgFillColor(vg, RGBA(0, 0, 0, 160));
+    nvgRect(vg, x, y, width, height);
+    nvgFill(vg);
+
+    x += 5;
+    y += 5;
+    width -= 10;
+
+    // Frame time graph, the last frame on the right
+    float barWidth = width / Profiler::FRAMES;
+    for (size_t age = 0; age < count; age++)
+    {
+        const ProfileFrame& bar = Profiler::getFrame(age);
+        float barHeight         = std::min(graphHeight, graphHeight * bar.duration / (2 * budget));
+
+        nvgBeginPath(vg);
+        nvgFillColor(vg, bar.duration > budget ? RGBA(208, 77, 69, 255) : RGBA(99, 168, 55, 255));
+        nvgRect(vg, x + width - (age + 1) * barWidth, y + graphHeight - barHeight, std::max(barWidth - 1, 1.0f), barHeight);
+        nvgFill(vg);
+    }
+
+    nvgBeginPath(vg);
+    nvgStrokeColor(vg, RGBA(200, 200, 200, 200));
+    nvgStrokeWidth(vg, 1);
+    nvgMoveTo(vg, x, y + graphHeight / 2);
+    nvgLineTo(vg, x + width, y + graphHeight / 2);
+    nvgStroke(vg);
+
+    y += graphHeight + 5;
+
+    // Zones and views of the last frame
+    nvgFontFaceId(vg, Application::getDefaultFont());
+    nvgFontSize(vg, 8);
+    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    nvgFillColor(vg, RGBA(200, 200, 200, 255));
+
+    auto line = [&](float indent, const std::string& name, Time duration)
+    {
+        nvgText(vg, x + indent, y, name.c_str(), nullptr);
+        if (duration >= 0)
+        {
+            std::string time = fmt::format("{:.2f} ms", duration / 1000.0f);
+            nvgTextAlign(vg, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP);
+            nvgText(vg, x + width, y, time.c_str(), nullptr);
+            nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+        }
+        y += lineHeight;
+    };
+
+    line(0, fmt::format("frame {}", frame.index), frame.duration);
+
+    for (size_t i = 0; i < frame.zoneCount; i++)
+        line(10 + frame.zones[i].depth * 10, frame.zones[i].name, frame.zones[i].duration);
+
+    if (frame.viewCount > 0)
+    {
+        line(0, "views (self time)", -1);
+        for (size_t i = 0; i < frame.viewCount; i++)
+            line(10, Profiler::getViewName(frame.views[i]), frame.views[i].self);
+    }
+}
 
 } // namespace brls
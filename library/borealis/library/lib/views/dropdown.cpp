@@ -122,6 +122,7 @@ Dropdown::Dropdown(std::string title, std::vector<std::string> values, ValueSele
 
     Style style = Application::getStyle();
 
+    header->layoutIfNeeded();
     float height = numberOfRows(recycler, 0) * style["brls/dropdown/listItemHeight"]
         + header->getHeight()
         + style["brls/dropdown/listPadding"] // top
@@ -60,12 +60,14 @@ Header::Header()
 {
     this->inflateFromXMLString(headerXML);
 
-    this->registerStringXMLAttribute("title", [this](std::string value) {
-        this->setTitle(value);
-    });
-
-    this->registerStringXMLAttribute("subtitle", [this](std::string value) {
-        this->setSubtitle(value);
+    this->registerXMLAttributes<Header>([](XMLAttributes<Header>& attributes) {
+        attributes.registerStringXMLAttribute("title", [](Header* view, std::string value) {
+            view->setTitle(value);
+        });
+
+        attributes.registerStringXMLAttribute("subtitle", [](Header* view, std::string value) {
+            view->setSubtitle(value);
+        });
     });
 }
 
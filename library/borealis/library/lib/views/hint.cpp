@@ -136,19 +136,21 @@ Hints::Hints()
         }
     });
 
-    this->registerBoolXMLAttribute("addBaseAction", [this](bool value)
-    {
-        this->setAddUnableAButtonAction(value);
-    });
+    this->registerXMLAttributes<Hints>([](XMLAttributes<Hints>& attributes) {
+        attributes.registerBoolXMLAttribute("addBaseAction", [](Hints* view, bool value)
+        {
+            view->setAddUnableAButtonAction(value);
+        });
 
-    this->registerBoolXMLAttribute("allowAButtonTouch", [this](bool value)
-    {
-        this->setAllowAButtonTouch(value);
-    });
+        attributes.registerBoolXMLAttribute("allowAButtonTouch", [](Hints* view, bool value)
+        {
+            view->setAllowAButtonTouch(value);
+        });
 
-    this->registerBoolXMLAttribute("forceShown", [this](bool value)
-    {
-        this->forceShown = value;
+        attributes.registerBoolXMLAttribute("forceShown", [](Hints* view, bool value)
+        {
+            view->forceShown = value;
+        });
     });
 }
 
@@ -23,6 +23,7 @@
 #include <borealis/views/image.hpp>
 
 #include "borealis/core/cache_helper.hpp"
+#include "borealis/core/image_loader.hpp"
 #include "borealis/core/thread.hpp"
 
 namespace brls
@@ -138,36 +139,41 @@ Image::Image()
     // (factor can be 0.0f or a larger value.)
     YGNodeSetNodeType(this->ygNode, YGNodeTypeDefault);
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "scalingType", ImageScalingType, this->setScalingType,
-        {
-            { "fit", ImageScalingType::FIT },
-            { "fill", ImageScalingType::FILL },
-            { "stretch", ImageScalingType::STRETCH },
-            { "center", ImageScalingType::CENTER },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "imageAlign", ImageAlignment, this->setImageAlign,
-        {
-            { "top", ImageAlignment::TOP },
-            { "right", ImageAlignment::RIGHT },
-            { "bottom", ImageAlignment::BOTTOM },
-            { "left", ImageAlignment::LEFT },
-            { "center", ImageAlignment::CENTER },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "interpolation", ImageInterpolation, this->setInterpolation,
-        {
-            { "linear", ImageInterpolation::LINEAR },
-            { "nearest", ImageInterpolation::NEAREST },
-        });
+    this->registerXMLAttributes<Image>([](XMLAttributes<Image>& attributes) {
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "scalingType", ImageScalingType, setScalingType,
+            {
+                { "fit", ImageScalingType::FIT },
+                { "fill", ImageScalingType::FILL },
+                { "stretch", ImageScalingType::STRETCH },
+                { "center", ImageScalingType::CENTER },
+            });
+
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "imageAlign", ImageAlignment, setImageAlign,
+            {
+                { "top", ImageAlignment::TOP },
+                { "right", ImageAlignment::RIGHT },
+                { "bottom", ImageAlignment::BOTTOM },
+                { "left", ImageAlignment::LEFT },
+                { "center", ImageAlignment::CENTER },
+            });
+
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "interpolation", ImageInterpolation, setInterpolation,
+            {
+                { "linear", ImageInterpolation::LINEAR },
+                { "nearest", ImageInterpolation::NEAREST },
+            });
 
-    this->registerFilePathXMLAttribute("image", [this](const std::string& value)
-        { this->setImageFromFile(value); }
+        attributes.registerBoolXMLAttribute("asyncLoading", [](Image* view, bool value)
+            { view->setAsyncLoading(value); });
 
-    );
+        attributes.registerFilePathXMLAttribute("image", [](Image* view, const std::string& value)
+            { view->setImageFromFile(value); }
+
+        );
+    });
 
     setClipsToBounds(true);
 }
@@ -192,7 +198,10 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
     {
         nvgRoundedRect(vg, coordX, coordY, this->imageWidth, this->imageHeight, getCornerRadius());
     }
-    nvgFillPaint(vg, a(this->paint));
+    NVGpaint paint = a(this->paint);
+    paint.innerColor.a *= this->textureAlpha;
+    paint.outerColor.a *= this->textureAlpha;
+    nvgFillPaint(vg, paint);
     nvgFill(vg);
 }
 
@@ -205,6 +214,7 @@ void Image::setImageAlign(ImageAlignment align)
 {
     this->align = align;
     this->invalidateImageBounds();
+    this->setNeedsRedraw();
 }
 
 void Image::invalidateImageBounds()
@@ -302,9 +312,12 @@ void Image::setImageFromRes(const std::string& path)
     this->setFreeTexture(false);
 
 #ifdef USE_LIBROMFS
+    this->cancelAsyncLoad();
     if (checkCache("@res/" + path) > 0)
         return;
     auto image = romfs::get(path);
+    if (this->asyncLoading)
+        return this->loadAsync("@res/" + path, (const unsigned char*)image.data(), image.size());
     this->setImageFromMem((unsigned char*)image.data(), (int)image.size());
     TextureCache::instance().addCache("@res/" + path, this->texture);
 #else
@@ -325,6 +338,25 @@ int Image::getImageFlags()
     return 0;
 }
 
+size_t Image::prefetchRes(const std::string& name)
+{
+#ifdef USE_LIBROMFS
+    auto image = romfs::get(name);
+    return ImageLoader::instance().prefetchMem("@res/" + name, (const unsigned char*)image.data(), image.size(), 0);
+#else
+    return prefetchFile(std::string(BRLS_RESOURCES) + name);
+#endif
+}
+
+size_t Image::prefetchFile(const std::string& path)
+{
+#ifdef USE_LIBROMFS
+    if (path.rfind("@res/", 0) == 0)
+        return prefetchRes(path.substr(5));
+#endif
+    return ImageLoader::instance().prefetchFile(path, 0);
+}
+
 void Image::setImageFromFile(const std::string& path)
 {
     // Let TextureCache to manage when to delete texture
@@ -334,9 +366,13 @@ void Image::setImageFromFile(const std::string& path)
     if (path.rfind("@res/", 0) == 0)
         return this->setImageFromRes(path.substr(5));
 #endif
+    this->cancelAsyncLoad();
     if (checkCache(path) > 0)
         return;
 
+    if (this->asyncLoading)
+        return this->loadAsync(path, nullptr, 0);
+
     // Load texture
     int tex = nvgCreateImage(Application::getNVGContext(), path.c_str(), this->getImageFlags());
     innerSetImage(tex);
@@ -347,6 +383,8 @@ void Image::setImageFromFile(const std::string& path)
 
 void Image::setImageFromMem(const unsigned char* data, int size)
 {
+    this->cancelAsyncLoad();
+
     NVGcontext* vg = Application::getNVGContext();
 
     // Load texture
@@ -362,7 +400,56 @@ void Image::setImageAsync(std::function<void(std::function<void(const std::strin
             ASYNC_RELEASE
             if(length == 0)
                 return;
-            this->setImageFromMem((unsigned char *) data.c_str(),(int) length); }); });
+            this->cancelAsyncLoad();
+            this->clear();
+            this->loadAsync("", (const unsigned char *) data.c_str(), length); }); });
+}
+
+void Image::loadAsync(const std::string& key, const unsigned char* data, size_t size)
+{
+    // Nothing is drawn until the new image is ready,
+    // the previous texture has already been released by the caller
+    this->texture = 0;
+    this->invalidate();
+
+    ImageLoaderCallback callback = [this, key](int texture)
+    {
+        this->pendingLoad = 0;
+        if (texture == 0)
+            return;
+
+        // Let TextureCache to manage when to delete cached textures
+        this->setFreeTexture(key.empty());
+        this->innerSetImage(texture);
+
+        this->textureAlpha.reset(0.0f);
+        this->textureAlpha.addStep(1.0f, Application::getStyle()["brls/animations/show"], EasingFunction::quadraticOut);
+        this->textureAlpha.start();
+    };
+
+    if (data)
+        this->pendingLoad = ImageLoader::instance().loadMem(key, data, size, this->getImageFlags(), callback);
+    else
+        this->pendingLoad = ImageLoader::instance().loadFile(key, this->getImageFlags(), callback);
+}
+
+void Image::cancelAsyncLoad()
+{
+    if (this->pendingLoad == 0)
+        return;
+
+    ImageLoader::instance().cancel(this->pendingLoad);
+    this->pendingLoad = 0;
+}
+
+void Image::setAsyncLoading(bool async)
+{
+    this->asyncLoading = async;
+}
+
+bool Image::getAsyncLoading()
+{
+    return this->asyncLoading;
 }
 
 void Image::innerSetImage(int tex)
@@ -399,6 +486,7 @@ void Image::clear()
         nvgDeleteImage(Application::getNVGContext(), this->texture);
 
     this->texture = 0;
+    this->setNeedsRedraw();
 }
 
 void Image::setScalingType(ImageScalingType scalingType)
@@ -440,6 +528,8 @@ float Image::getOriginalImageHeight()
 
 Image::~Image()
 {
+    this->cancelAsyncLoad();
+
     if (this->freeTexture && this->texture != 0)
         nvgDeleteImage(Application::getNVGContext(), this->texture);
     else
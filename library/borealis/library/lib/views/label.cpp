@@ -26,6 +26,9 @@
 namespace brls
 {
 
+// Looked up on every frame
+static const StyleKey STYLE_LABEL_SCROLLING_ANIMATION_SPACING("brls/label/scrolling_animation_spacing");
+
 #define ELLIPSIS "\u2026"
 
 static size_t strLen(const std::string& str)
@@ -48,7 +51,7 @@ static size_t strLen(const std::string& str)
     return res;
 }
 
-static void computeLabelHeight(Label* label, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode, YGSize* size, float* originalBounds)
+static void computeLabelHeight(Label* label, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode, YGSize* size, const float* originalBounds)
 {
     label->setIsWrapping(false);
 
@@ -73,7 +76,6 @@ static void computeLabelHeight(Label* label, float width, YGMeasureMode widthMod
 
 static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
 {
-    NVGcontext* vg       = Application::getNVGContext();
     auto* label          = (Label*)YGNodeGetContext(node);
     std::string fullText = label->getFullText();
 
@@ -105,20 +107,8 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
         width     = NAN;
     }
 
-    // Setup nvg state for the measurements
-    nvgFontSize(vg, label->getFontSize());
-    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-    nvgFontFaceId(vg, label->getFont());
-    nvgTextLineHeight(vg, label->getLineHeight());
-
-    // Measure the needed width for the ellipsis
-    float bounds[4];
-    nvgTextBounds(vg, 0, 0, ELLIPSIS, nullptr, bounds);
-    float ellipsisWidth = bounds[2] - bounds[0];
-    label->setEllipsisWidth(ellipsisWidth);
-
-    // Measure the needed width for the fullText
-    nvgTextBounds(vg, 0, 0, fullText.c_str(), nullptr, bounds);
+    // Measure the needed width for the fullText (and the ellipsis)
+    const float* bounds = label->getTextBounds();
     float requiredWidth = bounds[2] - bounds[0] - 0.5f;
     label->setRequiredWidth(requiredWidth);
 
@@ -149,10 +139,7 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
     // Is wrapping necessary and allowed ?
     if ((availableWidth < requiredWidth || fullText.find("\n") != std::string::npos) && !label->isSingleLine())
     {
-        float boxBounds[4];
-        nvgTextBoxBounds(vg, 0, 0, availableWidth, fullText.c_str(), nullptr, boxBounds);
-
-        float requiredHeight = boxBounds[3] - boxBounds[1];
+        float requiredHeight = label->getWrappedTextHeight(availableWidth);
 
         // Undefined height mode, always wrap
         if (heightMode == YGMeasureModeUndefined)
@@ -203,6 +190,7 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
 void Label::setCursor(int cursor) {
     this->cursor = cursor;
     this->cursor_blink = brls::getCPUTimeUsec();
+    this->setNeedsRedraw();
 }
 
 Label::Label()
@@ -228,49 +216,51 @@ Label::Label()
     YGNodeStyleSetMaxHeightPercent(this->ygNode, 100);
 
     // Register XML attributes
-    this->registerStringXMLAttribute("text", [this](std::string value)
-        { this->setText(value); });
+    this->registerXMLAttributes<Label>([](XMLAttributes<Label>& attributes) {
+        attributes.registerStringXMLAttribute("text", [](Label* view, std::string value)
+            { view->setText(value); });
 
-    this->registerFloatXMLAttribute("fontSize", [this](float value)
-        { this->setFontSize(value); });
+        attributes.registerFloatXMLAttribute("fontSize", [](Label* view, float value)
+            { view->setFontSize(value); });
 
-    this->registerFloatXMLAttribute("fontQuality", [this](float value)
-        { this->setFontQuality(value); });
+        attributes.registerFloatXMLAttribute("fontQuality", [](Label* view, float value)
+            { view->setFontQuality(value); });
 
-    this->registerColorXMLAttribute("textColor", [this](NVGcolor color)
-        { this->setTextColor(color); });
+        attributes.registerColorXMLAttribute("textColor", [](Label* view, NVGcolor color)
+            { view->setTextColor(color); });
 
-    this->registerFloatXMLAttribute("lineHeight", [this](float value)
-        { this->setLineHeight(value); });
+        attributes.registerFloatXMLAttribute("lineHeight", [](Label* view, float value)
+            { view->setLineHeight(value); });
 
-    this->registerBoolXMLAttribute("animated", [this](bool value)
-        { this->setAnimated(value); });
+        attributes.registerBoolXMLAttribute("animated", [](Label* view, bool value)
+            { view->setAnimated(value); });
 
-    this->registerBoolXMLAttribute("autoAnimate", [this](bool value)
-        { this->setAutoAnimate(value); });
+        attributes.registerBoolXMLAttribute("autoAnimate", [](Label* view, bool value)
+            { view->setAutoAnimate(value); });
 
-    this->registerBoolXMLAttribute("singleLine", [this](bool value)
-        { this->setSingleLine(value); });
+        attributes.registerBoolXMLAttribute("singleLine", [](Label* view, bool value)
+            { view->setSingleLine(value); });
 
-    this->registerFloatXMLAttribute("cursor", [this](float value)
-        { this->setCursor(value); });
+        attributes.registerFloatXMLAttribute("cursor", [](Label* view, float value)
+            { view->setCursor(value); });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "horizontalAlign", HorizontalAlign, this->setHorizontalAlign,
-        {
-            { "left", HorizontalAlign::LEFT },
-            { "center", HorizontalAlign::CENTER },
-            { "right", HorizontalAlign::RIGHT },
-        });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "horizontalAlign", HorizontalAlign, setHorizontalAlign,
+            {
+                { "left", HorizontalAlign::LEFT },
+                { "center", HorizontalAlign::CENTER },
+                { "right", HorizontalAlign::RIGHT },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "verticalAlign", VerticalAlign, this->setVerticalAlign,
-        {
-            { "baseline", VerticalAlign::BASELINE },
-            { "top", VerticalAlign::TOP },
-            { "center", VerticalAlign::CENTER },
-            { "bottom", VerticalAlign::BOTTOM },
-        });
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "verticalAlign", VerticalAlign, setVerticalAlign,
+            {
+                { "baseline", VerticalAlign::BASELINE },
+                { "top", VerticalAlign::TOP },
+                { "center", VerticalAlign::CENTER },
+                { "bottom", VerticalAlign::BOTTOM },
+            });
+    });
 }
 
 void Label::setAnimated(bool animated)
@@ -291,11 +281,22 @@ void Label::setAutoAnimate(bool autoAnimate)
 void Label::setHorizontalAlign(HorizontalAlign align)
 {
     this->horizontalAlign = align;
+
+    // The glyph positions used for truncation depend on the alignment
+    this->textCache.glyphs.clear();
+    this->textCache.truncatedWidth = -1;
+
+    this->setNeedsRedraw();
 }
 
 void Label::setVerticalAlign(VerticalAlign align)
 {
     this->verticalAlign = align;
+
+    this->textCache.glyphs.clear();
+    this->textCache.truncatedWidth = -1;
+
+    this->setNeedsRedraw();
 }
 
 void Label::onFocusGained()
@@ -333,6 +334,7 @@ void Label::onParentFocusLost(View* focusedView)
 void Label::setTextColor(NVGcolor color)
 {
     this->textColor = color;
+    this->setNeedsRedraw();
 }
 
 std::string Label::STConverter(const std::string& text)
@@ -363,12 +365,14 @@ void Label::setText(const std::string& text)
         this->fullText      = text;
         this->stringLength  = strLen(this->fullText);
     }
+    this->invalidateTextCache();
     this->invalidate();
 #else
     this->truncatedText = text;
     this->fullText      = text;
     this->stringLength  = strLen(text);
 
+    this->invalidateTextCache();
     this->invalidate();
 #endif
 }
@@ -384,6 +388,7 @@ void Label::setFontSize(float value)
 {
     this->fontSize = value;
 
+    this->invalidateTextCache();
     this->invalidate();
 }
 
@@ -391,6 +396,7 @@ void Label::setFontQuality(float value)
 {
     this->fontQuality = value;
 
+    this->invalidateTextCache();
     this->invalidate();
 }
 
@@ -398,12 +404,14 @@ void Label::setLineHeight(float value)
 {
     this->lineHeight = value;
 
+    this->invalidateTextCache();
     this->invalidate();
 }
 
 void Label::setIsWrapping(bool isWrapping)
 {
     this->isWrapping = isWrapping;
+    this->setNeedsRedraw();
 }
 
 bool Label::isSingleLine()
@@ -411,6 +419,125 @@ bool Label::isSingleLine()
     return this->singleLine;
 }
 
+void Label::invalidateTextCache()
+{
+    // Keep the allocations, the text of a label is likely to change again
+    this->textCache.measured       = false;
+    this->textCache.wrapped        = false;
+    this->textCache.truncatedWidth = -1;
+    this->textCache.run            = TextRun::NONE;
+    this->textCache.glyphs.clear();
+}
+
+void Label::setupTextStyle(NVGcontext* vg, int align)
+{
+    nvgFontSize(vg, this->fontSize);
+    nvgTextAlign(vg, align);
+    nvgFontFaceId(vg, this->font);
+    nvgTextLineHeight(vg, this->lineHeight);
+}
+
+const float* Label::getTextBounds()
+{
+    if (!this->textCache.measured)
+    {
+        NVGcontext* vg = Application::getNVGContext();
+        this->setupTextStyle(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+
+        // Measure the needed width for the ellipsis
+        float bounds[4];
+        nvgTextBounds(vg, 0, 0, ELLIPSIS, nullptr, bounds);
+        this->setEllipsisWidth(bounds[2] - bounds[0]);
+
+        nvgTextBounds(vg, 0, 0, this->fullText.c_str(), nullptr, this->textCache.bounds);
+        this->textCache.measured = true;
+    }
+
+    return this->textCache.bounds;
+}
+
+float Label::getWrappedTextHeight(float width)
+{
+    if (!this->textCache.wrapped || this->textCache.wrappedWidth != width)
+    {
+        NVGcontext* vg = Application::getNVGContext();
+        this->setupTextStyle(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+
+        float boxBounds[4];
+        nvgTextBoxBounds(vg, 0, 0, width, this->fullText.c_str(), nullptr, boxBounds);
+
+        this->textCache.wrapped       = true;
+        this->textCache.wrappedWidth  = width;
+        this->textCache.wrappedHeight = boxBounds[3] - boxBounds[1];
+    }
+
+    return this->textCache.wrappedHeight;
+}
+
+bool Label::layoutTextQuads(NVGcontext* vg, TextRun run, int align, float width)
+{
+    TextCache& cache = this->textCache;
+    float scale      = nvgTextQuadsScale(vg);
+
+    if (cache.run == run && cache.align == align && cache.runWidth == width && cache.scale == scale && cache.generation == nvgTextAtlasGeneration(vg))
+        return cache.quadCount >= 0;
+
+    const std::string& text = run == TextRun::TRUNCATED ? this->truncatedText : this->fullText;
+
+    cache.run      = run;
+    cache.align    = align;
+    cache.runWidth = width;
+    cache.scale    = scale;
+    cache.quads.resize(text.size());
+
+    // Glyphs laid out during this frame stay in the atlas until the next one, even
+    // if making room for the following ones evicts others and bumps the generation
+    cache.quadCount = 0;
+
+    if (run == TextRun::WRAPPED)
+    {
+        NVGtextRow rows[8];
+        int nrows;
+        float lineh;
+        float y            = 0;
+        const char* string = text.c_str();
+        const char* end    = string + text.size();
+
+        nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+        nvgTextMetrics(vg, nullptr, nullptr, &lineh);
+
+        while (cache.quadCount >= 0 && (nrows = nvgTextBreakLines(vg, string, end, width, rows, 8)))
+        {
+            for (int i = 0; i < nrows && cache.quadCount >= 0; i++)
+            {
+                NVGtextRow* row = &rows[i];
+                float x         = 0;
+
+                if (align & NVG_ALIGN_CENTER)
+                    x = width * 0.5f - row->width * 0.5f;
+                else if (align & NVG_ALIGN_RIGHT)
+                    x = width - row->width;
+
+                int count = nvgTextQuads(vg, x, y, row->start, row->end, cache.quads.data() + cache.quadCount, (int)cache.quads.size() - cache.quadCount);
+                cache.quadCount = count < 0 ? -1 : cache.quadCount + count;
+
+                y += lineh * this->lineHeight;
+            }
+            string = rows[nrows - 1].next;
+        }
+
+        nvgTextAlign(vg, align);
+    }
+    else
+    {
+        cache.quadCount = nvgTextQuads(vg, 0, 0, text.c_str(), text.c_str() + text.size(), cache.quads.data(), (int)cache.quads.size());
+    }
+
+    cache.generation = nvgTextAtlasGeneration(vg);
+
+    return cache.quadCount >= 0;
+}
+
 enum NVGalign Label::getNVGVerticalAlign()
 {
     switch (this->verticalAlign)
@@ -459,6 +586,9 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
 
     // Edit cursor
     if (this->cursor >= (int)CursorPosition::END) {
+        // keep drawing frames for the cursor to blink
+        this->setNeedsRedraw();
+
         // blink
         auto blink = ((brls::getCPUTimeUsec() - cursor_blink) >> 10) % 1000 ;
         if (blink < 500)
@@ -473,12 +603,23 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         nvgIntersectScissor(vg, x, y, width, scissorHeight < height ? height : scissorHeight);
 
         float baseX   = x - this->scrollingAnimation;
-        float spacing = style["brls/label/scrolling_animation_spacing"];
+        float spacing = style[STYLE_LABEL_SCROLLING_ANIMATION_SPACING];
+
+        if (this->layoutTextQuads(vg, TextRun::FULL, horizAlign | vertAlign, 0))
+        {
+            const TextCache& cache = this->textCache;
+            nvgTextQuadsDraw(vg, baseX, y + height / 2.0f, cache.quads.data(), cache.quadCount);
 
-        nvgText(vg, baseX, y + height / 2.0f, this->fullText.c_str(), nullptr);
+            if (this->scrollingAnimation > 0)
+                nvgTextQuadsDraw(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, cache.quads.data(), cache.quadCount);
+        }
+        else
+        {
+            nvgText(vg, baseX, y + height / 2.0f, this->fullText.c_str(), nullptr);
 
-        if (this->scrollingAnimation > 0)
-            nvgText(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, this->fullText.c_str(), nullptr);
+            if (this->scrollingAnimation > 0)
+                nvgText(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, this->fullText.c_str(), nullptr);
+        }
 
         nvgRestore(vg);
     }
@@ -486,7 +627,12 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
     else if (this->isWrapping)
     {
         nvgTextAlign(vg, horizAlign | NVG_ALIGN_TOP);
-        nvgTextBoxWithCursor(vg, x, y, width, this->fullText.c_str(), nullptr, cursor_position);
+
+        // The edit cursor is not cached
+        if (this->cursor < (int)CursorPosition::END && this->layoutTextQuads(vg, TextRun::WRAPPED, horizAlign | NVG_ALIGN_TOP, width))
+            nvgTextQuadsDraw(vg, x, y, this->textCache.quads.data(), this->textCache.quadCount);
+        else
+            nvgTextBoxWithCursor(vg, x, y, width, this->fullText.c_str(), nullptr, cursor_position);
     }
     // Truncated text
     else
@@ -504,7 +650,10 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         else if (vertAlign == NVG_ALIGN_BOTTOM)
             textY += height;
 
-        nvgTextWithCursor(vg, textX, textY, this->truncatedText.c_str(), nullptr, cursor_position);
+        if (this->cursor < (int)CursorPosition::END && this->layoutTextQuads(vg, TextRun::TRUNCATED, horizAlign | vertAlign, 0))
+            nvgTextQuadsDraw(vg, textX, textY, this->textCache.quads.data(), this->textCache.quadCount);
+        else
+            nvgTextWithCursor(vg, textX, textY, this->truncatedText.c_str(), nullptr, cursor_position);
     }
 }
 
@@ -528,7 +677,7 @@ void Label::onScrollTimerFinished()
     Style style = Application::getStyle();
 
     // Step 2: actual scrolling animation
-    float target   = this->requiredWidth + style["brls/label/scrolling_animation_spacing"];
+    float target   = this->requiredWidth + style[STYLE_LABEL_SCROLLING_ANIMATION_SPACING];
     float duration = target / style["brls/animations/label_scrolling_speed"];
 
     this->scrollingAnimation.reset();
@@ -595,34 +744,46 @@ void Label::onLayout()
     {
         // Compute the position of the ellipsis (in chars), should the string be truncated
         // Cannot do it in the measure function because the margins are not applied yet there
-        auto vg = Application::getNVGContext();
-        nvgFontSize(vg, this->fontSize);
-        nvgTextAlign(vg, this->getNVGHorizontalAlign() | this->getNVGVerticalAlign());
-        nvgFontFaceId(vg, this->font);
-        nvgTextLineHeight(vg, this->lineHeight);
-
-        std::vector<NVGglyphPosition> positions;
-        positions.resize(stringLength);
-        nvgTextGlyphPositions(vg, 0, 0, fullText.c_str(), nullptr, positions.data(), stringLength);
-
-        const char* start   = fullText.c_str();
-        this->truncatedText = fullText;
-        for (auto& i : positions)
+        // The glyph positions are kept to truncate the text again at another width
+        if (width != this->textCache.truncatedWidth)
         {
-            if (i.str == start)
-                continue;
-            if (i.str >= start + fullText.size())
-                break;
-            if (i.maxx + this->ellipsisWidth > width)
+            std::vector<NVGglyphPosition>& positions = this->textCache.glyphs;
+
+            if (positions.empty())
+            {
+                auto vg = Application::getNVGContext();
+                this->setupTextStyle(vg, this->getNVGHorizontalAlign() | this->getNVGVerticalAlign());
+
+                positions.resize(stringLength);
+                positions.resize(nvgTextGlyphPositions(vg, 0, 0, fullText.c_str(), nullptr, positions.data(), stringLength));
+            }
+
+            const char* start   = fullText.c_str();
+            this->truncatedText = fullText;
+            for (auto& i : positions)
             {
-                this->truncatedText = fullText.substr(0, i.str - start) + ELLIPSIS;
-                break;
+                if (i.str == start)
+                    continue;
+                if (i.str >= start + fullText.size())
+                    break;
+                if (i.maxx + this->ellipsisWidth > width)
+                {
+                    this->truncatedText = fullText.substr(0, i.str - start) + ELLIPSIS;
+                    break;
+                }
             }
+
+            this->textCache.truncatedWidth = width;
+            if (this->textCache.run == TextRun::TRUNCATED)
+                this->textCache.run = TextRun::NONE;
         }
     }
-    else
+    else if (this->truncatedText != this->fullText)
     {
-        this->truncatedText = this->fullText;
+        this->truncatedText            = this->fullText;
+        this->textCache.truncatedWidth = -1;
+        if (this->textCache.run == TextRun::TRUNCATED)
+            this->textCache.run = TextRun::NONE;
     }
 
     this->resetScrollingAnimation(); // either stops it or restarts it with the new text
@@ -21,14 +21,23 @@
 namespace brls
 {
 
+// Keys looked up on every frame
+static const ThemeKey THEME_SPINNER_BAR_COLOR("brls/spinner/bar_color");
+static const StyleKey STYLE_SPINNER_CENTER_GAP_MULTIPLIER("brls/spinner/center_gap_multiplier");
+static const StyleKey STYLE_SPINNER_BAR_WIDTH_MULTIPLIER("brls/spinner/bar_width_multiplier");
+static const StyleKey STYLE_SPINNER_CENTER_GAP_MULTIPLIER_LARGE("brls/spinner/center_gap_multiplier_large");
+static const StyleKey STYLE_SPINNER_BAR_WIDTH_MULTIPLIER_LARGE("brls/spinner/bar_width_multiplier_large");
+
 ProgressSpinner::ProgressSpinner(ProgressSpinnerSize size)
     : size(size)
 {
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE("size", ProgressSpinnerSize, this->setSize,
-        {
-            { "normal", ProgressSpinnerSize::NORMAL },
-            { "large", ProgressSpinnerSize::LARGE },
-        });
+    this->registerXMLAttributes<ProgressSpinner>([](XMLAttributes<ProgressSpinner>& attributes) {
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE("size", ProgressSpinnerSize, setSize,
+            {
+                { "normal", ProgressSpinnerSize::NORMAL },
+                { "large", ProgressSpinnerSize::LARGE },
+            });
+    });
 }
 
 void ProgressSpinner::restartAnimation()
@@ -61,7 +70,7 @@ void ProgressSpinner::animate(bool animate)
 void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
     Theme theme       = Application::getTheme();
-    NVGcolor barColor = a(theme["brls/spinner/bar_color"]);
+    NVGcolor barColor = a(theme[THEME_SPINNER_BAR_COLOR]);
 
     // Each bar of the spinner
     switch (size)
@@ -69,15 +78,15 @@ void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float
         case NORMAL:
             for (int i = 0 + animationValue; i < 8 + animationValue; i++)
             {
-                barColor.a = fmax((i - animationValue) / 8.0f, theme["brls/spinner/bar_color"].a) * this->getAlpha();
+                barColor.a = fmax((i - animationValue) / 8.0f, theme[THEME_SPINNER_BAR_COLOR].a) * this->getAlpha();
                 nvgSave(vg);
                 nvgTranslate(vg, x + width / 2, y + height / 2);
                 nvgRotate(vg, nvgDegToRad(i * 45)); // Internal angle of octagon
                 nvgBeginPath(vg);
-                nvgMoveTo(vg, height * style["brls/spinner/center_gap_multiplier"], 0);
-                nvgLineTo(vg, height / 2 - height * style["brls/spinner/center_gap_multiplier"], 0);
+                nvgMoveTo(vg, height * style[STYLE_SPINNER_CENTER_GAP_MULTIPLIER], 0);
+                nvgLineTo(vg, height / 2 - height * style[STYLE_SPINNER_CENTER_GAP_MULTIPLIER], 0);
                 nvgStrokeColor(vg, barColor);
-                nvgStrokeWidth(vg, height * style["brls/spinner/bar_width_multiplier"]);
+                nvgStrokeWidth(vg, height * style[STYLE_SPINNER_BAR_WIDTH_MULTIPLIER]);
                 nvgLineCap(vg, NVG_SQUARE);
                 nvgStroke(vg);
                 nvgRestore(vg);
@@ -86,15 +95,15 @@ void ProgressSpinner::draw(NVGcontext* vg, float x, float y, float width, float
         case LARGE:
             for (int i = 0 + animationValue; i < 12 + animationValue; i++)
             {
-                barColor.a = fmax((i - animationValue) / 12.0f, theme["brls/spinner/bar_color"].a) * this->getAlpha();
+                barColor.a = fmax((i - animationValue) / 12.0f, theme[THEME_SPINNER_BAR_COLOR].a) * this->getAlpha();
                 nvgSave(vg);
                 nvgTranslate(vg, x + width / 2, y + height / 2);
                 nvgRotate(vg, nvgDegToRad(i * 30)); // Internal angle of octagon
                 nvgBeginPath(vg);
-                nvgMoveTo(vg, height * style["brls/spinner/center_gap_multiplier_large"], 0);
-                nvgLineTo(vg, height / 2 - height * style["brls/spinner/center_gap_multiplier_large"], 0);
+                nvgMoveTo(vg, height * style[STYLE_SPINNER_CENTER_GAP_MULTIPLIER_LARGE], 0);
+                nvgLineTo(vg, height / 2 - height * style[STYLE_SPINNER_CENTER_GAP_MULTIPLIER_LARGE], 0);
                 nvgStrokeColor(vg, barColor);
-                nvgStrokeWidth(vg, height * style["brls/spinner/bar_width_multiplier_large"]);
+                nvgStrokeWidth(vg, height * style[STYLE_SPINNER_BAR_WIDTH_MULTIPLIER_LARGE]);
                 nvgLineCap(vg, NVG_SQUARE);
                 nvgStroke(vg);
                 nvgRestore(vg);
@@ -26,8 +26,10 @@ Rectangle::Rectangle(NVGcolor color)
     this->setColor(color);
 
     // Register XML attributes
-    this->registerColorXMLAttribute("color", [this](NVGcolor color) {
-        this->setColor(color);
+    this->registerXMLAttributes<Rectangle>([](XMLAttributes<Rectangle>& attributes) {
+        attributes.registerColorXMLAttribute("color", [](Rectangle* view, NVGcolor color) {
+            view->setColor(color);
+        });
     });
 }
 
@@ -59,6 +61,7 @@ void Rectangle::draw(NVGcontext* vg, float x, float y, float width, float height
 void Rectangle::setColor(NVGcolor color)
 {
     this->color = color;
+    this->setNeedsRedraw();
 }
 
 // void Rectangle::layout(NVGcontext* vg, Style* style, FontStash* stash)
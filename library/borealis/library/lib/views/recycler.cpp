@@ -16,6 +16,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/touch/tap_gesture.hpp>
+#include <algorithm>
 #include <borealis/views/recycler.hpp>
 
 namespace brls
@@ -78,6 +79,16 @@ void RecyclerCell::onFocusLost()
     this->setLineColor(Application::getTheme()["brls/sidebar/separator"]);
 }
 
+View* RecyclerCell::getNextFocus(FocusDirection direction, View* currentView)
+{
+    // The cell has no index in the content box (see RecyclerFrame::createCellAt()),
+    // leaving the cell itself is up to the content box
+    if (currentView == this)
+        return getParent()->getNextFocus(direction, this);
+
+    return Box::getNextFocus(direction, currentView);
+}
+
 RecyclerHeader::RecyclerHeader()
 {
     this->header = new Header();
@@ -118,7 +129,7 @@ float RecyclerDataSource::heightForHeader(RecyclerFrame* recycler, int section)
 }
 
 RecyclerContentBox::RecyclerContentBox(RecyclerFrame* recycler)
-    : Box(Axis::COLUMN)
+    : Box(recycler->getAxis())
     , recycler(recycler)
 {
 }
@@ -130,10 +141,13 @@ View* RecyclerContentBox::getNextFocus(FocusDirection direction, View* currentVi
 
 View* RecyclerFrame::getNextCellFocus(FocusDirection direction, View* currentView)
 {
-    void* parentUserData = currentView->getParentUserData();
+    size_t columns = this->getColumns();
+    bool forward   = direction == (isVertical() ? FocusDirection::DOWN : FocusDirection::RIGHT);
+    bool backward  = direction == (isVertical() ? FocusDirection::UP : FocusDirection::LEFT);
+    bool across    = !forward && !backward;
 
     // Return nullptr immediately if focus direction mismatches the box axis (clang-format refuses to split it in multiple lines...)
-    if ((this->contentBox->getAxis() == Axis::ROW && direction != FocusDirection::LEFT && direction != FocusDirection::RIGHT) || (this->contentBox->getAxis() == Axis::COLUMN && direction != FocusDirection::UP && direction != FocusDirection::DOWN))
+    if (columns == 1 && across)
     {
         View* next = getParentNavigationDecision(this, nullptr, direction);
         if (!next && hasParent())
@@ -141,28 +155,41 @@ View* RecyclerFrame::getNextCellFocus(FocusDirection direction, View* currentVie
         return next;
     }
 
-    // Traverse the children
-    size_t offset = 1; // which way we are going in the children list
+    size_t index       = ((RecyclerCell*)currentView)->recyclerIndex;
+    size_t line        = this->cacheLineData[index];
+    View* currentFocus = nullptr;
 
-    if ((this->contentBox->getAxis() == Axis::ROW && direction == FocusDirection::LEFT) || (this->contentBox->getAxis() == Axis::COLUMN && direction == FocusDirection::UP))
+    if (across)
     {
-        offset = -1;
+        // Move within the line only
+        bool next        = direction == FocusDirection::RIGHT || direction == FocusDirection::DOWN;
+        size_t nextIndex = next ? index + 1 : index - 1;
+        if (nextIndex < this->cacheLineData.size() && this->cacheLineData[nextIndex] == line)
+        {
+            RecyclerCell* cell = this->getCellAt(nextIndex);
+            if (cell)
+                currentFocus = cell->getDefaultFocus();
+        }
     }
-
-    size_t currentFocusIndex = *((size_t*)parentUserData) + offset;
-    View* currentFocus       = nullptr;
-
-    while (!currentFocus && currentFocusIndex >= 0 && currentFocusIndex < this->cacheIndexPathData.size())
+    else
     {
-        for (auto it : this->contentBox->getChildren())
+        // Move to the same column of the previous or next line, or its last row if shorter
+        size_t column   = index - this->cacheLineStartData[line];
+        size_t offset   = forward ? 1 : -1;
+        size_t nextLine = line + offset;
+
+        while (!currentFocus && nextLine < this->cacheLineHeightData.size())
         {
-            if (*((size_t*)it->getParentUserData()) == currentFocusIndex)
-            {
-                currentFocus = it->getDefaultFocus();
+            size_t start = this->cacheLineStartData[nextLine];
+            size_t end   = this->cacheLineStartData[nextLine + 1];
+
+            RecyclerCell* cell = this->getCellAt(std::min(start + column, end - 1));
+            if (!cell)
                 break;
-            }
+
+            currentFocus = cell->getDefaultFocus();
+            nextLine += offset;
         }
-        currentFocusIndex += offset;
     }
 
     currentFocus = getParentNavigationDecision(this, currentFocus, direction);
@@ -171,29 +198,60 @@ View* RecyclerFrame::getNextCellFocus(FocusDirection direction, View* currentVie
     return currentFocus;
 }
 
+FocusGraphMode RecyclerFrame::getFocusGraphMode()
+{
+    // Only the visible cells exist, the navigation loads the others
+    return FocusGraphMode::OWN;
+}
+
 RecyclerFrame::RecyclerFrame()
+    : RecyclerFrame(Axis::COLUMN)
+{
+}
+
+RecyclerFrame::RecyclerFrame(Axis axis)
+    : BaseScrollingFrame(axis)
 {
     registerCell("brls::Header", []() { return RecyclerHeader::create(); });
 
     // Padding
-    this->registerFloatXMLAttribute("paddingTop", [this](float value) {
-        this->setPaddingTop(value);
-    });
-
-    this->registerFloatXMLAttribute("paddingRight", [this](float value) {
-        this->setPaddingRight(value);
-    });
-
-    this->registerFloatXMLAttribute("paddingBottom", [this](float value) {
-        this->setPaddingBottom(value);
-    });
-
-    this->registerFloatXMLAttribute("paddingLeft", [this](float value) {
-        this->setPaddingLeft(value);
-    });
-
-    this->registerFloatXMLAttribute("padding", [this](float value) {
-        this->setPadding(value);
+    this->registerXMLAttributes<RecyclerFrame>([](XMLAttributes<RecyclerFrame>& attributes) {
+        attributes.registerFloatXMLAttribute("paddingTop", [](RecyclerFrame* view, float value) {
+            view->setPaddingTop(value);
+        });
+
+        attributes.registerFloatXMLAttribute("paddingRight", [](RecyclerFrame* view, float value) {
+            view->setPaddingRight(value);
+        });
+
+        attributes.registerFloatXMLAttribute("paddingBottom", [](RecyclerFrame* view, float value) {
+            view->setPaddingBottom(value);
+        });
+
+        attributes.registerFloatXMLAttribute("paddingLeft", [](RecyclerFrame* view, float value) {
+            view->setPaddingLeft(value);
+        });
+
+        attributes.registerFloatXMLAttribute("padding", [](RecyclerFrame* view, float value) {
+            view->setPadding(value);
+        });
+
+        // Grid
+        attributes.registerFloatXMLAttribute("columns", [](RecyclerFrame* view, float value) {
+            view->setColumns((size_t)value);
+        });
+
+        attributes.registerFloatXMLAttribute("minColumnWidth", [](RecyclerFrame* view, float value) {
+            view->setMinColumnWidth(value);
+        });
+
+        attributes.registerFloatXMLAttribute("columnSpacing", [](RecyclerFrame* view, float value) {
+            view->setColumnSpacing(value);
+        });
+
+        attributes.registerFloatXMLAttribute("rowSpacing", [](RecyclerFrame* view, float value) {
+            view->setRowSpacing(value);
+        });
     });
 
     this->setScrollingBehavior(ScrollingBehavior::CENTERED);
@@ -208,16 +266,17 @@ RecyclerFrame::~RecyclerFrame()
     if (this->dataSource && this->deleteDataSource)
         delete dataSource;
 
-    for (auto it : queueMap)
+    for (auto& pool : cellPools)
     {
-        for (auto item : *it.second)
+        for (auto item : pool.cells)
             delete item;
-        delete it.second;
     }
 }
 
 void RecyclerFrame::setDataSource(RecyclerDataSource* source, bool deleteDataSource)
 {
+    this->cancelPrefetching();
+
     if (this->dataSource && this->deleteDataSource)
         delete this->dataSource;
 
@@ -232,214 +291,930 @@ RecyclerDataSource* RecyclerFrame::getDataSource() const
     return this->dataSource;
 }
 
+void RecyclerFrame::setContentOffsetY(float value, bool animated)
+{
+    setContentOffset(value, animated);
+}
+
+float RecyclerFrame::getContentHeight()
+{
+    return getContentSize();
+}
+
 void RecyclerFrame::reloadData()
 {
     if (!layouted)
         return;
 
-    auto children = this->contentBox->getChildren();
-    for (auto const& child : children)
-    {
-        queueReusableCell((RecyclerCell*)child);
-        this->removeCell(child);
-    }
-
-    visibleMin = UINT_MAX;
-    visibleMax = 0;
-
-    renderedFrame            = Rect();
-    renderedFrame.size.width = getWidth();
-
-    setContentOffsetY(0, false);
+    cancelPrefetching();
+    recycleAllCells();
+    setContentOffset(0, false);
+    lastVisibleOffset = 0;
 
     if (dataSource)
     {
         cacheCellFrames();
-        Rect frame  = getLocalFrame();
-        int counter = 0;
-        for (int section = 0; section < dataSource->numberOfSections(this); section++)
+        if (!cacheRowSizeData.empty())
         {
-            for (int row = -1; row < dataSource->numberOfRows(this, section); row++)
-            {
-                addCellAt(counter++, true);
-                if (renderedFrame.getMaxY() > frame.getMaxY())
-                    break;
-            }
+            addLineAt(0, true);
+            cellsRecyclingLoop();
         }
 
         selectRowAt(defaultCellFocus, false);
     }
 }
 
-void RecyclerFrame::registerCell(std::string identifier, std::function<RecyclerCell*()> allocation)
+size_t RecyclerFrame::registerCell(std::string identifier, std::function<RecyclerCell*()> allocation, size_t warmUp)
 {
-    queueMap.insert(std::make_pair(identifier, new std::vector<RecyclerCell*>()));
-    allocationMap.insert(std::make_pair(identifier, allocation));
+    auto it = cellPoolHandles.find(identifier);
+    if (it == cellPoolHandles.end())
+    {
+        it = cellPoolHandles.insert(std::make_pair(identifier, cellPools.size())).first;
+        cellPools.push_back(CellPool { identifier, allocation, {} });
+    }
+
+    size_t handle  = it->second;
+    CellPool& pool = cellPools[handle];
+
+    pool.cells.reserve(pool.cells.size() + warmUp);
+    for (size_t i = 0; i < warmUp; i++)
+        pool.cells.push_back(allocateCell(handle));
+
+    return handle;
 }
 
-RecyclerCell* RecyclerFrame::dequeueReusableCell(std::string identifier)
+RecyclerCell* RecyclerFrame::allocateCell(size_t handle)
 {
-    RecyclerCell* cell = nullptr;
-    auto it            = queueMap.find(identifier);
+    CellPool& pool = cellPools[handle];
 
-    if (it != queueMap.end())
+    RecyclerCell* cell    = pool.allocation();
+    cell->reuseIdentifier = pool.identifier;
+    cell->reuseHandle     = handle;
+    cell->detach();
+
+    return cell;
+}
+
+RecyclerCell* RecyclerFrame::dequeueReusableCell(const std::string& identifier)
+{
+    auto it = cellPoolHandles.find(identifier);
+    if (it == cellPoolHandles.end())
+        return nullptr;
+
+    return dequeueReusableCell(it->second);
+}
+
+RecyclerCell* RecyclerFrame::dequeueReusableCell(size_t handle)
+{
+    if (handle >= cellPools.size())
+        return nullptr;
+
+    RecyclerCell* cell;
+    std::vector<RecyclerCell*>& cells = cellPools[handle].cells;
+
+    if (!cells.empty())
     {
-        std::vector<RecyclerCell*>* vector = it->second;
-        if (!vector->empty())
-        {
-            cell = vector->back();
-            vector->pop_back();
-        }
-        else
-        {
-            cell                  = allocationMap.at(identifier)();
-            cell->reuseIdentifier = identifier;
-            cell->detach();
-        }
+        cell = cells.back();
+        cells.pop_back();
+    }
+    else
+    {
+        cell = allocateCell(handle);
     }
 
-    if (cell)
-        cell->prepareForReuse();
+    cell->prepareForReuse();
 
     return cell;
 }
 
-// TODO: Implement it normally
 void RecyclerFrame::selectRowAt(IndexPath indexPath, bool animated)
 {
-    size_t count    = 0;
-    float offset = 0;
+    size_t index = this->getRowIndex(indexPath);
+    if (index >= this->cacheRowSizeData.size())
+        return;
+
+    float offset = this->getLineOffset(this->cacheLineData[index] + 1) - this->getScrollingAreaSize() / 2;
+    this->setContentOffset(offset, animated);
+    this->cellsRecyclingLoop();
+
+    RecyclerCell* cell = this->getCellAt(index);
+    if (cell)
+        contentBox->setLastFocusedView(cell);
+}
+
+static bool indexPathLess(const IndexPath& a, const IndexPath& b)
+{
+    return a.section < b.section || (a.section == b.section && a.row < b.row);
+}
+
+void RecyclerFrame::insertRows(std::vector<IndexPath> indexPaths)
+{
+    if (!dataSource || !layouted)
+        return;
+
+    // Each index path refers to the rows with the previous ones inserted
+    std::sort(indexPaths.begin(), indexPaths.end(), indexPathLess);
+
+    beginUpdates();
+    for (IndexPath indexPath : indexPaths)
+    {
+        size_t index = getRowIndex(indexPath);
+        if (indexPath.row < 0 || index > getSectionEnd(indexPath.section))
+            continue;
+
+        insertCachedRow(index, IndexPath(indexPath.section, indexPath.row), queryRowHeight(indexPath), nullptr);
+    }
+    endUpdates();
+}
+
+void RecyclerFrame::deleteRows(std::vector<IndexPath> indexPaths)
+{
+    if (!dataSource || !layouted)
+        return;
+
+    // Delete from the bottom so that the other index paths stay valid
+    std::sort(indexPaths.begin(), indexPaths.end(), indexPathLess);
+
+    beginUpdates();
+    for (auto it = indexPaths.rbegin(); it != indexPaths.rend(); it++)
+    {
+        size_t index = getRowIndex(*it);
+        if (it->row < 0 || index >= getSectionEnd(it->section))
+            continue;
+
+        RecyclerCell* cell = eraseCachedRow(index);
+        if (cell)
+            staleCells.push_back(std::make_pair(index, cell));
+    }
+    endUpdates();
+}
+
+void RecyclerFrame::reloadRows(std::vector<IndexPath> indexPaths)
+{
+    if (!dataSource || !layouted)
+        return;
+
+    beginUpdates();
+    for (IndexPath indexPath : indexPaths)
+    {
+        size_t index = getRowIndex(indexPath);
+        if (indexPath.row < 0 || index >= getSectionEnd(indexPath.section))
+            continue;
+
+        cacheRowSizeData[index] = queryRowHeight(indexPath);
+
+        RecyclerCell* cell = takeCellAt(index);
+        if (cell)
+            staleCells.push_back(std::make_pair(index, cell));
+    }
+    endUpdates();
+}
+
+void RecyclerFrame::moveRow(IndexPath from, IndexPath to)
+{
+    if (!dataSource || !layouted)
+        return;
+
+    size_t fromIndex = getRowIndex(from);
+    if (from.row < 0 || to.row < 0 || fromIndex >= getSectionEnd(from.section))
+        return;
+
+    beginUpdates();
+
+    // The measured height and the cell go along with the row
+    float height       = cacheRowSizeData[fromIndex];
+    RecyclerCell* cell = eraseCachedRow(fromIndex);
+
+    size_t toIndex = getRowIndex(to);
+    if (toIndex > getSectionEnd(to.section))
+    {
+        toIndex = fromIndex;
+        to      = from;
+    }
+
+    insertCachedRow(toIndex, IndexPath(to.section, to.row), height, cell);
+
+    endUpdates();
+}
 
-    for (size_t j = 0; j < indexPath.section; j++)
-        for (int i = -1; i < (dataSource->numberOfRows(this, j)); i++)
+size_t RecyclerFrame::getRowIndex(IndexPath indexPath)
+{
+    if (indexPath.section >= cacheSectionStartData.size())
+        return SIZE_MAX;
+
+    // Headers take the row -1 of their section
+    return cacheSectionStartData[indexPath.section] + indexPath.row + 1;
+}
+
+size_t RecyclerFrame::getSectionEnd(size_t section)
+{
+    if (section + 1 < cacheSectionStartData.size())
+        return cacheSectionStartData[section + 1];
+    return cacheRowSizeData.size();
+}
+
+void RecyclerFrame::beginUpdates()
+{
+    cancelPrefetching();
+
+    // The first cell fully visible stays in place on screen
+    float visibleStart = getVisibleStart();
+    updateAnchor       = nullptr;
+
+    for (RecyclerCell* cell : visibleCells)
+    {
+        if (getCellOffset(cell) >= visibleStart)
         {
-            offset += this->cacheFramesData[count++].height;
+            updateAnchor = cell;
+            break;
         }
+    }
+}
+
+void RecyclerFrame::endUpdates()
+{
+    size_t count = cacheRowSizeData.size();
 
-    for (int i = -1; i <= indexPath.row; i++)
-        offset += this->cacheFramesData[count++].height;
+    cacheLines();
+    updateContentSize();
 
-    offset -= this->getHeight() / 2;
-    this->setContentOffsetY(offset, animated);
-    this->cellsRecyclingLoop();
+    bool refocus        = false;
+    size_t refocusIndex = 0;
 
-    for (View* view : contentBox->getChildren())
+    // Cells of the deleted and reloaded rows
+    for (auto& stale : staleCells)
     {
-        if (*((size_t*)view->getParentUserData()) == count - 1)
+        RecyclerCell* cell = stale.second;
+        if (cell->isFocused() || cell->isChildFocused())
         {
-            contentBox->setLastFocusedView(view);
-            break;
+            refocus      = true;
+            refocusIndex = stale.first;
         }
+
+        if (cell == updateAnchor)
+            updateAnchor = nullptr;
+
+        if (cell == contentBox->getLastFocusedView())
+            contentBox->setLastFocusedView(nullptr);
+
+        queueReusableCell(cell);
+        this->removeCell(cell);
+    }
+    staleCells.clear();
+
+    // Cells of the other rows, to be put back in place
+    std::map<size_t, RecyclerCell*> keptCells;
+    for (RecyclerCell* cell : visibleCells)
+        keptCells[cell->recyclerIndex] = cell;
+
+    visibleCells.clear();
+    visibleMin = UINT_MAX;
+    visibleMax = 0;
+
+    renderedStart = 0;
+    renderedEnd   = 0;
+
+    if (updateAnchor)
+    {
+        size_t anchorLine  = cacheLineData[updateAnchor->recyclerIndex];
+        float anchorOffset = getLineOffset(anchorLine) + getPaddingStart();
+        if (anchorOffset != getCellOffset(updateAnchor))
+            setContentOffset(getContentOffset() + anchorOffset - getCellOffset(updateAnchor), false);
+        updateAnchor = nullptr;
+    }
+
+    if (count > 0)
+    {
+        float visibleEnd = getVisibleEnd();
+        size_t line      = getLineAt(getVisibleStart() - getPaddingStart());
+
+        renderedStart = getLineOffset(line);
+        renderedEnd   = renderedStart;
+
+        do
+        {
+            addLineAt(line++, true, &keptCells);
+        } while (line < getLineCount() && renderedEnd < visibleEnd - getPaddingEnd());
+    }
+
+    // Cells that went out of the visible frame
+    for (auto& it : keptCells)
+    {
+        RecyclerCell* cell = it.second;
+        if (cell->isFocused() || cell->isChildFocused())
+        {
+            refocus      = true;
+            refocusIndex = it.first;
+        }
+
+        if (cell == contentBox->getLastFocusedView())
+            contentBox->setLastFocusedView(nullptr);
+
+        queueReusableCell(cell);
+        this->removeCell(cell);
+    }
+
+    cellsRecyclingLoop();
+
+    if (refocus && !visibleCells.empty())
+    {
+        RecyclerCell* cell = getCellAt(std::min(refocusIndex, count - 1));
+        if (!cell)
+            cell = visibleCells.front();
+
+        contentBox->setLastFocusedView(cell);
+        if (cell->getDefaultFocus())
+            Application::giveFocus(cell->getDefaultFocus());
     }
 }
 
+void RecyclerFrame::insertCachedRow(size_t index, IndexPath indexPath, float height, RecyclerCell* cell)
+{
+    cacheRowSizeData.insert(cacheRowSizeData.begin() + index, height);
+    cacheIndexPathData.insert(cacheIndexPathData.begin() + index, indexPath);
+
+    for (size_t i = index + 1; i < cacheIndexPathData.size() && cacheIndexPathData[i].section == indexPath.section; i++)
+        cacheIndexPathData[i] = IndexPath(indexPath.section, cacheIndexPathData[i].row + 1);
+
+    for (size_t section = indexPath.section + 1; section < cacheSectionStartData.size(); section++)
+        cacheSectionStartData[section]++;
+
+    for (RecyclerCell* visibleCell : visibleCells)
+    {
+        if (visibleCell->recyclerIndex >= index)
+            visibleCell->recyclerIndex++;
+    }
+
+    if (cell)
+    {
+        cell->recyclerIndex = index;
+        visibleCells.push_back(cell);
+    }
+}
+
+RecyclerCell* RecyclerFrame::eraseCachedRow(size_t index)
+{
+    RecyclerCell* cell  = takeCellAt(index);
+    IndexPath indexPath = cacheIndexPathData[index];
+
+    cacheRowSizeData.erase(cacheRowSizeData.begin() + index);
+    cacheIndexPathData.erase(cacheIndexPathData.begin() + index);
+
+    for (size_t i = index; i < cacheIndexPathData.size() && cacheIndexPathData[i].section == indexPath.section; i++)
+        cacheIndexPathData[i] = IndexPath(indexPath.section, cacheIndexPathData[i].row - 1);
+
+    for (size_t section = indexPath.section + 1; section < cacheSectionStartData.size(); section++)
+        cacheSectionStartData[section]--;
+
+    for (RecyclerCell* visibleCell : visibleCells)
+    {
+        if (visibleCell->recyclerIndex > index)
+            visibleCell->recyclerIndex--;
+    }
+
+    return cell;
+}
+
+RecyclerCell* RecyclerFrame::takeCellAt(size_t index)
+{
+    // visibleCells is not ordered while updating, look for the cell
+    for (auto it = visibleCells.begin(); it != visibleCells.end(); it++)
+    {
+        if ((*it)->recyclerIndex == index)
+        {
+            RecyclerCell* cell = *it;
+            visibleCells.erase(it);
+            return cell;
+        }
+    }
+
+    return nullptr;
+}
+
 void RecyclerFrame::queueReusableCell(RecyclerCell* cell)
 {
-    queueMap.at(cell->reuseIdentifier)->push_back(cell);
+    cellPools[cell->reuseHandle].cells.push_back(cell);
 }
 
 void RecyclerFrame::cacheCellFrames()
 {
-    cacheFramesData.clear();
+    cacheRowSizeData.clear();
     cacheIndexPathData.clear();
-    Rect frame = getFrame();
-    Point currentOrigin;
+    cacheSectionStartData.clear();
 
     if (dataSource)
     {
         for (int section = 0; section < dataSource->numberOfSections(this); section++)
         {
+            cacheSectionStartData.push_back(cacheRowSizeData.size());
+
             for (int row = -1; row < dataSource->numberOfRows(this, section); row++)
             {
                 cacheIndexPathData.push_back(IndexPath(section, row));
+                cacheRowSizeData.push_back(queryRowHeight(IndexPath(section, row)));
+            }
+        }
+    }
 
-                float height = row == -1 ? dataSource->heightForHeader(this, section) : dataSource->heightForRow(this, IndexPath(section, row));
+    cacheLines();
 
-                if (height == -1)
-                    height = estimatedRowHeight;
+    if (dataSource)
+        updateContentSize();
+}
 
-                cacheFramesData.push_back(Size(frame.getWidth(), height));
-                currentOrigin.y += height;
-            }
+void RecyclerFrame::cacheLines()
+{
+    size_t columns = getColumns();
+
+    cacheLineStartData.clear();
+    cacheLineData.clear();
+    cacheLineHeightData.clear();
+
+    for (size_t index = 0; index < cacheRowSizeData.size(); index++)
+    {
+        IndexPath indexPath = cacheIndexPathData[index];
+
+        // Headers take a full line, rows fill lines of columns
+        if (cacheLineStartData.empty() || indexPath.row <= 0 || index - cacheLineStartData.back() >= columns)
+        {
+            cacheLineStartData.push_back(index);
+            cacheLineHeightData.push_back(0);
         }
-        contentBox->setHeight(currentOrigin.y + paddingTop + paddingBottom);
+
+        cacheLineData.push_back(cacheLineStartData.size() - 1);
+        cacheLineHeightData.back() = std::max(cacheLineHeightData.back(), getLineHeight(index, cacheRowSizeData[index]));
+    }
+
+    cacheLineStartData.push_back(cacheRowSizeData.size());
+
+    buildLineOffsets();
+}
+
+float RecyclerFrame::getLineHeight(size_t index, float rowHeight)
+{
+    if (cacheIndexPathData[index].row == -1)
+        return rowHeight;
+    return rowHeight + rowSpacing;
+}
+
+size_t RecyclerFrame::getLineCount()
+{
+    return cacheLineHeightData.size();
+}
+
+size_t RecyclerFrame::getColumns()
+{
+    if (minColumnWidth <= 0)
+        return columns;
+
+    float width = getCrossSize(this) - getCrossPaddingStart() - getCrossPaddingEnd();
+    return std::max((size_t)1, (size_t)((width + columnSpacing) / (minColumnWidth + columnSpacing)));
+}
+
+void RecyclerFrame::setColumns(size_t columns)
+{
+    this->columns = std::max((size_t)1, columns);
+    this->reloadData();
+}
+
+void RecyclerFrame::setMinColumnWidth(float width)
+{
+    this->minColumnWidth = width;
+    this->reloadData();
+}
+
+void RecyclerFrame::setColumnSpacing(float spacing)
+{
+    this->columnSpacing = spacing;
+    this->reloadData();
+}
+
+void RecyclerFrame::setRowSpacing(float spacing)
+{
+    this->rowSpacing = spacing;
+    this->reloadData();
+}
+
+float RecyclerFrame::queryRowHeight(IndexPath indexPath)
+{
+    float height = indexPath.row == -1 ? dataSource->heightForHeader(this, indexPath.section) : dataSource->heightForRow(this, indexPath);
+
+    if (height == -1)
+        height = estimatedRowHeight;
+
+    return height;
+}
+
+void RecyclerFrame::setPrefetchLines(size_t lines)
+{
+    this->cancelPrefetching();
+    this->prefetchLines = lines;
+}
+
+// Scrolling time covered by the lookahead, in frames
+static constexpr float PREFETCH_FRAMES = 30;
+
+void RecyclerFrame::updatePrefetching(float visibleStart)
+{
+    float delta       = visibleStart - lastVisibleOffset;
+    lastVisibleOffset = visibleStart;
+
+    bool wasScrollingDown = scrollingDown;
+    if (delta != 0)
+        scrollingDown = delta > 0;
+
+    if (prefetchLines == 0 || visibleCells.empty())
+        return cancelPrefetching();
+
+    // Look further the faster it scrolls, up to two screens
+    float lookahead = std::min(std::abs(delta) * PREFETCH_FRAMES, getScrollingAreaSize() * 2);
+
+    size_t min = 0, max = 0;
+    if (scrollingDown)
+    {
+        size_t first = cacheLineData[visibleMax] + 1;
+        if (first < getLineCount())
+        {
+            size_t last = std::min(getLineAt(renderedEnd + lookahead) + prefetchLines, getLineCount() - 1);
+            min         = cacheLineStartData[first];
+            max         = cacheLineStartData[std::max(first, last) + 1];
+        }
+    }
+    else
+    {
+        size_t last = cacheLineData[visibleMin];
+        if (last > 0)
+        {
+            size_t first = getLineAt(renderedStart - lookahead);
+            first        = first >= prefetchLines - 1 ? first - (prefetchLines - 1) : 0;
+            min          = cacheLineStartData[std::min(first, last - 1)];
+            max          = cacheLineStartData[last];
+        }
+    }
+
+    // Keep the rows already prefetched further ahead while slowing down
+    if (scrollingDown == wasScrollingDown && prefetchMin < prefetchMax)
+    {
+        if (scrollingDown && prefetchMin <= max && prefetchMax > max)
+            max = prefetchMax;
+        else if (!scrollingDown && prefetchMax >= min && prefetchMin < min)
+            min = prefetchMin;
+    }
+
+    if (min == prefetchMin && max == prefetchMax)
+        return;
+
+    // Rows that were displayed in the meantime are not cancelled
+    cancelledRows.clear();
+    for (size_t index = prefetchMin; index < prefetchMax; index++)
+    {
+        if ((index < min || index >= max) && (index < visibleMin || index > visibleMax) && cacheIndexPathData[index].row != -1)
+            cancelledRows.push_back(cacheIndexPathData[index]);
+    }
+
+    prefetchedRows.clear();
+    for (size_t i = 0; i < max - min; i++)
+    {
+        size_t index = scrollingDown ? min + i : max - 1 - i;
+        if ((index < prefetchMin || index >= prefetchMax) && cacheIndexPathData[index].row != -1)
+            prefetchedRows.push_back(cacheIndexPathData[index]);
+    }
+
+    prefetchMin = min;
+    prefetchMax = max;
+
+    if (!cancelledRows.empty())
+        dataSource->cancelPrefetchingForRowsAt(this, cancelledRows);
+
+    if (!prefetchedRows.empty())
+        dataSource->prefetchRowsAt(this, prefetchedRows);
+}
+
+void RecyclerFrame::cancelPrefetching()
+{
+    cancelledRows.clear();
+    for (size_t index = prefetchMin; index < prefetchMax && index < cacheIndexPathData.size(); index++)
+    {
+        if ((index < visibleMin || index > visibleMax) && cacheIndexPathData[index].row != -1)
+            cancelledRows.push_back(cacheIndexPathData[index]);
+    }
+
+    prefetchMin = 0;
+    prefetchMax = 0;
+
+    if (dataSource && !cancelledRows.empty())
+        dataSource->cancelPrefetchingForRowsAt(this, cancelledRows);
+}
+
+static inline size_t lowestBit(size_t i)
+{
+    return i & (~i + 1);
+}
+
+void RecyclerFrame::buildLineOffsets()
+{
+    size_t count = getLineCount();
+    lineOffsetTree.assign(count + 1, 0);
+
+    for (size_t i = 1; i <= count; i++)
+    {
+        lineOffsetTree[i] += cacheLineHeightData[i - 1];
+
+        size_t parent = i + lowestBit(i);
+        if (parent <= count)
+            lineOffsetTree[parent] += lineOffsetTree[i];
+    }
+}
+
+void RecyclerFrame::updateLineHeight(size_t line, float delta)
+{
+    for (size_t i = line + 1; i < lineOffsetTree.size(); i += lowestBit(i))
+        lineOffsetTree[i] += delta;
+}
+
+float RecyclerFrame::getLineOffset(size_t line)
+{
+    double offset = 0;
+    for (size_t i = std::min(line, getLineCount()); i > 0; i -= lowestBit(i))
+        offset += lineOffsetTree[i];
+    return (float)offset;
+}
+
+size_t RecyclerFrame::getLineAt(float offset)
+{
+    size_t count = getLineCount();
+    if (count == 0)
+        return 0;
+
+    size_t step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+
+    // Find the number of lines ending above the offset
+    size_t lines     = 0;
+    double remaining = offset;
+    for (; step > 0; step /= 2)
+    {
+        if (lines + step <= count && lineOffsetTree[lines + step] < remaining)
+        {
+            lines += step;
+            remaining -= lineOffsetTree[lines];
+        }
+    }
+
+    return std::min(lines, count - 1);
+}
+
+RecyclerCell* RecyclerFrame::getCellAt(size_t index)
+{
+    if (visibleCells.empty() || index < visibleMin || index > visibleMax)
+        return nullptr;
+
+    return visibleCells[index - visibleMin];
+}
+
+void RecyclerFrame::recycleAllCells()
+{
+    for (RecyclerCell* cell : visibleCells)
+    {
+        queueReusableCell(cell);
+        this->removeCell(cell);
     }
+    visibleCells.clear();
+
+    visibleMin = UINT_MAX;
+    visibleMax = 0;
+
+    renderedStart = 0;
+    renderedEnd   = 0;
 }
 
-bool RecyclerFrame::checkWidth()
+void RecyclerFrame::restartCellsAt(size_t line)
 {
-    float width           = getWidth();
-    static float oldWidth = width;
-    if ((int)oldWidth != (int)width && width != 0)
+    recycleAllCells();
+
+    renderedStart = getLineOffset(line);
+    renderedEnd   = renderedStart;
+    addLineAt(line, true);
+}
+
+bool RecyclerFrame::checkCrossSize()
+{
+    float size = getCrossSize(this);
+    if ((int)lastCrossSize != (int)size && size != 0)
     {
-        oldWidth = width;
+        lastCrossSize = size;
         return true;
     }
-    oldWidth = width;
+    lastCrossSize = size;
     return false;
 }
 
+bool RecyclerFrame::isVertical()
+{
+    return getAxis() == Axis::COLUMN;
+}
+
+float RecyclerFrame::getMainSize(View* view)
+{
+    return isVertical() ? view->getHeight() : view->getWidth();
+}
+
+float RecyclerFrame::getCrossSize(View* view)
+{
+    return isVertical() ? view->getWidth() : view->getHeight();
+}
+
+float RecyclerFrame::getPaddingStart()
+{
+    return isVertical() ? paddingTop : paddingLeft;
+}
+
+float RecyclerFrame::getPaddingEnd()
+{
+    return isVertical() ? paddingBottom : paddingRight;
+}
+
+float RecyclerFrame::getCrossPaddingStart()
+{
+    return isVertical() ? paddingLeft : paddingTop;
+}
+
+float RecyclerFrame::getCrossPaddingEnd()
+{
+    return isVertical() ? paddingRight : paddingBottom;
+}
+
+float RecyclerFrame::getVisibleStart()
+{
+    Rect frame = getVisibleFrame();
+    return isVertical() ? frame.getMinY() : frame.getMinX();
+}
+
+float RecyclerFrame::getVisibleEnd()
+{
+    Rect frame = getVisibleFrame();
+    return isVertical() ? frame.getMaxY() : frame.getMaxX();
+}
+
+float RecyclerFrame::getCellOffset(RecyclerCell* cell)
+{
+    Point position = cell->getDetachedPosition();
+    return isVertical() ? position.y : position.x;
+}
+
+float RecyclerFrame::getCellCrossOffset(RecyclerCell* cell)
+{
+    Point position = cell->getDetachedPosition();
+    return isVertical() ? position.x : position.y;
+}
+
+void RecyclerFrame::setCellOffsets(RecyclerCell* cell, float offset, float crossOffset)
+{
+    if (isVertical())
+        cell->setDetachedPosition(crossOffset, offset);
+    else
+        cell->setDetachedPosition(offset, crossOffset);
+}
+
+void RecyclerFrame::updateContentSize()
+{
+    // The layout of the content box may not be up to date, take the total from the lines
+    float size = getLineOffset(getLineCount()) + getPaddingStart() + getPaddingEnd();
+
+    if (isVertical())
+        contentBox->setHeight(size);
+    else
+        contentBox->setWidth(size);
+}
+
 void RecyclerFrame::cellsRecyclingLoop()
 {
-    Rect visibleFrame = getVisibleFrame();
+    if (!dataSource || cacheRowSizeData.empty())
+        return;
+
+    float visibleStart = getVisibleStart() - getPaddingStart();
+    float visibleEnd   = getVisibleEnd() - getPaddingStart();
 
-    while (true)
+    // None of the rendered cells can stay visible (after a jump or a fast scroll),
+    // start over from the first visible line instead of going through all the lines in between
+    if (visibleCells.empty() || renderedEnd < visibleStart || renderedStart > visibleEnd)
+        restartCellsAt(getLineAt(visibleStart));
+
+    while (!visibleCells.empty())
     {
-        RecyclerCell* minCell = nullptr;
-        for (auto it : contentBox->getChildren())
-            if (*((size_t*)it->getParentUserData()) == visibleMin)
-                minCell = (RecyclerCell*)it;
+        size_t line      = cacheLineData[visibleMin];
+        float lineHeight = cacheLineHeightData[line];
 
-        if (!minCell || minCell->getDetachedPosition().y + minCell->getHeight() >= visibleFrame.getMinY())
+        if (renderedStart + lineHeight >= visibleStart)
             break;
 
-        float cellHeight = minCell->getHeight();
-        renderedFrame.origin.y += cellHeight;
-        renderedFrame.size.height -= cellHeight;
-
-        queueReusableCell(minCell);
-        this->removeCell(minCell);
+        renderedStart += lineHeight;
 
-        Logger::debug("Cell #{} - destroyed", visibleMin);
+        while (!visibleCells.empty() && cacheLineData[visibleMin] == line)
+        {
+            RecyclerCell* minCell = visibleCells.front();
+            visibleCells.erase(visibleCells.begin());
+            queueReusableCell(minCell);
+            this->removeCell(minCell);
 
-        visibleMin++;
+            visibleMin++;
+        }
     }
 
-    while (true)
+    while (!visibleCells.empty())
     {
-        RecyclerCell* maxCell = nullptr;
-        for (auto it : contentBox->getChildren())
-            if (*((size_t*)it->getParentUserData()) == visibleMax)
-                maxCell = (RecyclerCell*)it;
+        size_t line      = cacheLineData[visibleMax];
+        float lineHeight = cacheLineHeightData[line];
 
-        if (!maxCell || maxCell->getDetachedPosition().y <= visibleFrame.getMaxY())
+        if (renderedEnd - lineHeight <= visibleEnd)
             break;
 
-        float cellHeight = maxCell->getHeight();
-        renderedFrame.size.height -= cellHeight;
-
-        queueReusableCell(maxCell);
-        this->removeCell(maxCell);
+        renderedEnd -= lineHeight;
 
-        Logger::debug("Cell #{} - destroyed", visibleMax);
+        while (!visibleCells.empty() && cacheLineData[visibleMax] == line)
+        {
+            RecyclerCell* maxCell = visibleCells.back();
+            visibleCells.pop_back();
+            queueReusableCell(maxCell);
+            this->removeCell(maxCell);
 
-        visibleMax--;
+            visibleMax--;
+        }
     }
 
-    while (visibleMin - 1 < cacheFramesData.size() && renderedFrame.getMinY() > visibleFrame.getMinY() - paddingTop)
+    if (visibleCells.empty())
+        restartCellsAt(getLineAt(visibleStart));
+
+    while (cacheLineData[visibleMin] > 0 && renderedStart > visibleStart)
+        addLineAt(cacheLineData[visibleMin] - 1, false);
+
+    while (cacheLineData[visibleMax] + 1 < getLineCount() && renderedEnd < visibleEnd + getPaddingStart() - getPaddingEnd())
+        addLineAt(cacheLineData[visibleMax] + 1, true);
+
+    updatePrefetching(visibleStart + getPaddingStart());
+}
+
+void RecyclerFrame::addLineAt(size_t line, bool downSide, std::map<size_t, RecyclerCell*>* keptCells)
+{
+    size_t start = cacheLineStartData[line];
+    size_t end   = cacheLineStartData[line + 1];
+
+    // The cells of the line go straight into visibleCells, from this position
+    size_t first     = downSide ? visibleCells.size() : 0;
+    float lineHeight = 0;
+
+    for (size_t index = start; index < end; index++)
     {
-        int i = visibleMin - 1;
-        addCellAt(i, false);
+        RecyclerCell* cell = nullptr;
+
+        if (keptCells)
+        {
+            auto it = keptCells->find(index);
+            if (it != keptCells->end())
+            {
+                cell = it->second;
+                keptCells->erase(it);
+            }
+        }
+
+        if (!cell)
+            cell = createCellAt(index);
+
+        placeCell(cell, index);
+        visibleCells.insert(visibleCells.begin() + first + (index - start), cell);
+
+        float cellSize          = getMainSize(cell);
+        cacheRowSizeData[index] = cellSize;
+
+        lineHeight = std::max(lineHeight, getLineHeight(index, cellSize));
     }
 
-    while (visibleMax + 1 < cacheFramesData.size() && renderedFrame.getMaxY() < visibleFrame.getMaxY() - paddingBottom)
+    float lineOffset = (downSide ? renderedEnd : renderedStart - lineHeight) + getPaddingStart();
+    for (size_t i = first; i < first + end - start; i++)
+        setCellOffsets(visibleCells[i], lineOffset, getCellCrossOffset(visibleCells[i]));
+
+    if (start < visibleMin)
+        visibleMin = start;
+
+    if (end - 1 > visibleMax)
+        visibleMax = end - 1;
+
+    if (downSide)
+        renderedEnd += lineHeight;
+    else
+        renderedStart -= lineHeight;
+
+    if (lineHeight != cacheLineHeightData[line])
     {
-        int i = visibleMax + 1;
-        addCellAt(i, true);
+        updateLineHeight(line, lineHeight - cacheLineHeightData[line]);
+        cacheLineHeightData[line] = lineHeight;
+
+        updateContentSize();
     }
 }
 
-void RecyclerFrame::addCellAt(size_t index, size_t downSide)
+RecyclerCell* RecyclerFrame::createCellAt(size_t index)
 {
     IndexPath indexPath = cacheIndexPathData[index];
 
@@ -449,49 +1224,47 @@ void RecyclerFrame::addCellAt(size_t index, size_t downSide)
     else
     {
         cell = dataSource->cellForRow(this, indexPath);
-        cell->setLineBottom(1);
+        if (isVertical())
+            cell->setLineBottom(1);
+        else
+            cell->setLineRight(1);
     }
 
-    cell->setWidth(renderedFrame.getWidth() - paddingLeft - paddingRight);
-    Point cellOrigin = Point(renderedFrame.getMinX() + paddingLeft,
-        (downSide ? renderedFrame.getMaxY() : renderedFrame.getMinY() - cell->getHeight()) + paddingTop);
-
-    cell->setDetachedPosition(cellOrigin.x, cellOrigin.y);
-    cell->setIndexPath(indexPath);
+    this->contentBox->appendChild(cell);
 
-    this->contentBox->getChildren().insert(this->contentBox->getChildren().end(), cell);
-
-    // Allocate and set parent userdata
-    size_t* userdata = (size_t*)malloc(sizeof(size_t));
-    *userdata        = index;
-
-    cell->setParent(this->contentBox, userdata);
+    // The index is kept in the cell itself, see placeCell()
+    cell->setParent(this->contentBox);
 
     // Layout and events
     this->contentBox->invalidate();
     cell->View::willAppear();
 
-    if (index < visibleMin)
-        visibleMin = index;
-
-    if (index > visibleMax)
-        visibleMax = index;
-
-    Rect cellFrame = cell->getFrame();
-
-    if (!downSide)
-        renderedFrame.origin.y -= cellFrame.getHeight();
+    return cell;
+}
 
-    renderedFrame.size.height += cellFrame.getHeight();
+void RecyclerFrame::placeCell(RecyclerCell* cell, size_t index)
+{
+    size_t columns = getColumns();
+    float width    = getCrossSize(this) - getCrossPaddingStart() - getCrossPaddingEnd();
+    float x        = getCrossPaddingStart();
 
-    if (cellFrame.getHeight() != cacheFramesData[index].height)
+    // Headers always take the full width
+    if (columns > 1 && cacheIndexPathData[index].row != -1)
     {
-        float delta = cellFrame.getHeight() - cacheFramesData[index].height;
-        contentBox->setHeight(contentBox->getHeight() + delta);
-        cacheFramesData[index].height = cellFrame.getHeight();
+        size_t column = index - cacheLineStartData[cacheLineData[index]];
+        width         = (width - columnSpacing * (columns - 1)) / columns;
+        x += column * (width + columnSpacing);
     }
 
-    Logger::debug("Cell #{} - added", index);
+    if (isVertical())
+        cell->setWidth(width);
+    else
+        cell->setHeight(width);
+    cell->layoutIfNeeded();
+
+    setCellOffsets(cell, getCellOffset(cell), x);
+    cell->setIndexPath(cacheIndexPathData[index]);
+    cell->recyclerIndex = index;
 }
 
 void RecyclerFrame::removeCell(View* view)
@@ -499,29 +1272,9 @@ void RecyclerFrame::removeCell(View* view)
     if (!view)
         return;
 
-    // Find the index of the view
-    size_t index;
-    bool found = false;
-    auto& children = this->contentBox->getChildren();
-
-    for (size_t i = 0; i < children.size(); i++)
-    {
-        View* child = children[i];
-
-        if (child == view)
-        {
-            found = true;
-            index = i;
-            break;
-        }
-    }
-
-    if (!found)
+    if (!this->contentBox->eraseChild(view))
         return;
 
-    // Remove it
-    children.erase(children.begin() + index);
-
     view->willDisappear(true);
 
     this->invalidate();
@@ -529,9 +1282,8 @@ void RecyclerFrame::removeCell(View* view)
 
 void RecyclerFrame::onLayout()
 {
-    ScrollingFrame::onLayout();
-    this->contentBox->setWidth(this->getWidth());
-    if (checkWidth())
+    BaseScrollingFrame::onLayout();
+    if (checkCrossSize())
     {
         layouted = true;
         reloadData();
@@ -541,7 +1293,7 @@ void RecyclerFrame::onLayout()
 void RecyclerFrame::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
     cellsRecyclingLoop();
-    ScrollingFrame::draw(vg, x, y, width, height, style, ctx);
+    BaseScrollingFrame::draw(vg, x, y, width, height, style, ctx);
 }
 
 void RecyclerFrame::setPadding(float padding)
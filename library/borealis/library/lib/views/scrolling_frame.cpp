@@ -25,62 +25,68 @@ namespace brls
 
 #define SCROLLING_INDICATOR_WIDTH 4
 
-ScrollingFrame::ScrollingFrame()
+BaseScrollingFrame::BaseScrollingFrame(Axis axis)
+    : axis(axis)
 {
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "scrollingBehavior", ScrollingBehavior, this->setScrollingBehavior,
-        {
-            { "natural", ScrollingBehavior::NATURAL },
-            { "centered", ScrollingBehavior::CENTERED },
+    this->registerXMLAttributes<BaseScrollingFrame>([](XMLAttributes<BaseScrollingFrame>& attributes) {
+        BRLS_REGISTER_ENUM_XML_CLASS_ATTRIBUTE(
+            "scrollingBehavior", ScrollingBehavior, setScrollingBehavior,
+            {
+                { "natural", ScrollingBehavior::NATURAL },
+                { "centered", ScrollingBehavior::CENTERED },
+            });
+
+        attributes.registerBoolXMLAttribute("overscroll", [](BaseScrollingFrame* view, bool value) {
+            view->setOverscrollEnabled(value);
         });
+    });
 
     setupScrollingIndicator();
 
     this->setFocusable(true);
     this->setMaximumAllowedXMLElements(1);
 
+    scroller.setScrollCallback([this] {
+        this->scrollAnimationTick();
+    });
+
     addGestureRecognizer(new ScrollGestureRecognizer([this](PanGestureStatus state, Sound* soundToPlay) {
-        if (state.state == GestureState::FAILED || state.state == GestureState::UNSURE || state.state == GestureState::INTERRUPTED)
+        if (state.state == GestureState::UNSURE)
             return;
 
+        // Another recognizer took over, let go of the content
+        if (state.state == GestureState::FAILED || state.state == GestureState::INTERRUPTED)
+        {
+            scroller.endDrag(0);
+            return;
+        }
+
         if (state.deltaOnly)
         {
-            float newScroll = this->contentOffsetY - state.delta.y;
+            float newScroll = this->getContentOffset() - getMainAxis(state.delta);
             startScrolling(false, newScroll);
             return;
         }
 
-        static float startY;
         if (state.state == GestureState::START)
         {
             Application::giveFocus(this);
-            startY = this->contentOffsetY;
+            updateScrollRange();
+            scroller.beginDrag();
         }
 
-        float newScroll = startY - (state.position.y - state.startPosition.y);
+        scroller.dragTo(getMainAxis(state.startPosition) - getMainAxis(state.position));
 
-        // Start animation
-        if (state.state != GestureState::END)
-            startScrolling(false, newScroll);
-        else
-        {
-            float time   = state.acceleration.time.y * 1000.0f;
-            float newPos = this->contentOffsetY + state.acceleration.distance.y;
-
-            newScroll = newPos;
-
-            if (newScroll == this->contentOffsetY || time < 100)
-                return;
-
-            animateScrolling(newScroll, time);
-        }
+        // Keep going with the velocity of the finger
+        if (state.state == GestureState::END)
+            scroller.endDrag(-getMainAxis(state.velocity));
     },
-        PanAxis::VERTICAL));
+        axis == Axis::COLUMN ? PanAxis::VERTICAL : PanAxis::HORIZONTAL));
 
     // Stop scrolling on tap
     addGestureRecognizer(new TapGestureRecognizer([this](brls::TapGestureStatus status, Sound* soundToPlay) {
-        if (status.state == GestureState::UNSURE)
-            this->contentOffsetY.stop();
+        if (status.state == GestureState::UNSURE && !this->scroller.isOverscrolled())
+            this->scroller.stop();
     }));
 
     inputTypeSubscription = Application::getGlobalInputTypeChangeEvent()->subscribe([this](InputType type) {
@@ -98,36 +104,65 @@ ScrollingFrame::ScrollingFrame()
     setHideHighlightBorder(true);
 }
 
-void ScrollingFrame::setupScrollingIndicator()
+float BaseScrollingFrame::getMainAxis(Point point)
+{
+    return axis == Axis::COLUMN ? point.y : point.x;
+}
+
+float BaseScrollingFrame::getMainAxis(Size size)
+{
+    return axis == Axis::COLUMN ? size.height : size.width;
+}
+
+void BaseScrollingFrame::setupScrollingIndicator()
 {
     Theme theme        = Application::getTheme();
     scrollingIndicator = new Rectangle(theme["brls/text"]);
-    scrollingIndicator->setSize(Size(SCROLLING_INDICATOR_WIDTH, 0));
+    if (axis == Axis::COLUMN)
+        scrollingIndicator->setSize(Size(SCROLLING_INDICATOR_WIDTH, 0));
+    else
+        scrollingIndicator->setSize(Size(0, SCROLLING_INDICATOR_WIDTH));
     scrollingIndicator->setCornerRadius(SCROLLING_INDICATOR_WIDTH / 2);
     scrollingIndicator->detach();
     Box::addView(scrollingIndicator);
 }
 
-void ScrollingFrame::updateScrollingIndicatior()
+void BaseScrollingFrame::updateScrollingIndicatior()
 {
-    float contentHeight = getContentHeight();
-    float viewHeight    = getHeight();
+    float contentSize = getContentSize();
+    float viewSize    = getMainAxis(getLocalFrame().size);
 
-    if (contentHeight <= viewHeight || !showScrollingIndicator)
+    if (contentSize <= viewSize || !showScrollingIndicator)
     {
         scrollingIndicator->setAlpha(0);
         return;
     }
 
-    scrollingIndicator->setAlpha(contentHeight <= viewHeight ? 0 : 0.3f);
-    scrollingIndicator->setHeight(viewHeight / contentHeight * viewHeight);
+    scrollingIndicator->setAlpha(0.3f);
+
+    float indicatorSize    = viewSize / contentSize * viewSize;
+    float scrollViewOffset = getContentOffset() / contentSize * viewSize;
 
-    float scrollViewOffset = getContentOffsetY() / contentHeight * getHeight();
-    scrollingIndicator->setDetachedPosition(getWidth() - 14 - SCROLLING_INDICATOR_WIDTH, scrollViewOffset);
+    // Stays inside the frame during overscroll
+    scrollViewOffset = std::min(std::max(scrollViewOffset, 0.0f), viewSize - indicatorSize);
+
+    if (axis == Axis::COLUMN)
+    {
+        scrollingIndicator->setHeight(indicatorSize);
+        scrollingIndicator->setDetachedPosition(getWidth() - 14 - SCROLLING_INDICATOR_WIDTH, scrollViewOffset);
+    }
+    else
+    {
+        scrollingIndicator->setWidth(indicatorSize);
+        scrollingIndicator->setDetachedPosition(scrollViewOffset, getHeight() - 14 - SCROLLING_INDICATOR_WIDTH);
+    }
 }
 
-void ScrollingFrame::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+void BaseScrollingFrame::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
+    // The content may have been resized since the last frame
+    updateScrollRange();
+
     updateScrollingIndicatior();
     naturalScrollingBehaviour();
 
@@ -137,9 +172,12 @@ void ScrollingFrame::draw(NVGcontext* vg, float x, float y, float width, float h
 
     // Enable scissoring
     nvgSave(vg);
-    float scrollingTop    = this->getScrollingAreaTopBoundary();
-    float scrollingHeight = this->getScrollingAreaHeight();
-    nvgIntersectScissor(vg, x, scrollingTop, this->getWidth(), scrollingHeight);
+    float scrollingStart = this->getScrollingAreaStart();
+    float scrollingSize  = this->getScrollingAreaSize();
+    if (axis == Axis::COLUMN)
+        nvgIntersectScissor(vg, x, scrollingStart, this->getWidth(), scrollingSize);
+    else
+        nvgIntersectScissor(vg, scrollingStart, y, scrollingSize, this->getHeight());
 
     // Draw children
     Box::draw(vg, x, y, width, height, style, ctx);
@@ -148,7 +186,7 @@ void ScrollingFrame::draw(NVGcontext* vg, float x, float y, float width, float h
     nvgRestore(vg);
 }
 
-void ScrollingFrame::naturalScrollingBehaviour()
+void BaseScrollingFrame::naturalScrollingBehaviour()
 {
     if (behavior != ScrollingBehavior::NATURAL || Application::getInputType() == InputType::TOUCH)
         return;
@@ -164,14 +202,14 @@ void ScrollingFrame::naturalScrollingBehaviour()
         }
 
         // If current focus equals this (a.k. no focus inside scroll),
-        // try to find the closest to the top focusable view and set it as current focus.
+        // try to find the focusable view closest to the start and set it as current focus.
         if (Application::getCurrentFocus() == this && Application::getInputType() == InputType::GAMEPAD)
         {
-            View* topMostView = findTopMostFocusableView();
+            View* firstView = findFirstFocusableView();
 
-            if (topMostView && topMostView != currentFocus)
+            if (firstView && firstView != currentFocus)
             {
-                Application::giveFocus(topMostView);
+                Application::giveFocus(firstView);
                 Application::getAudioPlayer()->play(Sound::SOUND_FOCUS_CHANGE);
             }
         }
@@ -182,47 +220,47 @@ void ScrollingFrame::naturalScrollingBehaviour()
 
     if (focused || childFocused)
     {
-        auto& state       = Application::getControllerState();
-        float bottomLimit = this->getContentHeight() - this->getScrollingAreaHeight();
+        auto& state = Application::getControllerState();
+        float limit = this->getContentSize() - this->getScrollingAreaSize();
 
-        // Sets true on border hit to play sound only once
-        static bool repeat = false;
+        ControllerButton forward  = axis == Axis::COLUMN ? BUTTON_NAV_DOWN : BUTTON_NAV_RIGHT;
+        ControllerButton backward = axis == Axis::COLUMN ? BUTTON_NAV_UP : BUTTON_NAV_LEFT;
 
-        // Do nothing if both up and down buttons pressed simultaneously
-        if (state.buttons[BUTTON_NAV_DOWN] && state.buttons[BUTTON_NAV_UP])
+        // Do nothing if both buttons pressed simultaneously
+        if (state.buttons[forward] && state.buttons[backward])
             return;
 
-        if (state.buttons[BUTTON_NAV_DOWN])
+        if (state.buttons[forward])
         {
-            naturalScrollingButtonProcessing(FocusDirection::DOWN, &repeat);
+            naturalScrollingButtonProcessing(axis == Axis::COLUMN ? FocusDirection::DOWN : FocusDirection::RIGHT);
         }
 
-        if (state.buttons[BUTTON_NAV_UP])
+        if (state.buttons[backward])
         {
-            naturalScrollingButtonProcessing(FocusDirection::UP, &repeat);
+            naturalScrollingButtonProcessing(axis == Axis::COLUMN ? FocusDirection::UP : FocusDirection::LEFT);
         }
 
         // If there is focus inside scroll, and navigation buttons are not pressed
         // disable natural scrolling
         View* currentFocus = Application::getCurrentFocus();
-        if (!state.buttons[BUTTON_NAV_DOWN] && !state.buttons[BUTTON_NAV_UP] && (currentFocus != this))
+        if (!state.buttons[forward] && !state.buttons[backward] && (currentFocus != this))
         {
             naturalScrollingCanScroll = false;
         }
 
         // If navigation buttons are not pressed and content offset not above border
         // unflag repeat value to play border hit sound if needed
-        if ((!state.buttons[BUTTON_NAV_DOWN] && !state.buttons[BUTTON_NAV_UP]) || (getContentOffsetY() > 0.01f && getContentOffsetY() < bottomLimit))
+        if ((!state.buttons[forward] && !state.buttons[backward]) || (getContentOffset() > 0.01f && getContentOffset() < limit))
         {
-            repeat = false;
+            naturalScrollingRepeat = false;
         }
     }
 }
 
-View* ScrollingFrame::findTopMostFocusableView()
+View* BaseScrollingFrame::findFirstFocusableView()
 {
     Rect frame       = getFrame();
-    Point check      = Point(frame.getMidX(), frame.getMinY());
+    Point check      = axis == Axis::COLUMN ? Point(frame.getMidX(), frame.getMinY()) : Point(frame.getMinX(), frame.getMidY());
     View* focusCheck = contentView->hitTest(check);
     if (focusCheck)
     {
@@ -230,9 +268,10 @@ View* ScrollingFrame::findTopMostFocusableView()
         if (focusCheckDefaultFocus)
             focusCheck = focusCheckDefaultFocus;
 
+        FocusDirection direction = axis == Axis::COLUMN ? FocusDirection::DOWN : FocusDirection::RIGHT;
         while (focusCheck && !focusCheck->getFrame().inscribed(frame))
         {
-            focusCheck = focusCheck->getParent()->getNextFocus(FocusDirection::DOWN, focusCheck);
+            focusCheck = focusCheck->getParent()->getNextFocus(direction, focusCheck);
         }
 
         return focusCheck;
@@ -241,28 +280,36 @@ View* ScrollingFrame::findTopMostFocusableView()
     return nullptr;
 }
 
-void ScrollingFrame::naturalScrollingButtonProcessing(FocusDirection focusDirection, bool* repeat)
+void BaseScrollingFrame::naturalScrollingButtonProcessing(FocusDirection focusDirection)
 {
-    float bottomLimit = this->getContentHeight() - this->getScrollingAreaHeight();
-    float newOffset   = getContentOffsetY();
-    bool isBorder     = false;
+    float limit     = this->getContentSize() - this->getScrollingAreaSize();
+    float newOffset = getContentOffset();
+    bool isBorder   = false;
     switch (focusDirection)
     {
         case FocusDirection::UP:
-            isBorder = getContentOffsetY() <= 0;
+        case FocusDirection::LEFT:
+            isBorder = getContentOffset() <= 0;
             newOffset -= (1000.0f / Application::getFPS());
             break;
         case FocusDirection::DOWN:
-            isBorder = getContentOffsetY() >= bottomLimit;
+        case FocusDirection::RIGHT:
+            isBorder = getContentOffset() >= limit;
             newOffset += (1000.0f / Application::getFPS());
             break;
         default:
             break;
     }
 
-    setContentOffsetY(newOffset, false);
+    setContentOffset(newOffset, false);
     View* current = Application::getCurrentFocus();
-    View* next    = current->getParent()->getNextFocus(focusDirection, current);
+    View* next    = nullptr;
+
+    // Same as Application::navigate(), with the frames of the views if the activity uses the spatial navigation
+    Activity* activity = getParentActivity();
+    FocusGraph* graph  = activity ? activity->getFocusGraph() : nullptr;
+    if (!graph || !graph->getNextFocus(activity->getContentView(), current, focusDirection, &next))
+        next = current->getParent()->getNextFocus(focusDirection, current);
     if (next)
     {
         if (current != next->getDefaultFocus())
@@ -277,25 +324,25 @@ void ScrollingFrame::naturalScrollingButtonProcessing(FocusDirection focusDirect
         Application::giveFocus(this);
     }
 
-    if (isBorder && !*repeat)
+    if (isBorder && !naturalScrollingRepeat)
     {
-        *repeat = true;
+        naturalScrollingRepeat = true;
         Application::getCurrentFocus()->shakeHighlight(focusDirection);
         Application::getAudioPlayer()->play(SOUND_FOCUS_ERROR);
     }
 }
 
-void ScrollingFrame::addView(View* view)
+void BaseScrollingFrame::addView(View* view)
 {
     this->setContentView(view);
 }
 
-void ScrollingFrame::removeView(View* view, bool free)
+void BaseScrollingFrame::removeView(View* view, bool free)
 {
     this->setContentView(nullptr);
 }
 
-void ScrollingFrame::setContentView(View* view)
+void BaseScrollingFrame::setContentView(View* view)
 {
     if (this->contentView)
     {
@@ -311,34 +358,38 @@ void ScrollingFrame::setContentView(View* view)
 
     view->detach();
     view->setCulled(false);
-    view->setWidth(this->getWidth());
+    if (axis == Axis::COLUMN)
+        view->setWidth(this->getWidth());
+    else
+        view->setHeight(this->getHeight());
 
     Box::addView(view); // will invalidate the scrolling box, hence calling onLayout and invalidating the contentView
 }
 
-void ScrollingFrame::onLayout()
+void BaseScrollingFrame::onLayout()
 {
     if (this->contentView)
     {
-        this->contentView->setWidth(this->getWidth());
+        if (axis == Axis::COLUMN)
+            this->contentView->setWidth(this->getWidth());
+        else
+            this->contentView->setHeight(this->getHeight());
         this->contentView->invalidate();
     }
 }
 
-float ScrollingFrame::getScrollingAreaTopBoundary()
+float BaseScrollingFrame::getScrollingAreaStart()
 {
-    return this->getY();
+    return axis == Axis::COLUMN ? this->getY() : this->getX();
 }
 
-float ScrollingFrame::getScrollingAreaHeight()
+float BaseScrollingFrame::getScrollingAreaSize()
 {
-    return this->getHeight();
+    return axis == Axis::COLUMN ? this->getHeight() : this->getWidth();
 }
 
-void ScrollingFrame::willAppear(bool resetState)
+void BaseScrollingFrame::willAppear(bool resetState)
 {
-    this->prebakeScrolling();
-
     // First scroll all the way to the top
     // then wait for the first frame to scroll
     // to the selected view if needed (only known then)
@@ -350,105 +401,123 @@ void ScrollingFrame::willAppear(bool resetState)
     Box::willAppear(resetState);
 }
 
-void ScrollingFrame::prebakeScrolling()
+void BaseScrollingFrame::startScrolling(bool animated, float newScroll)
 {
-    // Prebaked values for scrolling
-    float y      = this->getScrollingAreaTopBoundary();
-    float height = this->getScrollingAreaHeight();
-
-    this->middleY = y + height / 2;
-    this->bottomY = y + height;
-}
-
-void ScrollingFrame::startScrolling(bool animated, float newScroll)
-{
-    if (newScroll == this->contentOffsetY)
-        return;
+    this->updateScrollRange();
 
     if (animated)
     {
         Style style = Application::getStyle();
-        animateScrolling(newScroll, style["brls/animations/highlight"]);
+        scroller.animateTo(newScroll, style["brls/animations/highlight"]);
     }
     else
     {
-        this->contentOffsetY.stop();
-        this->contentOffsetY = newScroll;
-        this->scrollAnimationTick();
+        scroller.setOffset(newScroll);
         this->invalidate();
     }
 }
 
-void ScrollingFrame::animateScrolling(float newScroll, float time)
+void BaseScrollingFrame::updateScrollRange()
 {
-    this->contentOffsetY.stop();
-
-    this->contentOffsetY.reset();
-
-    this->contentOffsetY.addStep(newScroll, time, EasingFunction::quadraticOut);
-
-    this->contentOffsetY.setTickCallback([this] {
-        this->scrollAnimationTick();
-    });
-
-    this->contentOffsetY.start();
-
-    this->invalidate();
+    float viewport = this->getScrollingAreaSize();
+    scroller.setRange(this->getContentSize() - viewport, viewport);
 }
 
-void ScrollingFrame::setScrollingBehavior(ScrollingBehavior behavior)
+void BaseScrollingFrame::setScrollingBehavior(ScrollingBehavior behavior)
 {
     this->behavior = behavior;
 }
 
-float ScrollingFrame::getContentHeight()
+void BaseScrollingFrame::setOverscrollEnabled(bool enabled)
+{
+    scroller.setOverscrollEnabled(enabled);
+}
+
+float BaseScrollingFrame::getContentSize()
 {
     if (!this->contentView)
         return 0;
 
-    return this->contentView->getHeight();
+    this->contentView->layoutIfNeeded();
+    return getMainAxis(this->contentView->getLocalFrame().size);
 }
 
-void ScrollingFrame::setContentOffsetY(float value, bool animated)
+void BaseScrollingFrame::setContentOffset(float value, bool animated)
 {
     startScrolling(animated, value);
 }
 
-void ScrollingFrame::scrollAnimationTick()
+void BaseScrollingFrame::scrollToRect(Rect rect, bool animated)
 {
-    if (this->contentView)
-    {
-        float contentHeight = this->getContentHeight();
-        float bottomLimit   = contentHeight - this->getScrollingAreaHeight();
+    float start    = getMainAxis(rect.origin);
+    float size     = getMainAxis(rect.size);
+    float offset   = this->getContentOffset();
+    float viewport = this->getScrollingAreaSize();
+
+    float newScroll = offset;
+    if (start < offset || size >= viewport)
+        newScroll = start;
+    else if (start + size > offset + viewport)
+        newScroll = start + size - viewport;
+
+    if (newScroll != offset)
+        startScrolling(animated, newScroll);
+}
 
-        if (this->contentOffsetY < 0)
-            this->contentOffsetY = 0;
+void BaseScrollingFrame::scrollToView(View* view, bool animated)
+{
+    Rect frame;
+    if (this->getFrameInContent(view, &frame))
+        this->scrollToRect(frame, animated);
+}
 
-        if (this->contentOffsetY > bottomLimit)
-            this->contentOffsetY = bottomLimit;
+bool BaseScrollingFrame::getFrameInContent(View* view, Rect* frame)
+{
+    if (!this->contentView || !view)
+        return false;
 
-        if (contentHeight <= getHeight())
-            this->contentOffsetY = 0;
+    *frame       = view->getLocalFrame();
+    View* parent = view->getParent();
 
-        this->contentView->setTranslationY(-this->contentOffsetY);
+    while (parent && parent != this->contentView)
+    {
+        frame->origin = frame->origin + parent->getLocalFrame().origin;
+        parent        = parent->getParent();
     }
+
+    return parent != nullptr;
 }
 
-View* ScrollingFrame::getNextFocus(FocusDirection direction, View* currentView)
+void BaseScrollingFrame::scrollAnimationTick()
+{
+    if (!this->contentView)
+        return;
+
+    if (axis == Axis::COLUMN)
+        this->contentView->setTranslationY(-this->getContentOffset());
+    else
+        this->contentView->setTranslationX(-this->getContentOffset());
+}
+
+View* BaseScrollingFrame::getNextFocus(FocusDirection direction, View* currentView)
 {
     // To prevent sound click on empty scroll view
-    float bottomLimit    = this->getContentHeight() - this->getScrollingAreaHeight();
-    float contentOffsetY = this->getContentOffsetY();
-    if (direction == FocusDirection::DOWN && contentOffsetY < (bottomLimit - 0.01f))
+    float limit         = this->getContentSize() - this->getScrollingAreaSize();
+    float contentOffset = this->getContentOffset();
+
+    FocusDirection forward  = axis == Axis::COLUMN ? FocusDirection::DOWN : FocusDirection::RIGHT;
+    FocusDirection backward = axis == Axis::COLUMN ? FocusDirection::UP : FocusDirection::LEFT;
+
+    if (direction == forward && contentOffset < (limit - 0.01f))
         return this;
 
-    if (direction == FocusDirection::UP && this->getContentOffsetY() > 0.01f)
+    if (direction == backward && contentOffset > 0.01f)
         return this;
 
     return Box::getNextFocus(direction, currentView);
 }
 
-View* ScrollingFrame::getDefaultFocus()
+View* BaseScrollingFrame::getDefaultFocus()
 {
     if (behavior == ScrollingBehavior::CENTERED)
     {
@@ -463,19 +532,26 @@ View* ScrollingFrame::getDefaultFocus()
     if (focus && focus->getFrame().inscribed(getFrame()))
         return focus;
 
-    if (focus = findTopMostFocusableView(); focus && focus != this)
+    if (focus = findFirstFocusableView(); focus && focus != this)
         return focus;
 
     return Box::getDefaultFocus();
 }
 
-void ScrollingFrame::onFocusGained()
+FocusGraphMode BaseScrollingFrame::getFocusGraphMode()
+{
+    // The natural scrolling moves the focus along with the content from
+    // getParentNavigationDecision(), which the graph goes through as well
+    return FocusGraphMode::SCOPE;
+}
+
+void BaseScrollingFrame::onFocusGained()
 {
     Box::onFocusGained();
     naturalScrollingCanScroll = true;
 }
 
-void ScrollingFrame::onChildFocusGained(View* directChild, View* focusedView)
+void BaseScrollingFrame::onChildFocusGained(View* directChild, View* focusedView)
 {
     Box::onChildFocusGained(directChild, focusedView);
 
@@ -486,12 +562,14 @@ void ScrollingFrame::onChildFocusGained(View* directChild, View* focusedView)
         this->updateScrolling(true);
 }
 
-void ScrollingFrame::onChildFocusLost(View* directChild, View* focusedView)
+void BaseScrollingFrame::onChildFocusLost(View* directChild, View* focusedView)
 {
+    Box::onChildFocusLost(directChild, focusedView);
+
     this->childFocused = false;
 }
 
-View* ScrollingFrame::getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction)
+View* BaseScrollingFrame::getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction)
 {
     if (behavior == ScrollingBehavior::CENTERED)
         return Box::getParentNavigationDecision(from, newFocus, direction);
@@ -499,7 +577,8 @@ View* ScrollingFrame::getParentNavigationDecision(View* from, View* newFocus, Fo
     View* currentFocus = Application::getCurrentFocus();
     if (!newFocus)
     {
-        if (direction == FocusDirection::LEFT || direction == FocusDirection::RIGHT)
+        bool vertical = direction == FocusDirection::UP || direction == FocusDirection::DOWN;
+        if (vertical != (axis == Axis::COLUMN))
             return nullptr;
 
         if (from == contentView)
@@ -526,36 +605,18 @@ View* ScrollingFrame::getParentNavigationDecision(View* from, View* newFocus, Fo
     return this;
 }
 
-bool ScrollingFrame::updateScrolling(bool animated)
+bool BaseScrollingFrame::updateScrolling(bool animated)
 {
     if (!this->contentView)
         return false;
 
     View* focusedView = getDefaultFocus();
-    float localY      = focusedView ? focusedView->getLocalY() : 0.0f;
-    float itemHeight  = focusedView ? focusedView->getHeight() : 0.0f;
-    View* parent      = focusedView ? focusedView->getParent() : nullptr;
+    Rect frame;
+    if (!this->getFrameInContent(focusedView, &frame))
+        frame = Rect();
 
-    while (parent && dynamic_cast<ScrollingFrame*>(parent->getParent()) == nullptr)
-    {
-        localY += parent->getLocalY();
-        parent = parent->getParent();
-    }
-
-    int currentSelectionMiddleOnScreen = localY + itemHeight / 2;
-    float newScroll                    = currentSelectionMiddleOnScreen - this->getHeight() / 2;
-
-    float contentHeight = this->getContentHeight();
-    float bottomLimit   = contentHeight - this->getScrollingAreaHeight();
-
-    if (newScroll < 0)
-        newScroll = 0;
-
-    if (newScroll > bottomLimit)
-        newScroll = bottomLimit;
-
-    if (contentHeight <= getHeight())
-        newScroll = 0;
+    int currentSelectionMiddleOnScreen = getMainAxis(frame.origin) + getMainAxis(frame.size) / 2;
+    float newScroll                    = currentSelectionMiddleOnScreen - this->getScrollingAreaSize() / 2;
 
     //Start animation
     this->startScrolling(animated, newScroll);
@@ -563,14 +624,17 @@ bool ScrollingFrame::updateScrolling(bool animated)
     return true;
 }
 
-Rect ScrollingFrame::getVisibleFrame()
+Rect BaseScrollingFrame::getVisibleFrame()
 {
     Rect frame = getLocalFrame();
-    frame.origin.y += this->contentOffsetY;
+    if (axis == Axis::COLUMN)
+        frame.origin.y += this->getContentOffset();
+    else
+        frame.origin.x += this->getContentOffset();
     return frame;
 }
 
-enum Sound ScrollingFrame::getFocusSound()
+enum Sound BaseScrollingFrame::getFocusSound()
 {
     if (!contentView->getDefaultFocus())
     {
@@ -579,40 +643,56 @@ enum Sound ScrollingFrame::getFocusSound()
     return Sound::SOUND_NONE;
 }
 
-#define NO_PADDING fatal("Padding is not supported by brls:ScrollingFrame, please set padding on the content view instead");
+#define NO_PADDING fatal(std::string("Padding is not supported by ") + (axis == Axis::COLUMN ? "brls:ScrollingFrame" : "brls:HScrollingFrame") + ", please set padding on the content view instead");
 
-void ScrollingFrame::setPadding(float top, float right, float bottom, float left)
+void BaseScrollingFrame::setPadding(float top, float right, float bottom, float left)
 {
     NO_PADDING
 }
 
-void ScrollingFrame::setPaddingTop(float top)
+void BaseScrollingFrame::setPaddingTop(float top)
 {
     NO_PADDING
 }
 
-void ScrollingFrame::setPaddingRight(float right)
+void BaseScrollingFrame::setPaddingRight(float right)
 {
     NO_PADDING
 }
 
-void ScrollingFrame::setPaddingBottom(float bottom)
+void BaseScrollingFrame::setPaddingBottom(float bottom)
 {
     NO_PADDING
 }
 
-void ScrollingFrame::setPaddingLeft(float left) {
+void BaseScrollingFrame::setPaddingLeft(float left)
+{
     NO_PADDING
 }
 
-View* ScrollingFrame::create()
+BaseScrollingFrame::~BaseScrollingFrame()
 {
-    return new ScrollingFrame();
+    Application::getGlobalInputTypeChangeEvent()->unsubscribe(inputTypeSubscription);
 }
 
-ScrollingFrame::~ScrollingFrame()
+ScrollingFrame::ScrollingFrame()
+    : BaseScrollingFrame(Axis::COLUMN)
 {
-    Application::getGlobalInputTypeChangeEvent()->unsubscribe(inputTypeSubscription);
+}
+
+void ScrollingFrame::setContentOffsetY(float value, bool animated)
+{
+    setContentOffset(value, animated);
+}
+
+float ScrollingFrame::getContentHeight()
+{
+    return getContentSize();
+}
+
+View* ScrollingFrame::create()
+{
+    return new ScrollingFrame();
 }
 
 } // namespace brls
@@ -26,6 +26,9 @@ using namespace brls::literals;
 namespace brls
 {
 
+// Looked up on every frame
+static const ThemeKey THEME_SIDEBAR_SEPARATOR("brls/sidebar/separator");
+
 const std::string sidebarItemXML = R"xml(
     <brls:Box
         width="auto"
@@ -61,8 +64,10 @@ SidebarItem::SidebarItem()
 {
     this->inflateFromXMLString(sidebarItemXML);
 
-    this->registerStringXMLAttribute("label", [this](std::string value)
-        { this->setLabel(value); });
+    this->registerXMLAttributes<SidebarItem>([](XMLAttributes<SidebarItem>& attributes) {
+        attributes.registerStringXMLAttribute("label", [](SidebarItem* view, std::string value)
+            { view->setLabel(value); });
+    });
 
     this->setFocusSound(SOUND_FOCUS_SIDEBAR);
 
@@ -236,7 +241,7 @@ void SidebarSeparator::draw(NVGcontext* vg, float x, float y, float width, float
     float midY = y + height / 2;
 
     nvgBeginPath(vg);
-    nvgFillColor(vg, a(ctx->theme["brls/sidebar/separator"]));
+    nvgFillColor(vg, a(ctx->theme[THEME_SIDEBAR_SEPARATOR]));
     nvgRect(vg, x, midY, width, 1);
     nvgFill(vg);
 }
@@ -0,0 +1,87 @@
+/*
+    Copyright 2026 borealis contributors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Compiles every XML layout of a folder into the binary form loaded by View::createFromXMLFile()
+// and View::createFromXMLResource(), see brls::XMLLayout.
+//
+// Each "name.xml" gives a "name.bxml" at the same place in the output folder,
+// which is the input folder if not given.
+
+#include <borealis/core/xml_layout.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#ifdef USE_BOOST_FILESYSTEM
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2 && argc != 3)
+    {
+        std::printf("./brls-xml-compiler <XML_FOLDER> [OUTPUT_FOLDER]\n");
+        return 1;
+    }
+
+    fs::path input  = argv[1];
+    fs::path output = argc == 3 ? fs::path(argv[2]) : input;
+
+    if (!fs::is_directory(input))
+    {
+        std::fprintf(stderr, "brls-xml-compiler: \"%s\" is not a folder\n", input.string().c_str());
+        return 1;
+    }
+
+    int compiled = 0;
+
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input))
+    {
+        if (!fs::is_regular_file(entry.path()) || entry.path().extension() != ".xml")
+            continue;
+
+        std::string error;
+        std::shared_ptr<brls::XMLLayout> layout = brls::XMLLayout::load(entry.path().string(), &error);
+
+        if (!layout)
+        {
+            std::fprintf(stderr, "brls-xml-compiler: unable to load \"%s\": %s\n", entry.path().string().c_str(), error.c_str());
+            return 1;
+        }
+
+        fs::path destination = output / fs::relative(entry.path(), input);
+        destination.replace_extension(".bxml");
+        fs::create_directories(destination.parent_path());
+
+        std::string data = layout->encode();
+        std::ofstream file(destination.string(), std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+
+        if (!file.good())
+        {
+            std::fprintf(stderr, "brls-xml-compiler: unable to write \"%s\"\n", destination.string().c_str());
+            return 1;
+        }
+
+        compiled++;
+    }
+
+    std::printf("brls-xml-compiler: compiled %d layouts into \"%s\"\n", compiled, output.string().c_str());
+    return 0;
+}